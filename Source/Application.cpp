@@ -2,9 +2,15 @@
 #include "MainWindow.h"
 #include "Windows_XInterface.h"
 #include "Windows_FocusControl.h"
+#include "Text_CharSet_ChordOptimizer.h"
+#include "Text_CharSet_JSONKeys.h"
+#include "Text_Painter.h"
 
 #ifdef INCLUDE_TESTING
+#include "Debug_ScopeTimer.h"
 #include "Debug_ScopeTimerRecords.h"
+#include "Input_SessionReplay.h"
+#include "Input_ReleaseTiming.h"
 #endif
 
 #ifdef JUCE_DEBUG
@@ -33,6 +39,13 @@ static juce::StringArray testCategories;
 static const constexpr int standardHeightDivisor = 2;
 static const constexpr int minimizedHeightDivisor = 9;
 
+// Number of chord changes tried when assigning chords to each character set:
+static const constexpr int chordAssignmentSteps = 200000;
+// Random seed used when assigning chords, so results can be repeated:
+static const constexpr juce::int64 chordAssignmentSeed = 1;
+// Default file name used to save assigned chords:
+static const constexpr char* defaultChordOutput = "charSets.json";
+
 // Window where input will be sent, saved on launch.
 static Window targetWindow = BadWindow;
 
@@ -124,7 +137,8 @@ static juce::String getFlagNames(const int windowFlags)
 }
 #endif
 
-// Recreates the MainWindow bounds to suit the current circumstances.
+// Moves, resizes, or recreates the MainWindow to suit the current
+// circumstances.
 void Application::resetWindow(const int windowFlags)
 {
     const juce::Rectangle<int> displayBounds = getDisplayBounds();
@@ -151,20 +165,35 @@ void Application::resetWindow(const int windowFlags)
             << targetBounds.toString() << ", window flags = "
             << getFlagNames(windowFlags));
 
-    // Create the new window, applying the target bounds:
-    homeWindow.reset(new MainWindow(getApplicationName()));
-    homeWindow->setContentNonOwned(mainView.get(), false);
-    homeWindow->setVisible(true);
-    homeWindow->setBounds(targetBounds);
-    homeWindow->addToDesktop();
+    #ifdef INCLUDE_TESTING
+    Debug::ScopeTimer resetTimer("Application::resetWindow");
+    #endif
+
+    if (homeWindow == nullptr || ! mainConfig.getReuseWindow())
+    {
+        // Create the new window, applying the target bounds:
+        homeWindow.reset(new MainWindow(getApplicationName()));
+        homeWindow->setContentNonOwned(mainView.get(), false);
+        homeWindow->setVisible(true);
+        homeWindow->setBounds(targetBounds);
+        homeWindow->addToDesktop();
+    }
+    else if (homeWindow->getBounds() != targetBounds)
+    {
+        // Keep the existing native window, only moving or resizing it:
+        homeWindow->setBounds(targetBounds);
+    }
 
     // Ensure the application window is active and has keyboard focus:
-    Windows::FocusControl focusControl;
-    focusControl.takeFocus(mainView.get());
+    if (! homeWindow->isActiveWindow() || ! mainView->hasKeyboardFocus(true))
+    {
+        Windows::FocusControl focusControl;
+        focusControl.takeFocus(mainView.get());
+    }
 }
 
 
-// Recreates the MainWindow, updating window flags to match the current selected
+// Updates the MainWindow, applying window flags to match the current selected
 // configuration.
 void Application::resetUpdatingFlags()
 {
@@ -186,17 +215,47 @@ void Application::initialise(const juce::String &commandLine)
         using std::cerr;
         cerr << "arguments:" << std::endl;
         cerr << "  --help           Print this help text\n";
+        cerr << "  --resident       Stay running in the background\n";
+        cerr << "  --assign-chords <corpus> [output]\n";
+        cerr << "                   Assign chords using corpus character "
+                << "frequencies\n";
         #ifdef INCLUDE_TESTING
         cerr << "  --test           Run program tests\n";
         cerr << "     -categories   Run only tests within listed categories\n";
         cerr << "     -v            Verbose test output\n";
+        cerr << "  --replay <file>  Score chord timing on a session\n";
         #endif
         quit();
         return;
     }
 
-    // Skip normal init and run tests if they're enabled and requested:
+    // Assign chords from a text corpus and quit if a corpus is provided:
+    const int corpusIndex = args.indexOf("--assign-chords");
+    if (corpusIndex != -1 && args.size() > (corpusIndex + 1))
+    {
+        const juce::File workingDir
+                = juce::File::getCurrentWorkingDirectory();
+        const juce::String outputPath = (args.size() > (corpusIndex + 2))
+                ? args[corpusIndex + 2].unquoted()
+                : juce::String(defaultChordOutput);
+        assignChords(workingDir.getChildFile(args[corpusIndex + 1].unquoted()),
+                workingDir.getChildFile(outputPath));
+        quit();
+        return;
+    }
+
     #ifdef INCLUDE_TESTING
+    // Score chord release timing models and quit if a session is provided:
+    const int replayIndex = args.indexOf("--replay");
+    if (replayIndex != -1 && args.size() > (replayIndex + 1))
+    {
+        printReplayScores(juce::File::getCurrentWorkingDirectory()
+                .getChildFile(args[replayIndex + 1].unquoted()));
+        quit();
+        return;
+    }
+
+    // Skip normal init and run tests if they're enabled and requested:
     runTests = args.contains("--test");
     if (runTests)
     {
@@ -218,11 +277,20 @@ void Application::initialise(const juce::String &commandLine)
         homeWindow->setResizable(true, false);
         homeWindow->setVisible(true);
         homeWindow->addToDesktop();
+
+        // Focus the test window, and run tests once the event loop starts:
+        Windows::FocusControl focusControl;
+        focusControl.takeFocus(homeWindow.get());
+        juce::MessageManager::callAsync([this]()
+        {
+            runApplicationTests();
+        });
         return;
     }
     #endif
 
     // Save the window that will receive input:
+    Windows::XInterface::setTreeMirrorEnabled(mainConfig.getMirrorWindowTree());
     Windows::XInterface xWindows;
     if (targetWindow == BadWindow)
     {
@@ -238,6 +306,11 @@ void Application::initialise(const juce::String &commandLine)
     inputController.reset(new Input::Controller(mainView.get(), targetWindow,
                 outputBuffer));
     resetWindow(getWindowFlags());
+
+    if (mainConfig.getResidentMode() || args.contains("--resident"))
+    {
+        startResidentServer();
+    }
 }
 
 
@@ -246,12 +319,15 @@ void Application::initialise(const juce::String &commandLine)
 void Application::shutdown()
 {
     DBG(dbgPrefix << __func__ << ": Closing application resources.");
+    residentServer.reset(nullptr);
     juce::LookAndFeel::setDefaultLookAndFeel(nullptr);
 
     inputController.reset(nullptr);
     mainView.reset(nullptr);
     homeWindow.reset(nullptr);
     lookAndFeel.reset(nullptr);
+    Text::Painter::clearGlyphCache();
+    Windows::XInterface::setTreeMirrorEnabled(false);
     #ifdef INCLUDE_TESTING
     Debug::ScopeTimerRecords::printRecords();
     #endif
@@ -277,7 +353,8 @@ const juce::String Application::getApplicationVersion()
 // Checks if multiple versions of this application may run simultaneously.
 bool Application::moreThanOneInstanceAllowed()
 {
-    return false;
+    return mainConfig.getResidentMode()
+            || getCommandLineParameterArray().contains("--resident");
 }
 
 
@@ -290,8 +367,185 @@ void Application::anotherInstanceStarted(const juce::String& commandLine)
 }
 
 
+// Closes the application, or hides the application window if the application
+// is resident.
+void Application::systemRequestedQuit()
+{
+    if (residentServer != nullptr)
+    {
+        hideResidentWindow();
+    }
+    else
+    {
+        quit();
+    }
+}
+
+
+// Starts listening for requests from new application launches, keeping the
+// application resident until it is told to quit.
+void Application::startResidentServer()
+{
+    residentServer.reset(new Daemon::Server(
+    [this](const int newTarget)
+    {
+        showResidentWindow(newTarget);
+    },
+    [this]()
+    {
+        hideResidentWindow();
+    },
+    [this]()
+    {
+        quit();
+    }));
+    if (! residentServer->isListening())
+    {
+        DBG(dbgPrefix << __func__ << ": Failed to start resident server, "
+                << "application will exit when closed.");
+        residentServer.reset(nullptr);
+    }
+}
+
+
+// Shows the resident application window, ready to send input to a new target
+// window.
+void Application::showResidentWindow(const int newTarget)
+{
+    DBG(dbgPrefix << __func__ << ": Showing window for target window "
+            << newTarget);
+    targetWindow = (Window) newTarget;
+    // Keep the same input controller, so text still being sent to the last
+    // target window isn't lost:
+    inputController->setTargetWindow((int) targetWindow);
+    if (mainView->isHelpScreenShowing())
+    {
+        mainView->toggleHelpScreen();
+    }
+    if (homeWindow != nullptr)
+    {
+        homeWindow->setVisible(true);
+    }
+    resetWindow(getWindowFlags() & ~ (int) WindowFlag::showingHelp);
+}
+
+
+// Hides the resident application window, clearing any input that wasn't sent.
+void Application::hideResidentWindow()
+{
+    if (homeWindow == nullptr || ! homeWindow->isVisible())
+    {
+        return;
+    }
+    DBG(dbgPrefix << __func__ << ": Hiding resident window.");
+    outputBuffer.clear();
+    homeWindow->setVisible(false);
+}
+
+
+// Assigns chords to all configurable character sets using character
+// frequencies measured from a text corpus, saving the updated character sets
+// and printing the expected reduction in typing effort.
+void Application::assignChords
+(const juce::File& corpusFile, const juce::File& outputFile)
+{
+    using namespace Text::CharSet;
+    if (! corpusFile.existsAsFile())
+    {
+        std::cerr << "Corpus file " << corpusFile.getFullPathName()
+                << " not found.\n";
+        return;
+    }
+    const juce::String corpus = corpusFile.loadFileAsString();
+
+    juce::DynamicObject::Ptr charSetData = new juce::DynamicObject;
+    charSetData->setProperty(JSONKeys::mainSetName.key,
+            charSetConfig.getSetName(Type::main));
+    charSetData->setProperty(JSONKeys::altSetName.key,
+            charSetConfig.getSetName(Type::alt));
+    charSetData->setProperty(JSONKeys::specialSetName.key,
+            charSetConfig.getSetName(Type::special));
+
+    // Stores a character set's key and type:
+    struct SetKey
+    {
+        const juce::Identifier& key;
+        const Type type;
+    };
+    const SetKey setKeys[] =
+    {
+        { JSONKeys::mainCharSet,    Type::main },
+        { JSONKeys::altCharSet,     Type::alt },
+        { JSONKeys::specialCharSet, Type::special }
+    };
+    double defaultCost = 0.0;
+    double optimizedCost = 0.0;
+    for (const SetKey& setKey : setKeys)
+    {
+        ChordOptimizer optimizer(charSetConfig.getConfigValue<juce::var>(
+                    setKey.key));
+        optimizer.addText(corpus);
+        optimizer.optimize(chordAssignmentSteps, chordAssignmentSeed);
+        charSetData->setProperty(setKey.key, optimizer.getSetData());
+
+        const juce::int64 charCount = optimizer.getCharacterCount();
+        defaultCost += optimizer.getDefaultCost() * charCount;
+        optimizedCost += optimizer.getOptimizedCost() * charCount;
+        std::cout << charSetConfig.getSetName(setKey.type) << " set: "
+                << charCount << " characters, average cost "
+                << juce::String(optimizer.getDefaultCost(), 3) << " -> "
+                << juce::String(optimizer.getOptimizedCost(), 3) << "\n";
+    }
+    if (defaultCost > 0.0)
+    {
+        std::cout << "Expected keystroke effort saved: " << juce::String(
+                (1.0 - optimizedCost / defaultCost) * 100, 1) << "%\n";
+    }
+
+    if (outputFile.replaceWithText(
+                juce::JSON::toString(juce::var(charSetData.get()))))
+    {
+        std::cout << "Saved character sets to "
+                << outputFile.getFullPathName() << "\n";
+    }
+    else
+    {
+        std::cerr << "Failed to save character sets to "
+                << outputFile.getFullPathName() << "\n";
+    }
+}
+
+
 
 #ifdef INCLUDE_TESTING
+// Replays a recorded chord session using fixed and adaptive release timing,
+// printing each model's accuracy and throughput.
+void Application::printReplayScores(const juce::File& sessionFile)
+{
+    if (! sessionFile.existsAsFile())
+    {
+        std::cerr << "Session file " << sessionFile.getFullPathName()
+                << " not found.\n";
+        return;
+    }
+    const int initialDelay = mainConfig.getChordReleaseDelay();
+    for (const bool adaptive : { false, true })
+    {
+        Input::ReleaseTiming releaseTiming(initialDelay, adaptive);
+        const Input::SessionReplay::Score score
+                = Input::SessionReplay::replay(sessionFile, releaseTiming,
+                    mainConfig.getChordRollover());
+        std::cout << (adaptive ? "Adaptive" : "Fixed") << " release delay: "
+                << score.correctCount << "/" << score.chordCount
+                << " chords correct ("
+                << juce::String(score.getAccuracy() * 100, 1) << "%), "
+                << juce::String(score.chordsPerMinute, 1)
+                << " chords/minute, final delay "
+                << score.finalReleaseDelay << "ms\n";
+    }
+}
+
+
 // Runs application tests and shuts down the application.
 void Application::runApplicationTests()
 {
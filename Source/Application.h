@@ -15,6 +15,7 @@
 #include "Input_Key_ConfigFile.h"
 #include "Text_CharSet_ConfigFile.h"
 #include "Config_MainFile.h"
+#include "Daemon_Server.h"
 
 
 /**
@@ -56,9 +57,13 @@ public:
     int getWindowFlags();
 
     /**
-     * @brief  Recreates the MainWindow with bounds to suit the current
+     * @brief  Updates the MainWindow with bounds to suit the current
      *         circumstances.
      *
+     *  Unless window reuse is disabled in the main config file, the existing
+     * window is moved and resized instead of being recreated. Keyboard focus
+     * is only reclaimed if the window or main view lost it.
+     *
      * @param windowFlags  Any combination of values defined in the
      *                     Application::WindowFlag enum. When omitted, the
      *                     window is returned to its default placement, filling
@@ -67,7 +72,7 @@ public:
     void resetWindow(const int windowFlags = 0);
 
     /**
-     * @brief  Recreates the MainWindow, updating window flags to match the
+     * @brief  Updates the MainWindow, applying window flags to match the
      *         current selected configuration.
      */
     void resetUpdatingFlags();
@@ -77,6 +82,15 @@ public:
      */
     void resetWindow();
 
+    /**
+     * @brief  Closes the application, or hides the application window if the
+     *         application is resident.
+     *
+     *  This is called when the window closes, loses focus, or when the user
+     * chooses to close the application.
+     */
+    void systemRequestedQuit() override;
+
 private:
     /**
      * @brief  Performs all required initialization when the application is
@@ -116,8 +130,9 @@ private:
      * @brief  Checks if multiple versions of this application may run
      *         simultaneously.
      *
-     * @return  True, as a new instance of the application may need to replace
-     *          this one if it loses focus and can't be refocused.
+     * @return  Whether resident mode is enabled. A resident instance may stop
+     *          responding, so new instances must be able to start while it
+     *          runs. Otherwise, launching a new instance closes this one.
      */
     bool moreThanOneInstanceAllowed() override;
 
@@ -129,7 +144,49 @@ private:
      */
     void anotherInstanceStarted(const juce::String& commandLine) override;
 
+    /**
+     * @brief  Starts listening for requests from new application launches,
+     *         keeping the application resident until it is told to quit.
+     */
+    void startResidentServer();
+
+    /**
+     * @brief  Shows the resident application window, ready to send input to a
+     *         new target window.
+     *
+     * @param newTarget  The ID of the window that should receive input.
+     */
+    void showResidentWindow(const int newTarget);
+
+    /**
+     * @brief  Hides the resident application window, clearing any input that
+     *         wasn't sent.
+     */
+    void hideResidentWindow();
+
+    /**
+     * @brief  Assigns chords to all configurable character sets using
+     *         character frequencies measured from a text corpus, saving the
+     *         updated character sets and printing the expected reduction in
+     *         typing effort.
+     *
+     * @param corpusFile  A file containing sample text.
+     *
+     * @param outputFile  The file where the new character set configuration
+     *                    will be saved.
+     */
+    void assignChords(const juce::File& corpusFile,
+            const juce::File& outputFile);
+
     #ifdef INCLUDE_TESTING
+    /**
+     * @brief  Replays a recorded chord session using fixed and adaptive
+     *         release timing, printing each model's accuracy and throughput.
+     *
+     * @param sessionFile  A session file saved by Input::SessionRecorder.
+     */
+    void printReplayScores(const juce::File& sessionFile);
+
     /**
      * @brief  Runs application tests and shuts down the application.
      *
@@ -168,4 +225,8 @@ private:
 
     // The user input handler:
     std::unique_ptr<Input::Controller> inputController = nullptr;
+
+    // Listens for new application launches while the application is
+    // resident:
+    std::unique_ptr<Daemon::Server> residentServer = nullptr;
 };
@@ -28,6 +28,108 @@ bool Config::MainFile::getImmediateMode() const
 }
 
 
+// Gets the name of the method used to create key events sent to the target
+// window.
+juce::String Config::MainFile::getOutputMethod() const
+{
+    return getConfigValue<juce::String>(MainKeys::outputMethod);
+}
+
+
+// Gets how long to wait for more keys before sending immediate mode output.
+int Config::MainFile::getOutputCoalesceTime() const
+{
+    return getConfigValue<int>(MainKeys::outputCoalesceTime);
+}
+
+
+// Checks if a local copy of the window tree should be used to find and check
+// windows.
+bool Config::MainFile::getMirrorWindowTree() const
+{
+    return getConfigValue<bool>(MainKeys::mirrorWindowTree);
+}
+
+
+// Checks if the application window should be moved and resized when its layout
+// changes, instead of being recreated.
+bool Config::MainFile::getReuseWindow() const
+{
+    return getConfigValue<bool>(MainKeys::reuseWindow);
+}
+
+
+// Checks if the application should stay running with its window hidden when
+// closed, so it can be shown again without restarting.
+bool Config::MainFile::getResidentMode() const
+{
+    return getConfigValue<bool>(MainKeys::residentMode);
+}
+
+
+// Checks if chord keys should be read as XInput2 raw key events, using X server
+// timestamps to decide which chord was entered.
+bool Config::MainFile::getRawKeyInput() const
+{
+    return getConfigValue<bool>(MainKeys::rawKeyInput);
+}
+
+
+// Gets how long chord key releases may be spread out while still entering a
+// single chord.
+int Config::MainFile::getChordReleaseDelay() const
+{
+    return getConfigValue<int>(MainKeys::chordReleaseDelay);
+}
+
+
+// Checks if the chord release delay should adjust to match how quickly the
+// user releases chord keys.
+bool Config::MainFile::getAdaptiveReleaseDelay() const
+{
+    return getConfigValue<bool>(MainKeys::adaptiveReleaseDelay);
+}
+
+
+// Checks if a new chord may begin before all keys in the last chord are
+// released.
+bool Config::MainFile::getChordRollover() const
+{
+    return getConfigValue<bool>(MainKeys::chordRollover);
+}
+
+
+// Gets the file where chord key timing should be recorded.
+juce::String Config::MainFile::getChordSessionFile() const
+{
+    return getConfigValue<juce::String>(MainKeys::chordSessionFile);
+}
+
+
+// Gets the word list file used to suggest word completions.
+juce::String Config::MainFile::getWordListFile() const
+{
+    return getConfigValue<juce::String>(MainKeys::wordListFile);
+}
+
+
+// Gets the dictionary file of chord sequences that expand into whole words.
+juce::String Config::MainFile::getBriefFile() const
+{
+    return getConfigValue<juce::String>(MainKeys::briefFile);
+}
+
+
+// Gets the list of window classes that accept key events sent directly to the
+// window, without changing window focus.
+juce::StringArray Config::MainFile::getDirectInputClasses() const
+{
+    SharedResource::LockedPtr<const MainResource> mainResource
+            = getReadLockedResource();
+    return mainResource->getDirectInputClasses();
+}
+
+
 // Sets whether the application should start up in minimized mode.
 void Config::MainFile::setMinimised(const bool minimized)
 {
@@ -47,3 +149,11 @@ void Config::MainFile::setImmediateMode(const bool immediateMode)
 {
     setConfigValue<bool>(MainKeys::immediateMode, immediateMode);
 }
+
+
+// Sets how long chord key releases may be spread out while still entering a
+// single chord.
+void Config::MainFile::setChordReleaseDelay(const int releaseDelay)
+{
+    setConfigValue<int>(MainKeys::chordReleaseDelay, releaseDelay);
+}
@@ -45,6 +45,115 @@ public:
      */
     bool getImmediateMode() const;
 
+    /**
+     * @brief  Gets the name of the method used to create key events sent to
+     *         the target window.
+     *
+     * @return  Either "xtest" if key events should be created within the
+     *          application using the XTest extension, or "xdotool" if they
+     *          should be created by running xdotool.
+     */
+    juce::String getOutputMethod() const;
+
+    /**
+     * @brief  Gets how long to wait for more keys before sending immediate
+     *         mode output.
+     *
+     * @return  The number of milliseconds keys may wait so that they can be
+     *          sent together with the keys that follow them.
+     */
+    int getOutputCoalesceTime() const;
+
+    /**
+     * @brief  Checks if a local copy of the window tree should be used to
+     *         find and check windows.
+     *
+     * @return  Whether the window tree mirror is enabled.
+     */
+    bool getMirrorWindowTree() const;
+
+    /**
+     * @brief  Checks if the application window should be moved and resized
+     *         when its layout changes, instead of being recreated.
+     *
+     * @return  Whether the application window should be reused.
+     */
+    bool getReuseWindow() const;
+
+    /**
+     * @brief  Checks if the application should stay running with its window
+     *         hidden when closed, so it can be shown again without
+     *         restarting.
+     *
+     * @return  Whether resident mode is enabled.
+     */
+    bool getResidentMode() const;
+
+    /**
+     * @brief  Checks if chord keys should be read as XInput2 raw key events,
+     *         using X server timestamps to decide which chord was entered.
+     *
+     * @return  Whether raw key input is enabled.
+     */
+    bool getRawKeyInput() const;
+
+    /**
+     * @brief  Gets how long chord key releases may be spread out while still
+     *         entering a single chord.
+     *
+     * @return  The chord release delay, in milliseconds.
+     */
+    int getChordReleaseDelay() const;
+
+    /**
+     * @brief  Checks if the chord release delay should adjust to match how
+     *         quickly the user releases chord keys.
+     *
+     * @return  Whether the release delay is adaptive.
+     */
+    bool getAdaptiveReleaseDelay() const;
+
+    /**
+     * @brief  Checks if a new chord may begin before all keys in the last
+     *         chord are released.
+     *
+     * @return  Whether chord rollover mode is enabled.
+     */
+    bool getChordRollover() const;
+
+    /**
+     * @brief  Gets the file where chord key timing should be recorded.
+     *
+     * @return  The session file path, or the empty string if timing shouldn't
+     *          be recorded.
+     */
+    juce::String getChordSessionFile() const;
+
+    /**
+     * @brief  Gets the word list file used to suggest word completions.
+     *
+     * @return  The word list path, or the empty string if words shouldn't be
+     *          suggested.
+     */
+    juce::String getWordListFile() const;
+
+    /**
+     * @brief  Gets the dictionary file of chord sequences that expand into
+     *         whole words.
+     *
+     * @return  The brief dictionary path, or the empty string if briefs
+     *          shouldn't be used.
+     */
+    juce::String getBriefFile() const;
+
+    /**
+     * @brief  Gets the list of window classes that accept key events sent
+     *         directly to the window, without changing window focus.
+     *
+     * @return  All window class or class name values that allow direct input.
+     */
+    juce::StringArray getDirectInputClasses() const;
+
     /**
      * @brief  Sets whether the application should start up in minimized mode.
      *
@@ -71,4 +180,12 @@ public:
      *                       decides to send it.
      */
     void setImmediateMode(const bool immediateMode);
+
+    /**
+     * @brief  Sets how long chord key releases may be spread out while still
+     *         entering a single chord.
+     *
+     * @param releaseDelay  The new chord release delay, in milliseconds.
+     */
+    void setChordReleaseDelay(const int releaseDelay);
 };
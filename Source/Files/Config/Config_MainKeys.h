@@ -21,5 +21,56 @@ namespace Config
         // Whether the application should start in immediate text entry mode:
         static const DataKey immediateMode("immediateMode",
                 DataKey::DataType::boolType);
+        // The method used to create key events sent to the target window:
+        static const DataKey outputMethod("outputMethod",
+                DataKey::DataType::stringType);
+        // Milliseconds to wait for more keys before sending immediate mode
+        // output, so that several keys can share one window focus change:
+        static const DataKey outputCoalesceTime("outputCoalesceTime",
+                DataKey::DataType::intType);
+        // Whether a local copy of the window tree should be kept, so window
+        // searches don't need to query the X server:
+        static const DataKey mirrorWindowTree("mirrorWindowTree",
+                DataKey::DataType::boolType);
+        // Whether the application window should be moved and resized when its
+        // layout changes, instead of being destroyed and recreated:
+        static const DataKey reuseWindow("reuseWindow",
+                DataKey::DataType::boolType);
+        // Whether the application should stay running in the background when
+        // closed, so that it can be shown again without restarting:
+        static const DataKey residentMode("residentMode",
+                DataKey::DataType::boolType);
+        // Whether chord keys should be read as XInput2 raw key events, timed
+        // using X server timestamps:
+        static const DataKey rawKeyInput("rawKeyInput",
+                DataKey::DataType::boolType);
+        // Milliseconds that may pass between chord key releases while still
+        // entering a single chord:
+        static const DataKey chordReleaseDelay("chordReleaseDelay",
+                DataKey::DataType::intType);
+        // Whether the chord release delay should adjust to match how quickly
+        // the user releases chord keys:
+        static const DataKey adaptiveReleaseDelay("adaptiveReleaseDelay",
+                DataKey::DataType::boolType);
+        // Whether a new chord may begin before all keys in the last chord are
+        // released:
+        static const DataKey chordRollover("chordRollover",
+                DataKey::DataType::boolType);
+        // File where chord key timing should be recorded, or the empty string
+        // if timing shouldn't be recorded:
+        static const DataKey chordSessionFile("chordSessionFile",
+                DataKey::DataType::stringType);
+        // Word list file used to suggest word completions, or the empty string
+        // if words shouldn't be suggested:
+        static const DataKey wordListFile("wordListFile",
+                DataKey::DataType::stringType);
+        // Dictionary file of chord sequences that expand into whole words, or
+        // the empty string if briefs shouldn't be used:
+        static const DataKey briefFile("briefFile",
+                DataKey::DataType::stringType);
+        // Window classes that accept key events sent directly to the window
+        // without changing window focus:
+        static const juce::Identifier directInputClasses(
+                "directInputClasses");
     }
 }
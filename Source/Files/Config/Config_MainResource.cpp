@@ -12,12 +12,29 @@ static const juce::String configFilename("config.json");
 Config::MainResource::MainResource() :
 Config::FileResource(resourceKey, configFilename)
 {
+    const juce::var classList
+            = initProperty<juce::var>(MainKeys::directInputClasses);
+    if (classList.isArray())
+    {
+        for (const juce::var& windowClass : *classList.getArray())
+        {
+            directInputClasses.add(windowClass.toString());
+        }
+    }
     loadJSONData();
 }
 
 Config::MainResource::~MainResource() { }
 
 
+// Gets the list of window classes that accept key events sent directly to the
+// window.
+const juce::StringArray& Config::MainResource::getDirectInputClasses() const
+{
+    return directInputClasses;
+}
+
+
 // Gets the set of all basic(non-array, non-object) properties tracked by this
 // Resource.
 const std::vector<Config::DataKey>& Config::MainResource::getConfigKeys() const
@@ -26,7 +43,27 @@ const std::vector<Config::DataKey>& Config::MainResource::getConfigKeys() const
     {
         MainKeys::minimized,
         MainKeys::snapToBottom,
-        MainKeys::immediateMode
+        MainKeys::immediateMode,
+        MainKeys::outputMethod,
+        MainKeys::outputCoalesceTime,
+        MainKeys::mirrorWindowTree,
+        MainKeys::reuseWindow,
+        MainKeys::residentMode,
+        MainKeys::rawKeyInput,
+        MainKeys::chordReleaseDelay,
+        MainKeys::adaptiveReleaseDelay,
+        MainKeys::chordRollover,
+        MainKeys::chordSessionFile,
+        MainKeys::wordListFile,
+        MainKeys::briefFile
     };
     return keyList;
 }
+
+
+// Checks if a key string is valid for this FileResource.
+bool Config::MainResource::isValidKey(const juce::Identifier& key) const
+{
+    return key == MainKeys::directInputClasses
+            || Config::FileResource::isValidKey(key);
+}
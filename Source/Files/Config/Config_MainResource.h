@@ -23,6 +23,14 @@ public:
 
     virtual ~MainResource();
 
+    /**
+     * @brief  Gets the list of window classes that accept key events sent
+     *         directly to the window.
+     *
+     * @return  All window class or class name values that allow direct input.
+     */
+    const juce::StringArray& getDirectInputClasses() const;
+
 private:
     /**
      * @brief  Gets the set of all basic(non-array, non-object) properties
@@ -31,4 +39,17 @@ private:
      * @return  All specific string values stored by this resouve
      */
     const std::vector<Config::DataKey>& getConfigKeys() const final override;
+
+    /**
+     * @brief  Checks if a key string is valid for this FileResource.
+     *
+     * @param key  A key string value to check.
+     *
+     * @return     Whether the key is a basic configuration key or the direct
+     *             input class list key.
+     */
+    bool isValidKey(const juce::Identifier& key) const override;
+
+    // Window classes that accept key events sent directly to the window:
+    juce::StringArray directInputClasses;
 };
@@ -0,0 +1,73 @@
+#include "Daemon_Client.h"
+#include "Daemon_Socket.h"
+#include <unistd.h>
+
+#ifdef JUCE_DEBUG
+// Print the full namespace name before all debug output:
+static const constexpr char* dbgPrefix = "Daemon::Client::";
+#endif
+
+// Milliseconds to wait for the resident instance to handle a request. This
+// needs to be long enough for a focus change to finish.
+static const constexpr int replyTimeout = 3000;
+
+/**
+ * @brief  Sends a request to the resident instance, and waits for it to reply.
+ *
+ * @param request  The full request message.
+ *
+ * @return         Whether the resident instance replied that the request
+ *                 succeeded.
+ */
+static bool sendRequest(const juce::String& request)
+{
+    const int socketFD = Daemon::Socket::connectToServer();
+    if (socketFD == -1)
+    {
+        return false;
+    }
+    bool succeeded = false;
+    if (Daemon::Socket::sendMessage(socketFD, request))
+    {
+        succeeded = Daemon::Socket::readMessage(socketFD, replyTimeout)
+                == Daemon::Socket::successReply;
+    }
+    close(socketFD);
+    DBG(dbgPrefix << __func__ << ": Request \"" << request << "\" "
+            << (succeeded ? "succeeded" : "failed"));
+    return succeeded;
+}
+
+
+// Checks if a resident instance is listening for requests.
+bool Daemon::Client::isServerListening()
+{
+    const int socketFD = Socket::connectToServer();
+    if (socketFD == -1)
+    {
+        return false;
+    }
+    close(socketFD);
+    return true;
+}
+
+
+// Asks the resident instance to show its window.
+bool Daemon::Client::requestShow(const int targetWindow)
+{
+    return sendRequest(Socket::showRequest + " " + juce::String(targetWindow));
+}
+
+
+// Asks the resident instance to hide its window.
+bool Daemon::Client::requestHide()
+{
+    return sendRequest(Socket::hideRequest);
+}
+
+
+// Asks the resident instance to shut down.
+bool Daemon::Client::requestQuit()
+{
+    return sendRequest(Socket::quitRequest);
+}
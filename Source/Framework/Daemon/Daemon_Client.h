@@ -0,0 +1,53 @@
+#pragma once
+/**
+ * @file  Daemon_Client.h
+ *
+ * @brief  Sends requests to a resident KeyChord instance.
+ */
+
+/**
+ * @brief  Signals a resident KeyChord instance's Daemon::Server.
+ *
+ *  These functions don't depend on the JUCE application or message thread, so
+ * they may be used before the JUCE library is initialized. Each request waits
+ * until the resident instance has finished handling it.
+ *
+ * @see Daemon_Server.h
+ */
+namespace Daemon
+{
+    namespace Client
+    {
+        /**
+         * @brief  Checks if a resident instance is listening for requests.
+         *
+         * @return  Whether a resident instance's socket accepted a connection.
+         */
+        bool isServerListening();
+
+        /**
+         * @brief  Asks the resident instance to show its window.
+         *
+         * @param targetWindow  The ID of the window that should receive the
+         *                      resident instance's input.
+         *
+         * @return              Whether the resident instance showed its
+         *                      window.
+         */
+        bool requestShow(const int targetWindow);
+
+        /**
+         * @brief  Asks the resident instance to hide its window.
+         *
+         * @return  Whether the resident instance hid its window.
+         */
+        bool requestHide();
+
+        /**
+         * @brief  Asks the resident instance to shut down.
+         *
+         * @return  Whether the resident instance accepted the request.
+         */
+        bool requestQuit();
+    }
+}
@@ -0,0 +1,205 @@
+#include "Daemon_Server.h"
+#include "Daemon_Socket.h"
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Daemon::Server::";
+#endif
+
+// Milliseconds to wait for new connections before checking if the thread
+// should exit:
+static const constexpr int pollFrequency = 100;
+// Milliseconds to wait for a client to send its request:
+static const constexpr int readTimeout = 500;
+// Milliseconds to wait for a request's action to finish:
+static const constexpr int actionTimeout = 5000;
+// Number of pending connections the socket will hold:
+static const constexpr int connectionBacklog = 4;
+// Message thread action states:
+static const constexpr int actionPending = 0;
+static const constexpr int actionStarted = 1;
+static const constexpr int actionCancelled = 2;
+
+
+// Creates the server socket and starts listening for requests.
+Daemon::Server::Server(const std::function<void(const int)> showAction,
+        const std::function<void()> hideAction,
+        const std::function<void()> quitAction) :
+juce::Thread("Daemon::Server"),
+showAction(showAction),
+hideAction(hideAction),
+quitAction(quitAction),
+socketPath(Socket::getPath())
+{
+    // Don't replace a socket that another instance is still using:
+    const int existingFD = Socket::connectToServer();
+    if (existingFD != -1)
+    {
+        DBG(dbgPrefix << __func__ << ": Another resident instance is already "
+                << "listening.");
+        close(existingFD);
+        return;
+    }
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if ((size_t) socketPath.getNumBytesAsUTF8() >= sizeof(address.sun_path))
+    {
+        DBG(dbgPrefix << __func__ << ": Socket path is too long!");
+        return;
+    }
+    strncpy(address.sun_path, socketPath.toRawUTF8(),
+            sizeof(address.sun_path) - 1);
+    // Remove any socket left behind by an instance that didn't exit cleanly:
+    unlink(address.sun_path);
+    listenFD = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFD == -1
+            || bind(listenFD, (sockaddr*) &address, sizeof(address)) != 0
+            || listen(listenFD, connectionBacklog) != 0)
+    {
+        DBG(dbgPrefix << __func__ << ": Failed to open socket " << socketPath
+                << ": " << strerror(errno));
+        if (listenFD != -1)
+        {
+            close(listenFD);
+            listenFD = -1;
+        }
+        return;
+    }
+    DBG(dbgPrefix << __func__ << ": Listening on " << socketPath);
+    startThread();
+}
+
+
+// Stops listening for requests, and removes the server socket.
+Daemon::Server::~Server()
+{
+    stopThread(pollFrequency * 2 + actionTimeout);
+    if (listenFD != -1)
+    {
+        close(listenFD);
+        listenFD = -1;
+        unlink(socketPath.toRawUTF8());
+    }
+}
+
+
+// Checks if the server is listening for requests.
+bool Daemon::Server::isListening() const
+{
+    return listenFD != -1;
+}
+
+
+// Waits for and handles client connections until the thread is told to exit.
+void Daemon::Server::run()
+{
+    while (! threadShouldExit())
+    {
+        pollfd pollData = { listenFD, POLLIN, 0 };
+        if (poll(&pollData, 1, pollFrequency) <= 0)
+        {
+            continue;
+        }
+        const int clientFD = accept4(listenFD, nullptr, nullptr, SOCK_CLOEXEC);
+        if (clientFD != -1)
+        {
+            handleConnection(clientFD);
+            close(clientFD);
+        }
+    }
+}
+
+
+// Reads a single request from a client connection, runs its action, and
+// replies once the action is finished.
+void Daemon::Server::handleConnection(const int clientFD)
+{
+    const juce::String request = Socket::readMessage(clientFD, readTimeout);
+    if (request.isEmpty())
+    {
+        // Clients may connect without sending anything, just to check if the
+        // server is listening.
+        return;
+    }
+    DBG(dbgPrefix << __func__ << ": Received request \"" << request << "\"");
+    const juce::String requestType = request.upToFirstOccurrenceOf(" ", false,
+            false);
+    std::function<void()> action;
+    if (requestType == Socket::showRequest)
+    {
+        const int targetWindow = request.fromFirstOccurrenceOf(" ", false,
+                false).getIntValue();
+        // Copy the show action so the message thread never needs to access
+        // this Server:
+        const std::function<void(const int)> show = showAction;
+        action = [show, targetWindow]() { show(targetWindow); };
+    }
+    else if (requestType == Socket::hideRequest)
+    {
+        action = hideAction;
+    }
+    else if (requestType == Socket::quitRequest)
+    {
+        action = quitAction;
+    }
+    else
+    {
+        DBG(dbgPrefix << __func__ << ": Ignoring invalid request.");
+        return;
+    }
+    if (runOnMessageThread(action))
+    {
+        Socket::sendMessage(clientFD, Socket::successReply);
+    }
+}
+
+
+// Runs an action on the message thread, waiting until it finishes.
+bool Daemon::Server::runOnMessageThread(const std::function<void()> action)
+{
+    // Action state is shared with the message thread, so the action can be
+    // cancelled if this function stops waiting before it starts:
+    struct PendingAction
+    {
+        std::function<void()> action;
+        juce::Atomic<int> state { actionPending };
+        juce::WaitableEvent finished;
+    };
+    std::shared_ptr<PendingAction> pending = std::make_shared<PendingAction>();
+    pending->action = action;
+    juce::MessageManager::callAsync([pending]()
+    {
+        if (pending->state.compareAndSetBool(actionStarted, actionPending))
+        {
+            pending->action();
+            pending->finished.signal();
+        }
+    });
+    const juce::uint32 endTime = juce::Time::getMillisecondCounter()
+            + actionTimeout;
+    while (! pending->finished.wait(pollFrequency))
+    {
+        if (threadShouldExit())
+        {
+            pending->state.compareAndSetBool(actionCancelled, actionPending);
+            return false;
+        }
+        // Once an action starts it can't be cancelled, so only stop waiting
+        // for actions that haven't started yet:
+        if (juce::Time::getMillisecondCounter() >= endTime
+                && pending->state.compareAndSetBool(actionCancelled,
+                    actionPending))
+        {
+            DBG(dbgPrefix << __func__ << ": Request timed out.");
+            return false;
+        }
+    }
+    return true;
+}
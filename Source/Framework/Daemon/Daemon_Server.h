@@ -0,0 +1,101 @@
+#pragma once
+/**
+ * @file  Daemon_Server.h
+ *
+ * @brief  Listens for requests sent to a resident KeyChord instance.
+ */
+
+#include "JuceHeader.h"
+
+namespace Daemon { class Server; }
+
+/**
+ * @brief  Accepts show, hide, and quit requests over a Unix-domain socket,
+ *         running the matching action on the JUCE message thread.
+ *
+ *  While a Server exists, the application stays resident: instead of exiting
+ * when its window closes, it hides the window and waits for a new launch to
+ * ask it to show itself again. Launching KeyChord checks for the Server's
+ * socket before the JUCE library is even initialized, so showing a resident
+ * instance skips all application startup work.
+ *
+ *  Requests are read on the Server's own thread. Each request's reply is only
+ * sent after its action finishes on the message thread, so clients can tell
+ * when the window is actually ready.
+ *
+ * @see Daemon_Client.h
+ */
+class Daemon::Server : private juce::Thread
+{
+public:
+    /**
+     * @brief  Creates the server socket and starts listening for requests.
+     *
+     *  If another server is already listening on the socket, this server will
+     * not start.
+     *
+     * @param showAction  The action to run when the window should be shown.
+     *                    This is passed the ID of the window that should
+     *                    receive input.
+     *
+     * @param hideAction  The action to run when the window should be hidden.
+     *
+     * @param quitAction  The action to run when the application should shut
+     *                    down.
+     */
+    Server(const std::function<void(const int)> showAction,
+            const std::function<void()> hideAction,
+            const std::function<void()> quitAction);
+
+    /**
+     * @brief  Stops listening for requests, and removes the server socket.
+     */
+    virtual ~Server();
+
+    /**
+     * @brief  Checks if the server is listening for requests.
+     *
+     * @return  Whether the server socket was created successfully.
+     */
+    bool isListening() const;
+
+private:
+    /**
+     * @brief  Waits for and handles client connections until the thread is
+     *         told to exit.
+     */
+    void run() override;
+
+    /**
+     * @brief  Reads a single request from a client connection, runs its
+     *         action, and replies once the action is finished.
+     *
+     * @param clientFD  The client connection's file descriptor.
+     */
+    void handleConnection(const int clientFD);
+
+    /**
+     * @brief  Runs an action on the message thread, waiting until it
+     *         finishes.
+     *
+     *  If the thread is told to exit, or the request times out before the
+     * action starts, the action is cancelled and will never run.
+     *
+     * @param action  The action to run.
+     *
+     * @return        Whether the action finished before the thread was told to
+     *                exit. This is also false if the request timed out before
+     *                the action started.
+     */
+    bool runOnMessageThread(const std::function<void()> action);
+
+    const std::function<void(const int)> showAction;
+    const std::function<void()> hideAction;
+    const std::function<void()> quitAction;
+    // The listening socket's file descriptor:
+    int listenFD = -1;
+    // The path where the socket was created:
+    const juce::String socketPath;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Server)
+};
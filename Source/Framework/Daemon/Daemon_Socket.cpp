@@ -0,0 +1,122 @@
+#include "Daemon_Socket.h"
+#include <cstdlib>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifdef JUCE_DEBUG
+// Print the full namespace name before all debug output:
+static const constexpr char* dbgPrefix = "Daemon::Socket::";
+#endif
+
+// Socket file name prefix:
+static const juce::String socketPrefix("KeyChord-");
+// Socket file name suffix:
+static const juce::String socketSuffix(".socket");
+// Longest message line that will be read:
+static const constexpr int maxMessageLength = 256;
+
+
+// Gets the path of the socket used by the resident instance on the current X
+// display.
+juce::String Daemon::Socket::getPath()
+{
+    const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR");
+    const char* displayName = std::getenv("DISPLAY");
+    juce::String socketDir = (runtimeDir != nullptr && runtimeDir[0] != '\0')
+            ? juce::String(runtimeDir) : juce::String("/tmp");
+    juce::String displayID = (displayName != nullptr)
+            ? juce::String(displayName).retainCharacters("0123456789.")
+            : juce::String();
+    return socketDir + "/" + socketPrefix + juce::String((int) getuid())
+            + "-" + displayID + socketSuffix;
+}
+
+
+// Opens a connection to the resident instance's socket.
+int Daemon::Socket::connectToServer()
+{
+    const juce::String path = getPath();
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if ((size_t) path.getNumBytesAsUTF8() >= sizeof(address.sun_path))
+    {
+        DBG(dbgPrefix << __func__ << ": Socket path " << path
+                << " is too long!");
+        return -1;
+    }
+    strncpy(address.sun_path, path.toRawUTF8(), sizeof(address.sun_path) - 1);
+    const int socketFD = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socketFD == -1)
+    {
+        return -1;
+    }
+    if (connect(socketFD, (sockaddr*) &address, sizeof(address)) != 0)
+    {
+        close(socketFD);
+        return -1;
+    }
+    return socketFD;
+}
+
+
+// Writes a single message line to a socket.
+bool Daemon::Socket::sendMessage
+(const int socketFD, const juce::String& message)
+{
+    const juce::String line = message + "\n";
+    const char* data = line.toRawUTF8();
+    size_t remaining = line.getNumBytesAsUTF8();
+    while (remaining > 0)
+    {
+        const ssize_t written = send(socketFD, data, remaining, MSG_NOSIGNAL);
+        if (written <= 0)
+        {
+            return false;
+        }
+        data += written;
+        remaining -= written;
+    }
+    return true;
+}
+
+
+// Reads a single message line from a socket.
+juce::String Daemon::Socket::readMessage
+(const int socketFD, const int timeoutMS)
+{
+    char buffer[maxMessageLength];
+    int length = 0;
+    const juce::uint32 endTime = juce::Time::getMillisecondCounter()
+            + timeoutMS;
+    while (length < maxMessageLength)
+    {
+        const juce::uint32 now = juce::Time::getMillisecondCounter();
+        if (now >= endTime)
+        {
+            break;
+        }
+        pollfd pollData = { socketFD, POLLIN, 0 };
+        if (poll(&pollData, 1, (int) (endTime - now)) <= 0)
+        {
+            break;
+        }
+        const ssize_t bytesRead = recv(socketFD, buffer + length,
+                maxMessageLength - length, 0);
+        if (bytesRead <= 0)
+        {
+            break;
+        }
+        const char* lineEnd = static_cast<const char*>(
+                memchr(buffer + length, '\n', bytesRead));
+        length += bytesRead;
+        if (lineEnd != nullptr)
+        {
+            return juce::String::fromUTF8(buffer, (int) (lineEnd - buffer));
+        }
+    }
+    return juce::String();
+}
@@ -0,0 +1,79 @@
+#pragma once
+/**
+ * @file  Daemon_Socket.h
+ *
+ * @brief  Defines the Unix-domain socket used to signal a resident KeyChord
+ *         instance, and the messages sent through it.
+ */
+
+#include "JuceHeader.h"
+
+/**
+ * @brief  Shared socket functions used by both Daemon::Server and
+ *         Daemon::Client.
+ *
+ *  Each message is a single line of text. Clients send one request per
+ * connection, and the server answers it with a single reply line once the
+ * request has been handled.
+ */
+namespace Daemon
+{
+    namespace Socket
+    {
+        // Asks the resident instance to show itself. The request is followed
+        // by a space and the ID of the window that should receive input:
+        static const juce::String showRequest("show");
+        // Asks the resident instance to hide its window:
+        static const juce::String hideRequest("hide");
+        // Asks the resident instance to shut down:
+        static const juce::String quitRequest("quit");
+        // Sent by the server once a request has been handled:
+        static const juce::String successReply("ok");
+
+        /**
+         * @brief  Gets the path of the socket used by the resident instance
+         *         on the current X display.
+         *
+         *  The socket is created in $XDG_RUNTIME_DIR if it is set, or in /tmp
+         * otherwise. The display name and user ID are included in the socket
+         * name, so instances on different displays or run by different users
+         * don't interfere with each other.
+         *
+         * @return  The full socket path.
+         */
+        juce::String getPath();
+
+        /**
+         * @brief  Opens a connection to the resident instance's socket.
+         *
+         * @return  The connected socket's file descriptor, or -1 if no
+         *          resident instance is listening.
+         */
+        int connectToServer();
+
+        /**
+         * @brief  Writes a single message line to a socket.
+         *
+         * @param socketFD  A connected socket's file descriptor.
+         *
+         * @param message   The message to send, without a line break.
+         *
+         * @return          Whether the entire message was written.
+         */
+        bool sendMessage(const int socketFD, const juce::String& message);
+
+        /**
+         * @brief  Reads a single message line from a socket.
+         *
+         * @param socketFD   A connected socket's file descriptor.
+         *
+         * @param timeoutMS  Milliseconds to wait for the full message before
+         *                   giving up.
+         *
+         * @return           The received message without its line break, or
+         *                   the empty string if the connection closed or timed
+         *                   out before a full message arrived.
+         */
+        juce::String readMessage(const int socketFD, const int timeoutMS);
+    }
+}
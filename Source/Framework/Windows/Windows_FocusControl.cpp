@@ -1,4 +1,5 @@
 #include "Windows_FocusControl.h"
+#include "Windows_FocusMonitor.h"
 #include "Windows_XInterface.h"
 #include "MainWindow.h"
 
@@ -7,17 +8,26 @@
 static const constexpr char* dbgPrefix = "Windows::FocusControl::";
 #endif
 
-// Milliseconds to wait between window focus attempts:
+// Milliseconds to wait for focus events before requesting focus again:
 static const constexpr int focusWaitMs = 100;
-// Each attempt to set and check window focus status should wait a little longer
-// before the next test. Wait time multiplier:
+// Each time focus is requested again, the next request should wait a little
+// longer. Wait time multiplier:
 static const constexpr float focusWaitMultiplier = 1.1;
 // Milliseconds to wait before abandoning window focus attempts:
 static const constexpr int focusTimeout = 2000;
+// Milliseconds to run the JUCE event loop between focus event checks, when
+// focus also depends on JUCE component state:
+static const constexpr int eventLoopSliceMs = 1;
 
-Windows::FocusControl::FocusControl()
+/**
+ * @brief  Gets the FocusMonitor shared by all FocusControl objects.
+ *
+ * @return  The FocusMonitor, created the first time it is needed.
+ */
+static Windows::FocusMonitor& getFocusMonitor()
 {
-    focusChecker.setCheckInterval(focusWaitMs, focusWaitMultiplier);
+    static Windows::FocusMonitor focusMonitor;
+    return focusMonitor;
 }
 
 
@@ -26,22 +36,14 @@ Windows::FocusControl::FocusControl()
 void Windows::FocusControl::focusWindow
 (const int windowID, std::function<void()> onFailure)
 {
-    Windows::XInterface xInterface;
-    xInterface.activateWindow(windowID);
-    focusChecker.startCheck([&xInterface, windowID]()
+    if (activateAndWait((Window) windowID))
     {
-        const bool isActive = xInterface.isActiveWindow(windowID);
-        if (! isActive)
-        {
-            xInterface.activateWindow(windowID);
-        }
-        return isActive;
-    },
-    [windowID]()
+        DBG(dbgPrefix << __func__ << ": Focused window " << windowID);
+    }
+    else
     {
-        DBG(dbgPrefix << "focusWindow: Focused window " << windowID);
-    }, focusTimeout);
-    focusChecker.waitForUpdate(true);
+        onFailure();
+    }
 }
 
 
@@ -56,35 +58,105 @@ void Windows::FocusControl::takeFocus(juce::Component* mainComponent)
         DBG(dbgPrefix << __func__ << ": Application window not found!");
         return;
     }
-    xInterface.activateWindow(appWindowID);
-    focusChecker.startCheck([&xInterface, appWindowID, mainComponent]()
+    const std::function<void()> grabFocus = [mainComponent]()
     {
-        DBG(dbgPrefix << "::takeFocus: checking focus: ");
-        const bool keyboardFocused = mainComponent->hasKeyboardFocus(true);
-        const bool windowFocused = xInterface.isActiveWindow(appWindowID);
-        if (! windowFocused)
-        {
-            DBG(dbgPrefix
-                    << "::takeFocus: no window focus, trying again..: ");
-            xInterface.activateWindow(xInterface.getMainAppWindow());
-        }
-        if (! keyboardFocused && (mainComponent->isShowing()
-                || mainComponent->isOnDesktop()))
+        if (! mainComponent->hasKeyboardFocus(true)
+                && (mainComponent->isShowing() || mainComponent->isOnDesktop()))
         {
             DBG(dbgPrefix
                     << "::takeFocus: trying to get missing keyboard focus: ");
             mainComponent->grabKeyboardFocus();
         }
-        return xInterface.isActiveWindow(appWindowID)
-                && mainComponent->hasKeyboardFocus(true);
-    },
-    [appWindowID]()
+    };
+    grabFocus();
+    const bool focused = activateAndWait((Window) appWindowID,
+            [mainComponent]()
+            {
+                return mainComponent->hasKeyboardFocus(true);
+            },
+            grabFocus);
+    if (focused)
+    {
+        DBG(dbgPrefix << __func__ << ": Focused window " << appWindowID);
+    }
+    else
     {
-        DBG(dbgPrefix << "::takeFocus: Focused window " << appWindowID);
-    }, focusTimeout,
-    []()
+        DBG(dbgPrefix << __func__ << ": Failed to focus window!");
+    }
+}
+
+
+// Activates a window, then waits until it is active or the focus timeout
+// period ends.
+bool Windows::FocusControl::activateAndWait(const Window window,
+        const std::function<bool()> readyCheck,
+        const std::function<void()> onRetry)
+{
+    using juce::Time;
+    Windows::XInterface xInterface;
+    FocusMonitor& focusMonitor = getFocusMonitor();
+    // Start listening before activating, so no focus events are missed:
+    focusMonitor.watchWindow(window);
+    xInterface.activateWindow(window);
+
+    const juce::uint32 startTime = Time::getMillisecondCounter();
+    const bool runEventLoop = readyCheck
+            && juce::MessageManager::existsAndIsCurrentThread();
+    float retryInterval = focusWaitMs;
+    juce::uint32 nextRetry = startTime + focusWaitMs;
+    bool windowActive = xInterface.isActiveWindow(window);
+    for (;;)
     {
-        DBG(dbgPrefix << "::takeFocus: Failed to focus window!");
-    });
-    focusChecker.waitForUpdate(true);
+        if (windowActive && (! readyCheck || readyCheck()))
+        {
+            DBG(dbgPrefix << __func__ << ": Focus confirmed after "
+                    << (int) (Time::getMillisecondCounter() - startTime)
+                    << "ms");
+            return true;
+        }
+        const juce::uint32 currentTime = Time::getMillisecondCounter();
+        if (currentTime - startTime >= focusTimeout)
+        {
+            return false;
+        }
+        if (currentTime >= nextRetry)
+        {
+            // No focus events arrived in time, try again:
+            if (! windowActive)
+            {
+                xInterface.activateWindow(window);
+            }
+            if (onRetry)
+            {
+                onRetry();
+            }
+            retryInterval *= focusWaitMultiplier;
+            nextRetry = currentTime + (juce::uint32) retryInterval;
+            windowActive = xInterface.isActiveWindow(window);
+            continue;
+        }
+        if (runEventLoop)
+        {
+            // Give JUCE a chance to handle its own focus events between
+            // checks:
+            if (focusMonitor.waitForFocusEvent(0))
+            {
+                windowActive = xInterface.isActiveWindow(window);
+            }
+            else
+            {
+                juce::MessageManager::getInstance()->runDispatchLoopUntil(
+                        eventLoopSliceMs);
+            }
+        }
+        else
+        {
+            const juce::uint32 waitEnd = std::min(nextRetry,
+                    startTime + (juce::uint32) focusTimeout);
+            if (focusMonitor.waitForFocusEvent((int) (waitEnd - currentTime)))
+            {
+                windowActive = xInterface.isActiveWindow(window);
+            }
+        }
+    }
 }
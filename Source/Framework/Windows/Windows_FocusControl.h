@@ -6,14 +6,27 @@
  *         that focus has been gained.
  */
 
-#include "Util_ConditionChecker.h"
+#include "JuceHeader.h"
+#include <X11/Xlib.h>
 
 namespace Windows { class FocusControl; }
 
+/**
+ * @brief  Changes window focus, waiting until the X server reports that the
+ *         focus change succeeded.
+ *
+ *  Instead of checking window focus on a fixed schedule, FocusControl waits
+ * for focus events from a shared Windows::FocusMonitor, and checks focus
+ * again as soon as one arrives. Focus requests are still periodically repeated
+ * in case the window manager ignores them. FocusControl should only be used on
+ * the JUCE message thread.
+ */
 class Windows::FocusControl
 {
 public:
-    FocusControl();
+    FocusControl() { }
+
+    virtual ~FocusControl() { }
 
     /**
      * @brief  Focuses the window with the given window ID, waiting until
@@ -38,7 +51,24 @@ public:
     void takeFocus(juce::Component* mainComponent);
 
 private:
-    // Handles the process of regularly checking for window focus conditions to
-    // be met:
-    Util::ConditionChecker focusChecker;
+    /**
+     * @brief  Activates a window, then waits until it is active or the focus
+     *         timeout period ends.
+     *
+     * @param window         The XLib ID of the window to activate.
+     *
+     * @param readyCheck     An optional extra check that must also pass before
+     *                       focus is complete. If set, the JUCE event loop will
+     *                       run while waiting, so this check may depend on the
+     *                       state of JUCE components.
+     *
+     * @param onRetry        An optional action to run whenever the window is
+     *                       re-activated after focus events failed to arrive.
+     *
+     * @return               Whether the window became active and the ready
+     *                       check passed before the timeout period ended.
+     */
+    bool activateAndWait(const Window window,
+            const std::function<bool()> readyCheck = std::function<bool()>(),
+            const std::function<void()> onRetry = std::function<void()>());
 };
@@ -0,0 +1,129 @@
+#include "Windows_FocusMonitor.h"
+#include <poll.h>
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Windows::FocusMonitor::";
+#endif
+
+// The property holding the current active window ID:
+static const constexpr char* activeWindowProperty = "_NET_ACTIVE_WINDOW";
+
+
+// Opens the monitor's display connection and starts listening for active
+// window changes.
+Windows::FocusMonitor::FocusMonitor() : display(XOpenDisplay(nullptr))
+{
+    if (display == nullptr)
+    {
+        DBG(dbgPrefix << __func__ << ": Failed to open X display!");
+        return;
+    }
+    rootWindow = XDefaultRootWindow(display);
+    activeWindowAtom = XInternAtom(display, activeWindowProperty, false);
+    XSelectInput(display, rootWindow, PropertyChangeMask);
+    XFlush(display);
+}
+
+
+// Closes the monitor's display connection.
+Windows::FocusMonitor::~FocusMonitor()
+{
+    if (display != nullptr)
+    {
+        XCloseDisplay(display);
+        display = nullptr;
+    }
+}
+
+
+// Checks if the monitor's display connection was opened.
+bool Windows::FocusMonitor::isValid() const
+{
+    return display != nullptr;
+}
+
+
+// Starts listening for focus events on a window.
+void Windows::FocusMonitor::watchWindow(const Window window)
+{
+    if (display == nullptr || watchedWindows.contains(window))
+    {
+        return;
+    }
+    // Structure events are needed to find out when the window is destroyed:
+    XSelectInput(display, window, FocusChangeMask | StructureNotifyMask);
+    // Make sure the server applies the event mask before focus changes:
+    XSync(display, false);
+    watchedWindows.add(window);
+}
+
+
+// Waits until a focus event is received, or the timeout period ends.
+bool Windows::FocusMonitor::waitForFocusEvent(const int timeoutMS)
+{
+    if (display == nullptr)
+    {
+        if (timeoutMS > 0)
+        {
+            juce::Thread::sleep(timeoutMS);
+        }
+        return false;
+    }
+    if (readQueuedEvents())
+    {
+        return true;
+    }
+    const juce::uint32 endTime = juce::Time::getMillisecondCounter()
+            + std::max(0, timeoutMS);
+    pollfd connectionPoll;
+    connectionPoll.fd = ConnectionNumber(display);
+    connectionPoll.events = POLLIN;
+    juce::uint32 currentTime = juce::Time::getMillisecondCounter();
+    while (currentTime < endTime)
+    {
+        connectionPoll.revents = 0;
+        if (poll(&connectionPoll, 1, (int) (endTime - currentTime)) > 0
+                && readQueuedEvents())
+        {
+            return true;
+        }
+        currentTime = juce::Time::getMillisecondCounter();
+    }
+    return false;
+}
+
+
+// Reads all queued events, without waiting for new events, and stops tracking
+// destroyed windows.
+bool Windows::FocusMonitor::readQueuedEvents()
+{
+    bool focusEventFound = false;
+    while (XPending(display) > 0)
+    {
+        XEvent event;
+        XNextEvent(display, &event);
+        switch (event.type)
+        {
+            case PropertyNotify:
+                if (event.xproperty.atom == activeWindowAtom)
+                {
+                    focusEventFound = true;
+                }
+                break;
+            case FocusIn:
+            case FocusOut:
+                focusEventFound = true;
+                break;
+            case DestroyNotify:
+                // Forget destroyed windows, so the list doesn't keep growing
+                // and reused window IDs are selected again:
+                watchedWindows.removeFirstMatchingValue(
+                        event.xdestroywindow.window);
+                break;
+            default:
+                break;
+        }
+    }
+    return focusEventFound;
+}
@@ -0,0 +1,91 @@
+#pragma once
+/**
+ * @file  Windows_FocusMonitor.h
+ *
+ * @brief  Waits for the X server to report window focus changes.
+ */
+
+#include <X11/Xlib.h>
+#include "JuceHeader.h"
+
+namespace Windows { class FocusMonitor; }
+
+/**
+ * @brief  Listens for window focus change events on a dedicated X display
+ *         connection.
+ *
+ *  The FocusMonitor tracks changes to the root window's _NET_ACTIVE_WINDOW
+ * property, along with FocusIn and FocusOut events on any watched windows.
+ * Instead of repeatedly checking if a window is focused, code changing window
+ * focus can wait on the FocusMonitor, and check focus again as soon as the X
+ * server reports a relevant change.
+ *
+ *  Using a separate connection keeps these events from being mixed with
+ * events read through the shared Windows::XInterface connection.
+ */
+class Windows::FocusMonitor
+{
+public:
+    /**
+     * @brief  Opens the monitor's display connection and starts listening for
+     *         active window changes.
+     */
+    FocusMonitor();
+
+    /**
+     * @brief  Closes the monitor's display connection.
+     */
+    virtual ~FocusMonitor();
+
+    /**
+     * @brief  Checks if the monitor's display connection was opened.
+     *
+     * @return  Whether the monitor is able to report focus events.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief  Starts listening for focus events on a window.
+     *
+     *  The monitor stops tracking the window once the X server reports that
+     * it was destroyed.
+     *
+     * @param window  The XLib ID of a window that may gain or lose focus.
+     */
+    void watchWindow(const Window window);
+
+    /**
+     * @brief  Waits until a focus event is received, or the timeout period
+     *         ends.
+     *
+     *  All focus events already waiting will be consumed, so the next call
+     * will only return early if new focus events arrive.
+     *
+     * @param timeoutMS  Maximum milliseconds to wait. If zero, this will only
+     *                   check for focus events that were already received.
+     *
+     * @return           Whether any focus events were received.
+     */
+    bool waitForFocusEvent(const int timeoutMS);
+
+private:
+    /**
+     * @brief  Reads all queued events, without waiting for new events, and
+     *         stops tracking destroyed windows.
+     *
+     * @return  Whether any queued events were focus events.
+     */
+    bool readQueuedEvents();
+
+    // The monitor's display connection:
+    Display* display = nullptr;
+    // The root window, where active window changes are reported:
+    Window rootWindow = 0;
+    // The atom identifying the active window property:
+    Atom activeWindowAtom = 0;
+    // Windows that have already been selected for focus events, removed once
+    // they're destroyed:
+    juce::Array<Window> watchedWindows;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FocusMonitor)
+};
@@ -0,0 +1,419 @@
+#include "Windows_TreeMirror.h"
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Windows::TreeMirror::";
+#endif
+
+// Milliseconds between applying pending window tree events when the mirror
+// isn't being queried:
+static const constexpr int eventInterval = 1000;
+
+/**
+ * @brief  Reads a window's parent and children from the X server.
+ *
+ * @param display   An open X display connection.
+ *
+ * @param window    The window to query.
+ *
+ * @param parent    Set to the window's parent, or zero for root windows.
+ *
+ * @param children  Set to the window's children, from bottom to top.
+ *
+ * @return          Whether the window exists.
+ */
+static bool queryWindow(Display* display, const Window window, Window& parent,
+        juce::Array<Window>& children)
+{
+    Window root = 0;
+    Window* childWindows = nullptr;
+    unsigned int numChildren = 0;
+    children.clearQuick();
+    const Status success = XQueryTree(display, window, &root, &parent,
+            &childWindows, &numChildren);
+    if (childWindows != nullptr)
+    {
+        children.addArray(childWindows, (int) numChildren);
+        XFree(childWindows);
+    }
+    return success != 0;
+}
+
+
+// Opens the mirror's display connection and reads the window tree.
+Windows::TreeMirror::TreeMirror() :
+        display(XOpenDisplay(nullptr)), eventTimer(*this)
+{
+    if (display == nullptr)
+    {
+        DBG(dbgPrefix << __func__ << ": Failed to open X display!");
+        return;
+    }
+    const juce::ScopedLock lock(treeLock);
+    for (int i = 0; i < ScreenCount(display); i++)
+    {
+        addWindow(RootWindow(display, i), 0);
+    }
+    // Events caused by windows created while reading the tree might duplicate
+    // changes that were already read:
+    applyEvents();
+    DBG(dbgPrefix << __func__ << ": Mirroring " << (int) nodes.size()
+            << " windows.");
+    eventTimer.startTimer(eventInterval);
+}
+
+
+// Closes the mirror's display connection.
+Windows::TreeMirror::~TreeMirror()
+{
+    const juce::ScopedLock lock(treeLock);
+    eventTimer.stopTimer();
+    if (display != nullptr)
+    {
+        XCloseDisplay(display);
+        display = nullptr;
+    }
+}
+
+
+// Checks if the mirror's display connection was opened.
+bool Windows::TreeMirror::isValid() const
+{
+    return display != nullptr;
+}
+
+
+// Gets all child windows of a parent window.
+bool Windows::TreeMirror::getChildren(const Window parent,
+        juce::Array<Window>& children)
+{
+    const juce::ScopedLock lock(treeLock);
+    applyEvents();
+    const auto nodeIter = nodes.find(parent);
+    if (nodeIter == nodes.end())
+    {
+        return false;
+    }
+    children = nodeIter->second.children;
+    return true;
+}
+
+
+// Gets the parent of a window.
+bool Windows::TreeMirror::getParent(const Window window, Window& parent)
+{
+    const juce::ScopedLock lock(treeLock);
+    applyEvents();
+    const auto nodeIter = nodes.find(window);
+    if (nodeIter == nodes.end())
+    {
+        return false;
+    }
+    parent = nodeIter->second.parent;
+    return true;
+}
+
+
+// Gets the number of windows in the tree.
+int Windows::TreeMirror::getWindowCount()
+{
+    const juce::ScopedLock lock(treeLock);
+    applyEvents();
+    return (int) nodes.size();
+}
+
+
+// Checks if the mirrored tree exactly matches the current window tree on the X
+// server.
+bool Windows::TreeMirror::matchesServerTree()
+{
+    if (display == nullptr)
+    {
+        return false;
+    }
+    const juce::ScopedLock lock(treeLock);
+    XSync(display, false);
+    applyEvents();
+    juce::Array<Window> toCheck;
+    for (int i = 0; i < ScreenCount(display); i++)
+    {
+        toCheck.add(RootWindow(display, i));
+    }
+    size_t serverWindowCount = 0;
+    while (! toCheck.isEmpty())
+    {
+        const Window window = toCheck.removeAndReturn(toCheck.size() - 1);
+        Window parent = 0;
+        juce::Array<Window> children;
+        if (! queryWindow(display, window, parent, children))
+        {
+            continue;
+        }
+        serverWindowCount++;
+        const auto nodeIter = nodes.find(window);
+        if (nodeIter == nodes.end())
+        {
+            DBG(dbgPrefix << __func__ << ": Window " << (int) window
+                    << " is missing.");
+            return false;
+        }
+        if (nodeIter->second.parent != parent
+                || nodeIter->second.children != children)
+        {
+            DBG(dbgPrefix << __func__ << ": Window " << (int) window
+                    << " has the wrong parent or children.");
+            return false;
+        }
+        toCheck.addArray(children);
+    }
+    if (serverWindowCount != nodes.size())
+    {
+        DBG(dbgPrefix << __func__ << ": Mirror has " << (int) nodes.size()
+                << " windows, server has " << (int) serverWindowCount);
+        return false;
+    }
+    return true;
+}
+
+
+// Adds a window and all of its descendants to the mirrored tree, and starts
+// listening for changes to their children.
+void Windows::TreeMirror::addWindow(const Window window, const Window parent)
+{
+    if (nodes.count(window) > 0)
+    {
+        return;
+    }
+    // Listen for changes before reading children, so that no changes are
+    // missed:
+    XSelectInput(display, window, SubstructureNotifyMask);
+    Window serverParent = 0;
+    juce::Array<Window> children;
+    if (! queryWindow(display, window, serverParent, children))
+    {
+        return;
+    }
+    Node& node = nodes[window];
+    node.parent = parent;
+    if (parent != 0)
+    {
+        nodes[parent].children.addIfNotAlreadyThere(window);
+    }
+    for (const Window& child : children)
+    {
+        addWindow(child, window);
+    }
+}
+
+
+// Removes a window and all of its descendants from the mirrored tree.
+void Windows::TreeMirror::removeWindow(const Window window)
+{
+    const auto nodeIter = nodes.find(window);
+    if (nodeIter == nodes.end())
+    {
+        return;
+    }
+    const Node node = nodeIter->second;
+    nodes.erase(nodeIter);
+    const auto parentIter = nodes.find(node.parent);
+    if (parentIter != nodes.end())
+    {
+        parentIter->second.children.removeFirstMatchingValue(window);
+    }
+    for (const Window& child : node.children)
+    {
+        removeWindow(child);
+    }
+}
+
+
+// Moves a window within its parent's stacking order.
+void Windows::TreeMirror::restackWindow(const Window window,
+        const Window aboveWindow)
+{
+    const auto nodeIter = nodes.find(window);
+    if (nodeIter == nodes.end())
+    {
+        return;
+    }
+    const auto parentIter = nodes.find(nodeIter->second.parent);
+    if (parentIter == nodes.end())
+    {
+        return;
+    }
+    juce::Array<Window>& siblings = parentIter->second.children;
+    siblings.removeFirstMatchingValue(window);
+    if (aboveWindow == None)
+    {
+        siblings.insert(0, window);
+    }
+    else
+    {
+        const int aboveIndex = siblings.indexOf(aboveWindow);
+        if (aboveIndex < 0)
+        {
+            // The mirrored siblings are out of date, so the window's position
+            // is unknown:
+            staleParents.addIfNotAlreadyThere(parentIter->first);
+            siblings.add(window);
+            return;
+        }
+        siblings.insert(aboveIndex + 1, window);
+    }
+}
+
+
+// Reads the children of a stale window from the X server again, replacing the
+// mirrored children and their stacking order.
+void Windows::TreeMirror::refreshChildren(const Window parent)
+{
+    if (nodes.count(parent) == 0)
+    {
+        return;
+    }
+    Window serverParent = 0;
+    juce::Array<Window> children;
+    if (! queryWindow(display, parent, serverParent, children))
+    {
+        // The parent was destroyed, its DestroyNotify event will remove it.
+        return;
+    }
+    for (const Window& child : children)
+    {
+        const auto childIter = nodes.find(child);
+        if (childIter == nodes.end())
+        {
+            addWindow(child, parent);
+        }
+        else if (childIter->second.parent != parent)
+        {
+            const auto oldParent = nodes.find(childIter->second.parent);
+            if (oldParent != nodes.end())
+            {
+                oldParent->second.children.removeFirstMatchingValue(child);
+            }
+            childIter->second.parent = parent;
+        }
+    }
+    // Mirrored children missing from the server's list were destroyed or
+    // reparented, and are updated when their events are applied:
+    juce::Array<Window>& mirroredChildren = nodes[parent].children;
+    mirroredChildren.clearQuick();
+    for (const Window& child : children)
+    {
+        if (nodes.count(child) > 0)
+        {
+            mirroredChildren.add(child);
+        }
+    }
+}
+
+
+// Applies all pending window tree events to the mirrored tree.
+void Windows::TreeMirror::applyEvents()
+{
+    if (display == nullptr)
+    {
+        return;
+    }
+    while (XPending(display) > 0)
+    {
+        XEvent event;
+        XNextEvent(display, &event);
+        switch (event.type)
+        {
+            case CreateNotify:
+            {
+                const XCreateWindowEvent& create = event.xcreatewindow;
+                if (nodes.count(create.parent) > 0)
+                {
+                    // New windows are created on top of their siblings:
+                    addWindow(create.window, create.parent);
+                }
+                break;
+            }
+            case DestroyNotify:
+                removeWindow(event.xdestroywindow.window);
+                break;
+            case ReparentNotify:
+            {
+                const XReparentEvent& reparent = event.xreparent;
+                const auto nodeIter = nodes.find(reparent.window);
+                if (nodeIter == nodes.end())
+                {
+                    break;
+                }
+                if (nodeIter->second.parent == reparent.parent)
+                {
+                    // Already handled through the other parent's event.
+                    break;
+                }
+                const auto oldParent = nodes.find(nodeIter->second.parent);
+                if (oldParent != nodes.end())
+                {
+                    oldParent->second.children.removeFirstMatchingValue(
+                            reparent.window);
+                }
+                nodeIter->second.parent = reparent.parent;
+                const auto newParent = nodes.find(reparent.parent);
+                if (newParent != nodes.end())
+                {
+                    // Reparented windows are placed on top of their new
+                    // siblings:
+                    newParent->second.children.add(reparent.window);
+                }
+                break;
+            }
+            case ConfigureNotify:
+                restackWindow(event.xconfigure.window, event.xconfigure.above);
+                break;
+            case CirculateNotify:
+            {
+                const XCirculateEvent& circulate = event.xcirculate;
+                const auto nodeIter = nodes.find(circulate.window);
+                if (nodeIter == nodes.end())
+                {
+                    break;
+                }
+                const auto parentIter = nodes.find(nodeIter->second.parent);
+                if (parentIter == nodes.end())
+                {
+                    break;
+                }
+                juce::Array<Window>& siblings = parentIter->second.children;
+                siblings.removeFirstMatchingValue(circulate.window);
+                if (circulate.place == PlaceOnTop)
+                {
+                    siblings.add(circulate.window);
+                }
+                else
+                {
+                    siblings.insert(0, circulate.window);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    while (! staleParents.isEmpty())
+    {
+        DBG(dbgPrefix << __func__ << ": Reading stale window "
+                << (int) staleParents.getLast() << " again.");
+        refreshChildren(staleParents.removeAndReturn(staleParents.size() - 1));
+    }
+}
+
+
+// Connects the timer to its TreeMirror on construction.
+Windows::TreeMirror::EventTimer::EventTimer(TreeMirror& treeMirror) :
+        treeMirror(treeMirror) { }
+
+
+// Applies all pending window tree events.
+void Windows::TreeMirror::EventTimer::timerCallback()
+{
+    const juce::ScopedLock lock(treeMirror.treeLock);
+    treeMirror.applyEvents();
+}
@@ -0,0 +1,183 @@
+#pragma once
+/**
+ * @file  Windows_TreeMirror.h
+ *
+ * @brief  Keeps a local copy of the X window tree up to date.
+ */
+
+#include <X11/Xlib.h>
+#include "JuceHeader.h"
+#include <unordered_map>
+
+namespace Windows { class TreeMirror; }
+
+/**
+ * @brief  Mirrors the structure and stacking order of the X window tree in
+ *         local memory.
+ *
+ *  The TreeMirror reads the entire window tree once when created, and then
+ * listens for SubstructureNotify events on every window in the tree. Window
+ * creation, destruction, reparenting, and restacking events are applied to the
+ * local copy, so window tree queries don't need any X server round trips.
+ *
+ *  The TreeMirror uses its own X display connection. All public functions are
+ * thread-safe, and apply any pending tree events before returning. Pending
+ * events are also applied periodically on the message thread, so that events
+ * don't pile up while the mirror isn't being used.
+ */
+class Windows::TreeMirror
+{
+public:
+    /**
+     * @brief  Opens the mirror's display connection and reads the window tree.
+     */
+    TreeMirror();
+
+    /**
+     * @brief  Closes the mirror's display connection.
+     */
+    virtual ~TreeMirror();
+
+    /**
+     * @brief  Checks if the mirror's display connection was opened.
+     *
+     * @return  Whether the mirror holds a copy of the window tree.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief  Gets all child windows of a parent window.
+     *
+     * @param parent    The XLib ID of a window in the tree.
+     *
+     * @param children  Set to the parent's children in stacking order from
+     *                  bottom to top, if the parent is in the tree.
+     *
+     * @return          Whether the parent window is in the tree.
+     */
+    bool getChildren(const Window parent, juce::Array<Window>& children);
+
+    /**
+     * @brief  Gets the parent of a window.
+     *
+     * @param window  The XLib ID of a window in the tree.
+     *
+     * @param parent  Set to the window's parent if the window is in the tree,
+     *                or zero if the window is a root window.
+     *
+     * @return        Whether the window is in the tree.
+     */
+    bool getParent(const Window window, Window& parent);
+
+    /**
+     * @brief  Gets the number of windows in the tree.
+     *
+     * @return  The number of mirrored windows, including root windows.
+     */
+    int getWindowCount();
+
+    /**
+     * @brief  Checks if the mirrored tree exactly matches the current window
+     *         tree on the X server.
+     *
+     *  This reads the entire window tree, so it should only be used for
+     * testing.
+     *
+     * @return  Whether every window has the same parent and children in the
+     *          same order in both trees.
+     */
+    bool matchesServerTree();
+
+private:
+    /**
+     * @brief  The mirrored state of a single window.
+     */
+    struct Node
+    {
+        // The window's parent, or zero for root windows:
+        Window parent = 0;
+        // Child windows, in stacking order from bottom to top:
+        juce::Array<Window> children;
+    };
+
+    /**
+     * @brief  Adds a window and all of its descendants to the mirrored tree,
+     *         and starts listening for changes to their children.
+     *
+     * @param window  The window to add.
+     *
+     * @param parent  The window's parent, or zero if adding a root window.
+     */
+    void addWindow(const Window window, const Window parent);
+
+    /**
+     * @brief  Removes a window and all of its descendants from the mirrored
+     *         tree.
+     *
+     * @param window  The window to remove.
+     */
+    void removeWindow(const Window window);
+
+    /**
+     * @brief  Moves a window within its parent's stacking order.
+     *
+     *  If the sibling the window should be placed above isn't mirrored, the
+     * parent window is marked as stale instead.
+     *
+     * @param window       The window to move.
+     *
+     * @param aboveWindow  The sibling the window is placed directly above, or
+     *                     None to place the window at the bottom.
+     */
+    void restackWindow(const Window window, const Window aboveWindow);
+
+    /**
+     * @brief  Reads the children of a stale window from the X server again,
+     *         replacing the mirrored children and their stacking order.
+     *
+     * @param parent  A mirrored window with out of date children.
+     */
+    void refreshChildren(const Window parent);
+
+    /**
+     * @brief  Applies all pending window tree events to the mirrored tree.
+     */
+    void applyEvents();
+
+    // The mirror's display connection:
+    Display* display = nullptr;
+    // All mirrored windows:
+    std::unordered_map<Window, Node> nodes;
+    // Windows with children that need to be read from the server again:
+    juce::Array<Window> staleParents;
+    // Protects the display connection and the mirrored tree:
+    juce::CriticalSection treeLock;
+
+    /**
+     * @brief  Periodically applies pending window tree events, so the event
+     *         queue doesn't keep growing between tree queries.
+     */
+    class EventTimer : public juce::Timer
+    {
+    public:
+        /**
+         * @brief  Connects the timer to its TreeMirror on construction.
+         *
+         * @param treeMirror  The TreeMirror using this timer.
+         */
+        EventTimer(TreeMirror& treeMirror);
+
+        virtual ~EventTimer() {}
+
+    private:
+        /**
+         * @brief  Applies all pending window tree events.
+         */
+        void timerCallback() override;
+
+        TreeMirror& treeMirror;
+    };
+    EventTimer eventTimer;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TreeMirror)
+};
@@ -1,7 +1,12 @@
 #include "Windows_XInterface.h"
+#include "Windows_TreeMirror.h"
 #include <cstring>
 #include <cstdlib>
 #include <X11/Xutil.h>
+#include <X11/XKBlib.h>
+#include <X11/Xlib-xcb.h>
+#include <xcb/xcb.h>
+#include <unordered_set>
 
 #ifdef JUCE_DEBUG
 // Print the full class name before all debug output:
@@ -21,6 +26,176 @@ static const constexpr char* windowDesktopProperty = "_NET_WM_DESKTOP";
 // The id of the process that created a window:
 static const constexpr char* windowProcessProperty = "_NET_WM_PID";
 
+// Indices of each property's atom within the atom table:
+enum AtomIndex
+{
+    supportedFeatureAtom,
+    activeWindowAtom,
+    currentDesktopAtom,
+    windowDesktopAtom,
+    windowProcessAtom,
+    atomCount
+};
+
+// Property names, in AtomIndex order:
+static const char* atomNames[atomCount] =
+{
+    supportedFeatureProperty,
+    activeWindowProperty,
+    currentDesktopProperty,
+    windowDesktopProperty,
+    windowProcessProperty
+};
+
+// Counts requests that had to wait for a reply from the X server:
+static juce::Atomic<int> roundTripCount;
+
+/**
+ * @brief  Records X server requests that wait for a reply.
+ *
+ * @param count  The number of round trips to add to the total.
+ */
+static inline void countRoundTrip(const int count = 1)
+{
+    roundTripCount += count;
+}
+
+/**
+ * @brief  Interns all window property atoms with a single X server request.
+ *
+ * @param display  An open X display connection.
+ *
+ * @return         All property atoms, in AtomIndex order.
+ */
+static juce::Array<Atom> internAtoms(Display* display)
+{
+    Atom atomValues[atomCount];
+    XInternAtoms(display, const_cast<char**>(atomNames), atomCount, false,
+            atomValues);
+    countRoundTrip();
+    return juce::Array<Atom>(atomValues, atomCount);
+}
+
+// Whether isActiveWindow and activateWindow use pipelined XCB requests:
+static juce::Atomic<bool> pipelinedRequests(true);
+
+/**
+ * @brief  Owns a reply structure allocated by XCB.
+ */
+template <typename ReplyType>
+using XcbReply = std::unique_ptr<ReplyType, decltype(&std::free)>;
+
+/**
+ * @brief  Waits for the reply to an XCB request, discarding any error.
+ *
+ * @param xcb            The XCB connection used to send the request.
+ *
+ * @param cookie         The cookie returned when the request was sent.
+ *
+ * @param replyFunction  The XCB function used to collect the reply.
+ *
+ * @return               The request's reply, or a null reply if the request
+ *                       failed.
+ */
+template <typename ReplyType, typename CookieType>
+static XcbReply<ReplyType> getXcbReply(xcb_connection_t* xcb,
+        const CookieType cookie, ReplyType* (*replyFunction)
+        (xcb_connection_t*, CookieType, xcb_generic_error_t**))
+{
+    xcb_generic_error_t* error = nullptr;
+    ReplyType* reply = replyFunction(xcb, cookie, &error);
+    std::free(error);
+    return XcbReply<ReplyType>(reply, std::free);
+}
+
+/**
+ * @brief  Reads the first 32-bit value from an XCB window property reply.
+ *
+ * @param reply  A property reply, which may be null.
+ *
+ * @return       The property value, or -1 if the reply held no 32-bit data.
+ */
+static long getXcbPropertyValue(const xcb_get_property_reply_t* reply)
+{
+    if (reply == nullptr || reply->format != 32
+            || xcb_get_property_value_length(reply) == 0)
+    {
+        return -1;
+    }
+    return (long) *static_cast<const uint32_t*>(xcb_get_property_value(
+                reply));
+}
+
+// Mirrors the window tree when enabled:
+static std::unique_ptr<Windows::TreeMirror> treeMirror;
+// Protects the tree mirror pointer:
+static juce::CriticalSection treeMirrorLock;
+
+/**
+ * @brief  Runs an action using the window tree mirror, if it is enabled.
+ *
+ * @param action  An action to run with the tree mirror.
+ *
+ * @return        Whether the tree mirror was enabled and the action returned
+ *                true.
+ */
+static bool useTreeMirror
+(const std::function<bool(Windows::TreeMirror&)> action)
+{
+    const juce::ScopedLock mirrorLock(treeMirrorLock);
+    return treeMirror != nullptr && action(*treeMirror);
+}
+
+// Holds a display connection, its interned atoms, and its cached set of
+// supported window manager properties.
+struct Windows::XInterface::Connection
+{
+    /**
+     * @brief  Opens the connection, interns all property atoms, and starts
+     *         listening for root window property changes.
+     *
+     * @param displayName  The name of the display to open, or nullptr to open
+     *                     the default display.
+     */
+    Connection(const char* displayName) : display(XOpenDisplay(displayName))
+    {
+        countRoundTrip();
+        if (display == nullptr)
+        {
+            DBG(dbgPrefix << __func__ << ": Failed to open X display!");
+            return;
+        }
+        atoms = internAtoms(display);
+        // Property change events show when the supported property list needs
+        // to be reloaded:
+        XSelectInput(display, XDefaultRootWindow(display),
+                PropertyChangeMask);
+    }
+
+    /**
+     * @brief  Closes the connection.
+     */
+    ~Connection()
+    {
+        if (display != nullptr)
+        {
+            XCloseDisplay(display);
+            display = nullptr;
+        }
+    }
+
+    // The display connection:
+    Display* display = nullptr;
+    // Window property atoms interned on the connection:
+    juce::Array<Atom> atoms;
+    // All properties supported by the window manager:
+    std::unordered_set<Atom> supportedProperties;
+    // Whether supportedProperties holds the current supported property list:
+    bool supportedCached = false;
+    // Protects the supported property cache:
+    juce::CriticalSection cacheLock;
+};
+
 // Holds any type of XLib window property data.
 struct Windows::XInterface::WindowProperty
 {
@@ -135,19 +310,80 @@ struct Windows::XInterface::WindowProperty
     }
 };
 
-// Opens a connection to the X11 display manager on construction.
+// Connects to the X11 display manager on construction.
 Windows::XInterface::XInterface(const char* displayName) :
-display(XOpenDisplay(displayName)) { }
+connection((displayName == nullptr) ? getSharedConnection()
+        : std::make_shared<Connection>(displayName)),
+display(connection->display),
+atoms(connection->atoms) { }
+
+
+// Releases this object's display connection.
+Windows::XInterface::~XInterface() { }
+
+
+// Gets the connection shared by all XInterface objects that use the default
+// display, opening it if necessary.
+std::shared_ptr<Windows::XInterface::Connection>
+Windows::XInterface::getSharedConnection()
+{
+    // JUCE initializes Xlib thread support before opening its own display
+    // connection, so the shared connection is safe to use from any thread.
+    static std::shared_ptr<Connection> sharedConnection
+            = std::make_shared<Connection>(nullptr);
+    return sharedConnection;
+}
+
+
+// Gets the number of requests made by all XInterface objects that had to wait
+// for a reply from the X server.
+int Windows::XInterface::getRoundTripCount()
+{
+    return roundTripCount.get();
+}
 
 
-// Closes the connection to the X11 display manager.
-Windows::XInterface::~XInterface()
+// Sets whether window tree queries made through the shared connection should
+// be answered using a Windows::TreeMirror.
+void Windows::XInterface::setTreeMirrorEnabled(const bool useMirror)
 {
-    if (display != nullptr)
+    const juce::ScopedLock mirrorLock(treeMirrorLock);
+    if (! useMirror)
     {
-        XCloseDisplay(display);
-        display = nullptr;
+        treeMirror.reset(nullptr);
     }
+    else if (treeMirror == nullptr)
+    {
+        treeMirror.reset(new TreeMirror);
+        if (! treeMirror->isValid())
+        {
+            treeMirror.reset(nullptr);
+        }
+    }
+}
+
+
+// Checks if window tree queries are answered using a Windows::TreeMirror.
+bool Windows::XInterface::isTreeMirrorEnabled()
+{
+    const juce::ScopedLock mirrorLock(treeMirrorLock);
+    return treeMirror != nullptr;
+}
+
+
+// Sets whether isActiveWindow and activateWindow should use XCB to send
+// independent requests together, or make each request separately through Xlib.
+void Windows::XInterface::setPipelinedRequests(const bool usePipelining)
+{
+    pipelinedRequests = usePipelining;
+}
+
+
+// Checks if isActiveWindow and activateWindow are using XCB request
+// pipelining.
+bool Windows::XInterface::usingPipelinedRequests()
+{
+    return pipelinedRequests.get();
 }
 
 
@@ -173,9 +409,9 @@ Window Windows::XInterface::getMainAppWindow() const
 // Gets the XLib window ID that represents the active window.
 Window Windows::XInterface::getActiveWindow() const
 {
-    const Atom request = XInternAtom(display, activeWindowProperty, false);
     const Window root = XDefaultRootWindow(display);
-    WindowProperty windowProp = getWindowProperty(root, request);
+    WindowProperty windowProp = getWindowProperty(root,
+            atoms[activeWindowAtom]);
     if (windowProp.numItems == 0)
     {
         return BadWindow;
@@ -190,6 +426,7 @@ juce::String Windows::XInterface::getWindowName(const Window window) const
     XTextProperty textProp;
     char** nameList = nullptr;
     XGetWMName(display, window, &textProp);
+    countRoundTrip();
     juce::String name;
     if (textProp.nitems > 0)
     {
@@ -220,6 +457,7 @@ juce::String Windows::XInterface::getWindowName(const Window window) const
 juce::String Windows::XInterface::getWindowClass(const Window window) const
 {
     XClassHint classHint;
+    countRoundTrip();
     if (!XGetClassHint(display, window, &classHint))
     {
         return juce::String();
@@ -235,6 +473,7 @@ juce::String Windows::XInterface::getWindowClass(const Window window) const
 juce::String Windows::XInterface::getWindowClassName(const Window window) const
 {
     XClassHint classHint;
+    countRoundTrip();
     if (!XGetClassHint(display, window, &classHint))
     {
         return juce::String();
@@ -249,8 +488,8 @@ juce::String Windows::XInterface::getWindowClassName(const Window window) const
 // Gets the ID of the process that created a window.
 int Windows::XInterface::getWindowPID(const Window window) const
 {
-    Atom pidAtom = XInternAtom(display, windowProcessProperty, false);
-    WindowProperty pidProp = getWindowProperty(window, pidAtom);
+    WindowProperty pidProp = getWindowProperty(window,
+            atoms[windowProcessAtom]);
     if (pidProp.numItems == 0 || pidProp.size == 0 || pidProp.data == nullptr)
     {
         return -1;
@@ -314,12 +553,21 @@ juce::Array<Window> Windows::XInterface::getWindowChildren
 (const Window parent) const
 {
     juce::Array<Window> children;
+    if (connection == getSharedConnection() && useTreeMirror(
+                [parent, &children](TreeMirror& mirror)
+                {
+                    return mirror.getChildren(parent, children);
+                }))
+    {
+        return children;
+    }
     unsigned int numChildren = 0;
     Window* childWindows = nullptr;
     Window unneededReturnVal;
     Status success = XQueryTree(display, parent,
             &unneededReturnVal, &unneededReturnVal,
             &childWindows, &numChildren);
+    countRoundTrip();
     if (success && numChildren > 0)
     {
         for (int i = 0; i < numChildren; i++)
@@ -340,6 +588,27 @@ juce::Array<Window> Windows::XInterface::getWindowChildren
 // order.
 juce::Array<Window> Windows::XInterface::getWindowAncestry
 (const Window window) const
+{
+    juce::Array<Window> ancestry;
+    Window ancestor = window;
+    while (ancestor != 0)
+    {
+        Window parent = 0;
+        if (! queryParent(ancestor, parent))
+        {
+            // The window or one of its ancestors is invalid:
+            return juce::Array<Window>();
+        }
+        ancestry.insert(0, ancestor);
+        ancestor = parent;
+    }
+    return ancestry;
+}
+
+
+// Finds all direct ancestors of a window by searching the entire window tree.
+juce::Array<Window> Windows::XInterface::searchWindowAncestry
+(const Window window) const
 {
     juce::Array<Window> ancestry;
     const int screenCount = ScreenCount(display);
@@ -373,23 +642,47 @@ juce::Array<Window> Windows::XInterface::getWindowSiblings
 // Finds the parent of a window.
 Window Windows::XInterface::getWindowParent(const Window window) const
 {
-    juce::Array<Window> parents = getWindowAncestry(window);
-    if (parents.size() < 2)
-    {
-        return 0;
-    }
-    return parents[parents.size() - 2];
+    Window parent = 0;
+    queryParent(window, parent);
+    return parent;
 }
 
 
 // Checks if a specific window is active.
 bool Windows::XInterface::isActiveWindow(const Window window) const
+{
+    if (pipelinedRequests.get())
+    {
+        return isActiveWindowXcb(window);
+    }
+    return isActiveWindowXlib(window);
+}
+
+
+// Activates a window.
+void Windows::XInterface::activateWindow(const Window window) const
+{
+    if (pipelinedRequests.get())
+    {
+        activateWindowXcb(window);
+    }
+    else
+    {
+        activateWindowXlib(window);
+    }
+}
+
+
+// Checks if a window is active, making each X server request separately
+// through Xlib.
+bool Windows::XInterface::isActiveWindowXlib(const Window window) const
 {
     DBG(dbgPrefix << __func__ << ": Checking if window "
             << getWindowName(window) << " is focused:");
     using juce::Array;
     XWindowAttributes attr;
     int foundAttributes = XGetWindowAttributes(display, window, &attr);
+    countRoundTrip();
     if (foundAttributes == 0)
     {
         DBG(dbgPrefix << __func__ << ": No, failed to get window attributes.");
@@ -412,10 +705,10 @@ bool Windows::XInterface::isActiveWindow(const Window window) const
                 << ": No, the window is on the wrong desktop.");
         return false;
     }
-    jassert(xPropertySupported(activeWindowProperty));
-    const Atom request = XInternAtom(display, activeWindowProperty, false);
+    jassert(xPropertySupported(atoms[activeWindowAtom]));
     const Window root = XDefaultRootWindow(display);
-    WindowProperty windowProp = getWindowProperty(root, request);
+    WindowProperty windowProp = getWindowProperty(root,
+            atoms[activeWindowAtom]);
     if (windowProp.numItems == 0)
     {
         DBG(dbgPrefix << __func__ << ": No, there is no focused window.");
@@ -464,14 +757,14 @@ bool Windows::XInterface::isActiveWindow(const Window window) const
 }
 
 
-// Activates a window.
-void Windows::XInterface::activateWindow(const Window window) const
+// Activates a window, making each X server request separately through Xlib.
+void Windows::XInterface::activateWindowXlib(const Window window) const
 {
     DBG(dbgPrefix << __func__ << ": activating window:");
-    jassert(xPropertySupported(activeWindowProperty));
+    jassert(xPropertySupported(atoms[activeWindowAtom]));
     // Switch to the window's desktop if necessary:
-    if (xPropertySupported(currentDesktopProperty)
-        && xPropertySupported(windowDesktopProperty))
+    if (xPropertySupported(atoms[currentDesktopAtom])
+        && xPropertySupported(atoms[windowDesktopAtom]))
     {
         setDesktopIndex(getWindowDesktop(window));
     }
@@ -490,6 +783,7 @@ void Windows::XInterface::activateWindow(const Window window) const
         // prevent us from moving windows.
         XWindowAttributes winAttr;
         XGetWindowAttributes(display, window, &winAttr);
+        countRoundTrip();
         if (!winAttr.override_redirect)
         {
             XSetWindowAttributes newAttrs;
@@ -501,6 +795,7 @@ void Windows::XInterface::activateWindow(const Window window) const
         }
         XRaiseWindow(display, window);
         XSync(display, false);
+        countRoundTrip();
         XFlush(display);
         if (!winAttr.override_redirect)
         {
@@ -518,14 +813,14 @@ void Windows::XInterface::activateWindow(const Window window) const
     xEvent.type = ClientMessage;
     xEvent.xclient.display = display;
     xEvent.xclient.window = window;
-    xEvent.xclient.message_type
-            = XInternAtom(display, activeWindowProperty, false);
+    xEvent.xclient.message_type = atoms[activeWindowAtom];
     xEvent.xclient.format = 32;
     xEvent.xclient.data.l[0] = 2L; // 2 == Message from a window pager
     xEvent.xclient.data.l[1] = CurrentTime;
 
     XWindowAttributes winAttr;
     XGetWindowAttributes(display, window, &winAttr);
+    countRoundTrip();
     int result = XSendEvent(display, winAttr.screen->root, false,
             SubstructureNotifyMask | SubstructureRedirectMask,
             &xEvent);
@@ -541,20 +836,224 @@ void Windows::XInterface::activateWindow(const Window window) const
                 << ": Got bad value error when requesting input focus.");
     }
     XSync(display, false);
+    countRoundTrip();
     XFlush(display);
 }
 
 
+// Checks if a window is active, sending independent X server requests together
+// through XCB.
+bool Windows::XInterface::isActiveWindowXcb(const Window window) const
+{
+    DBG(dbgPrefix << __func__ << ": Checking if window " << (int) window
+            << " is focused:");
+    jassert(xPropertySupported(atoms[activeWindowAtom]));
+    const bool desktopsSupported
+            = xPropertySupported(atoms[currentDesktopAtom]);
+    const bool windowDesktopSupported
+            = xPropertySupported(atoms[windowDesktopAtom]);
+    xcb_connection_t* xcb = XGetXCBConnection(display);
+    const xcb_window_t root = XDefaultRootWindow(display);
+
+    // Send every request that doesn't depend on another reply:
+    const xcb_get_window_attributes_cookie_t attrCookie
+            = xcb_get_window_attributes(xcb, window);
+    const xcb_get_geometry_cookie_t geometryCookie
+            = xcb_get_geometry(xcb, window);
+    const xcb_get_property_cookie_t desktopCookie = xcb_get_property(xcb,
+            false, root, atoms[currentDesktopAtom], XCB_ATOM_ANY, 0, 1);
+    const xcb_get_property_cookie_t windowDesktopCookie = xcb_get_property(xcb,
+            false, window, atoms[windowDesktopAtom], XCB_ATOM_ANY, 0, 1);
+    const xcb_get_property_cookie_t activeCookie = xcb_get_property(xcb,
+            false, root, atoms[activeWindowAtom], XCB_ATOM_ANY, 0, 1);
+    const xcb_query_tree_cookie_t treeCookie = xcb_query_tree(xcb, window);
+
+    // Collect all replies, so none are left waiting in the reply queue:
+    const XcbReply<xcb_get_window_attributes_reply_t> attributes
+            = getXcbReply(xcb, attrCookie, xcb_get_window_attributes_reply);
+    const XcbReply<xcb_get_geometry_reply_t> geometry
+            = getXcbReply(xcb, geometryCookie, xcb_get_geometry_reply);
+    const XcbReply<xcb_get_property_reply_t> desktopProp
+            = getXcbReply(xcb, desktopCookie, xcb_get_property_reply);
+    const XcbReply<xcb_get_property_reply_t> windowDesktopProp
+            = getXcbReply(xcb, windowDesktopCookie, xcb_get_property_reply);
+    const XcbReply<xcb_get_property_reply_t> activeProp
+            = getXcbReply(xcb, activeCookie, xcb_get_property_reply);
+    const XcbReply<xcb_query_tree_reply_t> tree
+            = getXcbReply(xcb, treeCookie, xcb_query_tree_reply);
+    countRoundTrip();
+
+    if (attributes == nullptr || geometry == nullptr)
+    {
+        DBG(dbgPrefix << __func__ << ": No, failed to get window attributes.");
+        return false;
+    }
+    if (attributes->map_state != XCB_MAP_STATE_VIEWABLE)
+    {
+        DBG(dbgPrefix << __func__
+                << ": No, window is not mapped or viewable.");
+        return false;
+    }
+    if (geometry->width == 0 || geometry->height == 0)
+    {
+        DBG(dbgPrefix << __func__ << ": No, the window has zero area.");
+        return false;
+    }
+    const int desktopIndex = desktopsSupported
+            ? (int) getXcbPropertyValue(desktopProp.get()) : -1;
+    const int windowDesktop = windowDesktopSupported
+            ? (int) getXcbPropertyValue(windowDesktopProp.get()) : -1;
+    if (desktopIndex != windowDesktop)
+    {
+        DBG(dbgPrefix << __func__
+                << ": No, the window is on the wrong desktop.");
+        return false;
+    }
+    if (activeProp == nullptr
+            || xcb_get_property_value_length(activeProp.get()) == 0)
+    {
+        DBG(dbgPrefix << __func__ << ": No, there is no focused window.");
+        return false;
+    }
+    const Window activeWindow = (Window) getXcbPropertyValue(activeProp.get());
+    if (window != activeWindow)
+    {
+        DBG(dbgPrefix << __func__ << ": No, window " << (int) activeWindow
+                << " is focused.");
+        return false;
+    }
+
+    // Only the stacking check depends on an earlier reply:
+    if (tree != nullptr && tree->parent != XCB_NONE)
+    {
+        const juce::Array<Window> siblings = getWindowChildren(tree->parent);
+        const int windowIndex = siblings.indexOf(window);
+        if (windowIndex == -1)
+        {
+            DBG(dbgPrefix << __func__ << ": Error: window " << (int) window
+                    << " not found in child windows of "
+                    << (int) tree->parent);
+            jassertfalse;
+        }
+        else if (windowIndex != siblings.size() - 1)
+        {
+            DBG(dbgPrefix << __func__ << ": No, "
+                    << (siblings.size() - 1 - windowIndex)
+                    << " window(s) are above this window");
+            return false;
+        }
+    }
+    DBG(dbgPrefix << __func__ << ": Yes, this window is focused");
+    return true;
+}
+
+
+// Activates a window, sending independent X server requests together through
+// XCB.
+void Windows::XInterface::activateWindowXcb(const Window window) const
+{
+    DBG(dbgPrefix << __func__ << ": activating window:");
+    jassert(xPropertySupported(atoms[activeWindowAtom]));
+    xcb_connection_t* xcb = XGetXCBConnection(display);
+    const bool switchDesktops = xPropertySupported(atoms[currentDesktopAtom])
+        && xPropertySupported(atoms[windowDesktopAtom]);
+    xcb_get_property_cookie_t desktopCookie = { 0 };
+    if (switchDesktops)
+    {
+        desktopCookie = xcb_get_property(xcb, false, window,
+                atoms[windowDesktopAtom], XCB_ATOM_ANY, 0, 1);
+    }
+
+    // Each ancestor depends on the last, so ancestry can't be pipelined:
+    const juce::Array<Window> ancestors = getWindowAncestry(window);
+    jassert(!ancestors.isEmpty() && ancestors.getLast() == window);
+    if (switchDesktops)
+    {
+        const XcbReply<xcb_get_property_reply_t> desktopProp
+                = getXcbReply(xcb, desktopCookie, xcb_get_property_reply);
+        setDesktopIndex((int) getXcbPropertyValue(desktopProp.get()));
+    }
+    if (ancestors.isEmpty())
+    {
+        return;
+    }
+
+    // Request attributes and sibling lists for every non-root ancestor at
+    // once:
+    juce::Array<xcb_get_window_attributes_cookie_t> attrCookies;
+    juce::Array<xcb_query_tree_cookie_t> siblingCookies;
+    for (int i = 1; i < ancestors.size(); i++)
+    {
+        attrCookies.add(xcb_get_window_attributes(xcb, ancestors[i]));
+        siblingCookies.add(xcb_query_tree(xcb, ancestors[i - 1]));
+    }
+    const uint32_t overrideRedirect = 1;
+    const uint32_t noOverrideRedirect = 0;
+    const uint32_t stackAbove = XCB_STACK_MODE_ABOVE;
+    for (int i = 1; i < ancestors.size(); i++)
+    {
+        const XcbReply<xcb_get_window_attributes_reply_t> attributes
+                = getXcbReply(xcb, attrCookies[i - 1],
+                        xcb_get_window_attributes_reply);
+        const XcbReply<xcb_query_tree_reply_t> siblings
+                = getXcbReply(xcb, siblingCookies[i - 1],
+                        xcb_query_tree_reply);
+        if (attributes == nullptr || siblings == nullptr
+                || siblings->children_len < 2)
+        {
+            continue;
+        }
+        // Ensure override_redirect is enabled, or the window manager will
+        // prevent us from moving windows.
+        const xcb_window_t ancestor = ancestors[i];
+        if (! attributes->override_redirect)
+        {
+            xcb_change_window_attributes(xcb, ancestor,
+                    XCB_CW_OVERRIDE_REDIRECT, &overrideRedirect);
+        }
+        xcb_configure_window(xcb, ancestor, XCB_CONFIG_WINDOW_STACK_MODE,
+                &stackAbove);
+        if (! attributes->override_redirect)
+        {
+            xcb_change_window_attributes(xcb, ancestor,
+                    XCB_CW_OVERRIDE_REDIRECT, &noOverrideRedirect);
+        }
+    }
+    if (ancestors.size() > 1)
+    {
+        countRoundTrip();
+    }
+
+    // Request input focus for the newly raised window:
+    xcb_client_message_event_t message;
+    memset(&message, 0, sizeof(message));
+    message.response_type = XCB_CLIENT_MESSAGE;
+    message.format = 32;
+    message.window = window;
+    message.type = atoms[activeWindowAtom];
+    message.data.data32[0] = 2; // 2 == Message from a window pager
+    message.data.data32[1] = XCB_CURRENT_TIME;
+    xcb_send_event(xcb, false, ancestors.getFirst(),
+            XCB_EVENT_MASK_SUBSTRUCTURE_NOTIFY
+            | XCB_EVENT_MASK_SUBSTRUCTURE_REDIRECT,
+            reinterpret_cast<const char*>(&message));
+
+    // Wait once for the server to handle every request:
+    getXcbReply(xcb, xcb_get_input_focus(xcb), xcb_get_input_focus_reply);
+    countRoundTrip();
+}
+
+
 // Finds the current selected desktop index.
 int Windows::XInterface::getDesktopIndex() const
 {
-    if (!xPropertySupported(currentDesktopProperty))
+    if (!xPropertySupported(atoms[currentDesktopAtom]))
     {
         return -1;
     }
-    Atom request = XInternAtom(display, currentDesktopProperty, false);
     Window rootWindow = XDefaultRootWindow(display);
-    WindowProperty desktopProp = getWindowProperty(rootWindow, request);
+    WindowProperty desktopProp = getWindowProperty(rootWindow,
+            atoms[currentDesktopAtom]);
     if (desktopProp.numItems == 0 || desktopProp.size == 0
             || desktopProp.data == nullptr)
     {
@@ -567,7 +1066,7 @@ int Windows::XInterface::getDesktopIndex() const
 // Sets the current active desktop index.
 void Windows::XInterface::setDesktopIndex(const int desktopIndex) const
 {
-    if (!xPropertySupported(currentDesktopProperty))
+    if (!xPropertySupported(atoms[currentDesktopAtom]))
     {
         return;
     }
@@ -578,8 +1077,7 @@ void Windows::XInterface::setDesktopIndex(const int desktopIndex) const
     xEvent.type = ClientMessage;
     xEvent.xclient.display = display;
     xEvent.xclient.window = rootWindow;
-    xEvent.xclient.message_type
-            = XInternAtom(display, currentDesktopProperty, false);
+    xEvent.xclient.message_type = atoms[currentDesktopAtom];
     XSendEvent(display, rootWindow, false,
             SubstructureNotifyMask | SubstructureRedirectMask,
             &xEvent);
@@ -589,12 +1087,12 @@ void Windows::XInterface::setDesktopIndex(const int desktopIndex) const
 // Gets the index of the desktop that contains a specific window.
 int Windows::XInterface::getWindowDesktop(const Window window) const
 {
-    if (!xPropertySupported(windowDesktopProperty))
+    if (!xPropertySupported(atoms[windowDesktopAtom]))
     {
         return -1;
     }
-    Atom request = XInternAtom(display, windowDesktopProperty, false);
-    WindowProperty desktopProp = getWindowProperty(window, request);
+    WindowProperty desktopProp = getWindowProperty(window,
+            atoms[windowDesktopAtom]);
     if (desktopProp.numItems == 0 || desktopProp.size == 0
             || desktopProp.data == nullptr)
     {
@@ -603,6 +1101,53 @@ int Windows::XInterface::getWindowDesktop(const Window window) const
     return (int) desktopProp.getDataValue<long>();
 }
 
+
+// Sends a synthetic key press and key release event directly to a window,
+// without changing window focus.
+bool Windows::XInterface::sendKeyEvent(const Window window,
+        const KeySym keySym, const unsigned int modifierMask) const
+{
+    const KeyCode keycode = XKeysymToKeycode(display, keySym);
+    if (keycode == 0)
+    {
+        DBG(dbgPrefix << __func__ << ": No keycode for KeySym "
+                << juce::String::toHexString((juce::int64) keySym));
+        return false;
+    }
+    unsigned int state = modifierMask;
+    // Select the shifted level of the key if that's where the KeySym is found:
+    if (XkbKeycodeToKeysym(display, keycode, 0, 0) != keySym
+            && XkbKeycodeToKeysym(display, keycode, 0, 1) == keySym)
+    {
+        state |= ShiftMask;
+    }
+
+    XEvent xEvent;
+    memset(&xEvent, 0, sizeof(xEvent));
+    XKeyEvent& keyEvent = xEvent.xkey;
+    keyEvent.display = display;
+    keyEvent.window = window;
+    keyEvent.root = XDefaultRootWindow(display);
+    keyEvent.subwindow = None;
+    keyEvent.time = CurrentTime;
+    keyEvent.x = 1;
+    keyEvent.y = 1;
+    keyEvent.x_root = 1;
+    keyEvent.y_root = 1;
+    keyEvent.same_screen = True;
+    keyEvent.keycode = keycode;
+    keyEvent.state = state;
+
+    keyEvent.type = KeyPress;
+    Status pressSent = XSendEvent(display, window, True, KeyPressMask,
+            &xEvent);
+    keyEvent.type = KeyRelease;
+    Status releaseSent = XSendEvent(display, window, True, KeyReleaseMask,
+            &xEvent);
+    XFlush(display);
+    return pressSent != 0 && releaseSent != 0;
+}
+
 #if JUCE_DEBUG
 // Prints comprehensive debug information about a window.
 void Windows::XInterface::printWindowInfo(const Window window) const
@@ -623,6 +1168,7 @@ void Windows::XInterface::printWindowInfo(const Window window) const
 
     XWindowAttributes attr;
     int foundAttributes = XGetWindowAttributes(display, window, &attr);
+    countRoundTrip();
     if (foundAttributes == 0)
     {
         std::cout << "\tUnable to read window attributes\n";
@@ -704,6 +1250,37 @@ juce::Array<Window> Windows::XInterface::recursiveWindowSearch
 }
 
 
+// Gets the parent of a window from the window tree mirror, or directly from the
+// X server if the mirror isn't in use.
+bool Windows::XInterface::queryParent(const Window window, Window& parent) const
+{
+    if (connection == getSharedConnection() && useTreeMirror(
+                [window, &parent](TreeMirror& mirror)
+                {
+                    return mirror.getParent(window, parent);
+                }))
+    {
+        return true;
+    }
+    Window root = 0;
+    Window* children = nullptr;
+    unsigned int numChildren = 0;
+    const Status success = XQueryTree(display, window, &root, &parent,
+            &children, &numChildren);
+    countRoundTrip();
+    if (children != nullptr)
+    {
+        XFree(children);
+    }
+    if (! success)
+    {
+        parent = 0;
+        return false;
+    }
+    return true;
+}
+
+
 // Gets an arbitrary window property.
 Windows::XInterface::WindowProperty Windows::XInterface::getWindowProperty
 (const Window window, const Atom property) const
@@ -713,6 +1290,7 @@ Windows::XInterface::WindowProperty Windows::XInterface::getWindowProperty
     int status = XGetWindowProperty(display, window, property, 0, (~0L), false,
             AnyPropertyType, &propertyData.type, &propertyData.size,
             &propertyData.numItems, &bytesAfter, &propertyData.data);
+    countRoundTrip();
     if (status != Success)
     {
         if (status == BadWindow)
@@ -730,25 +1308,34 @@ Windows::XInterface::WindowProperty Windows::XInterface::getWindowProperty
 
 
 // Checks if a particular property is supported by the window manager.
-bool Windows::XInterface::xPropertySupported(const char* property) const
+bool Windows::XInterface::xPropertySupported(const Atom property) const
 {
-    Window rootWindow = XDefaultRootWindow(display);
-    Atom featureList = XInternAtom(display, supportedFeatureProperty, false);
-    WindowProperty supportedPropertyList
-            = getWindowProperty(rootWindow, featureList);
-    if (supportedPropertyList.data == nullptr
-        || supportedPropertyList.numItems == 0)
+    const juce::ScopedLock cacheLock(connection->cacheLock);
+    const Window rootWindow = XDefaultRootWindow(display);
+    // Check queued root property changes without waiting on the server:
+    XEvent event;
+    while (XCheckTypedWindowEvent(display, rootWindow, PropertyNotify, &event))
     {
-        return false;
+        if (event.xproperty.atom == atoms[supportedFeatureAtom])
+        {
+            connection->supportedCached = false;
+        }
     }
-    Atom* propertyList = reinterpret_cast<Atom*>(supportedPropertyList.data);
-    Atom neededProp = XInternAtom(display, property, false);
-    for (long i = 0; i < supportedPropertyList.numItems; i++)
+    if (! connection->supportedCached)
     {
-        if (propertyList[i] == neededProp)
+        connection->supportedProperties.clear();
+        WindowProperty supportedPropertyList
+                = getWindowProperty(rootWindow, atoms[supportedFeatureAtom]);
+        if (supportedPropertyList.data != nullptr)
         {
-            return true;
+            const Atom* propertyList
+                    = reinterpret_cast<Atom*>(supportedPropertyList.data);
+            for (unsigned long i = 0; i < supportedPropertyList.numItems; i++)
+            {
+                connection->supportedProperties.insert(propertyList[i]);
+            }
         }
+        connection->supportedCached = true;
     }
-    return false;
+    return connection->supportedProperties.count(property) > 0;
 }
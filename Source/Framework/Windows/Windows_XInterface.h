@@ -10,6 +10,7 @@ namespace Windows { class XInterface; }
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include "JuceHeader.h"
+#include <memory>
 
 /**
  * @brief  Interacts with the X Window System to find and manipulate windows.
@@ -18,6 +19,13 @@ namespace Windows { class XInterface; }
  * process ID. Once found, it can focus these windows, and raise them above
  * other windows on the display.
  *
+ *  Unless a specific display name is requested, all XInterface objects share a
+ * single X display connection that stays open until the application exits.
+ * The window property atoms used by the XInterface are requested from the X
+ * server once per connection. The list of properties supported by the window
+ * manager is also cached for each connection, and only reloaded when the root
+ * window reports that the list changed.
+ *
  *  Most of the code in this module was adapted from xdotool, an extremely
  * useful utility for manipulating windows and automatically triggering mouse
  * and keyboard events.
@@ -28,19 +36,75 @@ class Windows::XInterface
 {
 public:
     /**
-     * @brief  Opens a connection to the X11 display manager on construction.
+     * @brief  Connects to the X11 display manager on construction.
      *
      * @param displayName  The name of the display to access. If null, the
-     *                     default display set by the $DISPLAY environment
-     *                     variable will be used.
+     *                     shared connection to the default display set by the
+     *                     $DISPLAY environment variable will be used.
+     *                     Otherwise, a new connection is opened.
      */
     XInterface(const char* displayName = nullptr);
 
     /**
-     * @brief  Closes the connection to the X11 display manager.
+     * @brief  Releases this object's display connection.
+     *
+     *  Connections opened for a specific display are closed once no
+     * XInterface is using them. The shared connection stays open until the
+     * application exits.
      */
     virtual ~XInterface();
 
+    /**
+     * @brief  Gets the number of requests made by all XInterface objects that
+     *         had to wait for a reply from the X server.
+     *
+     *  Comparing this value before and after an operation shows how many round
+     * trips to the X server the operation needed.
+     *
+     * @return  The total number of X server round trips made so far.
+     */
+    static int getRoundTripCount();
+
+    /**
+     * @brief  Sets whether window tree queries made through the shared
+     *         connection should be answered using a Windows::TreeMirror.
+     *
+     *  When enabled, getWindowChildren, getWindowParent, and all functions
+     * using them read the window tree from a local copy kept up to date by
+     * window tree events, instead of asking the X server.
+     *
+     * @param useMirror  Whether the window tree mirror should be used.
+     */
+    static void setTreeMirrorEnabled(const bool useMirror);
+
+    /**
+     * @brief  Checks if window tree queries are answered using a
+     *         Windows::TreeMirror.
+     *
+     * @return  Whether the window tree mirror is in use.
+     */
+    static bool isTreeMirrorEnabled();
+
+    /**
+     * @brief  Sets whether isActiveWindow and activateWindow should use XCB
+     *         to send independent requests together, or make each request
+     *         separately through Xlib.
+     *
+     *  Both request paths give the same results. The Xlib path is only kept
+     * for comparison, so pipelined requests are enabled by default.
+     *
+     * @param usePipelining  Whether XCB request pipelining should be used.
+     */
+    static void setPipelinedRequests(const bool usePipelining);
+
+    /**
+     * @brief  Checks if isActiveWindow and activateWindow are using XCB
+     *         request pipelining.
+     *
+     * @return  Whether pipelined requests are enabled.
+     */
+    static bool usingPipelinedRequests();
+
     /**
      * @brief  Gets the XLib window ID that represents this application's main
      *         window.
@@ -137,6 +201,9 @@ public:
      * @brief  Finds all direct ancestors of a window and returns them in
      *         parent->child order.
      *
+     *  Ancestors are found by following each window's parent link, so this
+     * needs one round trip to the X server for each ancestor.
+     *
      * @param window  A valid XLib window identifier.
      *
      * @return        An array of windows, where the first value is the root
@@ -146,6 +213,21 @@ public:
      */
     juce::Array<Window> getWindowAncestry(const Window window) const;
 
+    /**
+     * @brief  Finds all direct ancestors of a window by searching the entire
+     *         window tree.
+     *
+     *  This returns the same result as getWindowAncestry, but needs a round
+     * trip to the X server for each window searched instead of each ancestor.
+     * It is only kept to check and compare against getWindowAncestry.
+     *
+     * @param window  A valid XLib window identifier.
+     *
+     * @return        The window's ancestry in parent->child order, or an empty
+     *                array if the window wasn't found.
+     */
+    juce::Array<Window> searchWindowAncestry(const Window window) const;
+
     /**
      * @brief  Gets all siblings of a window and returns the list sorted from
      *         bottom to top.
@@ -170,6 +252,10 @@ public:
     /**
      * @brief  Checks if a specific window is active.
      *
+     *  When pipelined requests are enabled, all window attribute, property,
+     * and window tree requests are sent before waiting for any replies, so the
+     * check needs about two round trips to the X server instead of a dozen.
+     *
      * @param window  An XLib window identifier.
      *
      * @return        Whether the window exists, has nonzero size, is on the
@@ -184,6 +270,10 @@ public:
      *  This will switch the active desktop to the one containing this window,
      * bring the window to the front, and set it as the focused window.
      *
+     *  When pipelined requests are enabled, every ancestor window is raised
+     * before waiting for the X server to finish, instead of waiting once for
+     * each ancestor.
+     *
      * @param window   The XLib ID of the window to activate.
      */
     void activateWindow(const Window window) const;
@@ -218,6 +308,28 @@ public:
      */
     int getWindowDesktop(const Window window) const;
 
+    /**
+     * @brief  Sends a synthetic key press and key release event directly to a
+     *         window, without changing window focus.
+     *
+     *  Applications may choose to ignore synthetic key events, so this should
+     * only be used with windows known to accept them.
+     *
+     * @param window        The XLib ID of the window that will receive the
+     *                      key events.
+     *
+     * @param keySym        The X11 KeySym of the key to send.
+     *
+     * @param modifierMask  X11 modifier state flags(e.g. ShiftMask,
+     *                      ControlMask) to apply to the key events.
+     *
+     * @return              Whether the key events were sent. This returns
+     *                      false if the KeySym has no keycode in the current
+     *                      keyboard mapping, or if the window is invalid.
+     */
+    bool sendKeyEvent(const Window window, const KeySym keySym,
+            const unsigned int modifierMask) const;
+
 #if JUCE_DEBUG
     /**
      * @brief  Prints comprehensive debug information about a window.
@@ -256,6 +368,55 @@ private:
     juce::Array<Window> recursiveWindowSearch
     (const juce::Array<Window>& parents, const Window searchWin) const;
 
+    /**
+     * @brief  Checks if a window is active, making each X server request
+     *         separately through Xlib.
+     *
+     * @param window  An XLib window identifier.
+     *
+     * @return        Whether the window is active.
+     */
+    bool isActiveWindowXlib(const Window window) const;
+
+    /**
+     * @brief  Checks if a window is active, sending independent X server
+     *         requests together through XCB.
+     *
+     * @param window  An XLib window identifier.
+     *
+     * @return        Whether the window is active.
+     */
+    bool isActiveWindowXcb(const Window window) const;
+
+    /**
+     * @brief  Activates a window, making each X server request separately
+     *         through Xlib.
+     *
+     * @param window  The XLib ID of the window to activate.
+     */
+    void activateWindowXlib(const Window window) const;
+
+    /**
+     * @brief  Activates a window, sending independent X server requests
+     *         together through XCB.
+     *
+     * @param window  The XLib ID of the window to activate.
+     */
+    void activateWindowXcb(const Window window) const;
+
+    /**
+     * @brief  Gets the parent of a window from the window tree mirror, or
+     *         directly from the X server if the mirror isn't in use.
+     *
+     * @param window  An XLib window identifier.
+     *
+     * @param parent  Set to the window's parent, or to zero if the window is
+     *                a root window or is invalid.
+     *
+     * @return        Whether the window was valid.
+     */
+    bool queryParent(const Window window, Window& parent) const;
+
     /**
      * @brief  Holds any type of XLib window property data.
      */
@@ -275,20 +436,38 @@ private:
     WindowProperty getWindowProperty
     (const Window window, const Atom property) const;
 
+    /**
+     * @brief  Holds a display connection, its interned atoms, and its cached
+     *         set of supported window manager properties.
+     */
+    struct Connection;
+
+    /**
+     * @brief  Gets the connection shared by all XInterface objects that use
+     *         the default display, opening it if necessary.
+     *
+     * @return  The shared connection object.
+     */
+    static std::shared_ptr<Connection> getSharedConnection();
+
     /**
      * @brief  Checks if a particular property type is supported by the window
      *         manager.
      *
-     * @param property  The name of a property set by the window manager or
-     *                  pager.
+     * @param property  The atom identifying a property set by the window
+     *                  manager or pager.
      *
      * @return          Whether this property is supported by the current
      *                  window manager or pager.
      */
-    bool xPropertySupported(const char* property) const;
+    bool xPropertySupported(const Atom property) const;
 
+    // The shared connection, or a connection owned by this object:
+    std::shared_ptr<Connection> connection;
     // XLib display pointer, used to connect to the X Window system.
     Display* display = nullptr;
+    // Window property atoms interned on the display connection:
+    const juce::Array<Atom>& atoms;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(XInterface)
 };
@@ -14,42 +14,124 @@ static const constexpr float maxCharSize = 0.8;
 static const constexpr int maxRows = 1;
 
 
-// Updates the array of character indices the InputView will draw.
+// Returns the size of the component outline, in pixels.
+static int getOutlineSize(const int height)
+{
+    return std::max<int>(height * outlineFraction, minimumOutline);
+}
+
+
+// Updates the array of character indices the InputView will draw, repainting
+// only the area where the drawn text changed.
 void Component::InputView::updateInputText
-(const juce::Array<unsigned int> updatedInput)
+(const Text::CharString& updatedInput, const Text::CharString& suggestion)
+{
+    const juce::Rectangle<int> textBounds = getTextBounds();
+    const int oldSize = inputText.size();
+    const int oldRightEdge = inputLayout.rightEdge;
+    const bool hadSuggestion = ! suggestionText.isEmpty();
+
+    const int firstChange = Text::Painter::updateLayout(inputLayout,
+            updatedInput, textBounds.getX(), textBounds.getY(),
+            textBounds.getWidth(), textBounds.getHeight(),
+            textBounds.getHeight() * maxCharSize);
+    const bool inputChanged = firstChange < oldSize
+            || firstChange < updatedInput.size();
+    if (inputChanged)
+    {
+        // Only replace the changed end of the cached input:
+        inputText.removeRange(firstChange, oldSize - firstChange);
+        inputText.addArray(updatedInput, firstChange);
+    }
+    const bool suggestionChanged = suggestion != suggestionText;
+    if (suggestionChanged)
+    {
+        suggestionText = suggestion;
+    }
+    if (! inputChanged && ! suggestionChanged)
+    {
+        return;
+    }
+    layoutSuggestion(textBounds);
+
+    // Repaint from the last unchanged input character to the end of the
+    // input highlight, or to the end of the text area if the suggestion moved
+    // or changed:
+    int dirtyLeft = std::min(oldRightEdge, inputLayout.rightEdge);
+    if (inputChanged)
+    {
+        dirtyLeft = (firstChange == 0) ? textBounds.getX()
+                : inputLayout.glyphs.getReference(firstChange - 1).x;
+    }
+    int dirtyRight = std::max(oldRightEdge, inputLayout.rightEdge);
+    if (hadSuggestion || ! suggestionText.isEmpty())
+    {
+        dirtyRight = textBounds.getRight();
+    }
+    if (dirtyRight > dirtyLeft)
+    {
+        repaint(dirtyLeft, textBounds.getY(), dirtyRight - dirtyLeft,
+                textBounds.getHeight());
+    }
+}
+
+
+// Lays out all text again to fit the new component bounds.
+void Component::InputView::resized()
 {
-    inputText = updatedInput;
-    repaint();
+    const juce::Rectangle<int> textBounds = getTextBounds();
+    Text::Painter::layoutString(inputLayout, inputText, textBounds.getX(),
+            textBounds.getY(), textBounds.getWidth(), textBounds.getHeight(),
+            textBounds.getHeight() * maxCharSize);
+    layoutSuggestion(textBounds);
 }
 
 
 // Draws the buffered input text.
 void Component::InputView::paint(juce::Graphics& g)
 {
-    juce::Rectangle<int> bounds = getLocalBounds();
+    const juce::Rectangle<int> bounds = getLocalBounds();
 
     // draw background:
     g.setColour(findColour(background));
     g.fillRect(bounds);
 
     // draw outline:
-    const int outlineSize = std::max<int>(getHeight() * outlineFraction,
-            minimumOutline);
     g.setColour(findColour(outline));
-    g.drawRect(bounds, outlineSize);
-    bounds.reduce(outlineSize * 2, outlineSize * 2);
+    g.drawRect(bounds, getOutlineSize(getHeight()));
 
+    const juce::Rectangle<int> textBounds = getTextBounds();
     g.setColour(findColour(inputHighlight));
-    const int rightEdge = Text::Painter::paintString(g, inputText,
-            bounds.getX(), bounds.getY(),
-            bounds.getWidth(), bounds.getHeight(),
-            bounds.getHeight() * maxCharSize);
-    g.fillRect(bounds.getX(), bounds.getY(),
-            rightEdge - bounds.getX(), bounds.getHeight());
+    g.fillRect(textBounds.getX(), textBounds.getY(),
+            inputLayout.rightEdge - textBounds.getX(), textBounds.getHeight());
 
     g.setColour(findColour(text));
-    Text::Painter::paintString(g, inputText, bounds.getX(), bounds.getY(),
-            bounds.getWidth(), bounds.getHeight(),
-            bounds.getHeight() * maxCharSize);
+    Text::Painter::paintLayout(g, inputLayout);
+
+    // draw suggestion:
+    Text::Painter::paintLayout(g, suggestionLayout);
+}
 
+
+// Gets the area within the component's outline where text is drawn.
+juce::Rectangle<int> Component::InputView::getTextBounds() const
+{
+    const int outlineSize = getOutlineSize(getHeight());
+    return getLocalBounds().reduced(outlineSize * 2, outlineSize * 2);
+}
+
+
+// Lays out the suggestion text in the area after the input text.
+void Component::InputView::layoutSuggestion
+(const juce::Rectangle<int> textBounds)
+{
+    const int rightEdge = inputLayout.rightEdge;
+    if (suggestionText.isEmpty() || rightEdge >= textBounds.getRight())
+    {
+        suggestionLayout.glyphs.clearQuick();
+        return;
+    }
+    Text::Painter::layoutString(suggestionLayout, suggestionText, rightEdge,
+            textBounds.getY(), textBounds.getRight() - rightEdge,
+            textBounds.getHeight(), textBounds.getHeight() * maxCharSize);
 }
@@ -6,6 +6,7 @@
  */
 
 #include "Text_CharTypes.h"
+#include "Text_Painter.h"
 #include "JuceHeader.h"
 
 namespace Component { class InputView; }
@@ -19,6 +20,16 @@ namespace Component { class InputView; }
  * are sent immediately to the target window, InputView will instead show any
  * active modifiers, followed by "(Immediate input mode)", or the localized
  * equivalent.
+ *
+ *  A suggested completion for the last entered word may be drawn after the
+ * input text. Only the input text is highlighted, and the suggestion is drawn
+ * in the remaining space, so showing a suggestion never changes how the input
+ * text is drawn.
+ *
+ *  Input text layout is updated incrementally. When characters are appended
+ * or deleted, only the characters after the first changed character are
+ * measured again, and only the area from that character to the end of the
+ * drawn text is repainted.
  */
 class Component::InputView : public juce::Component
 {
@@ -42,13 +53,22 @@ public:
     };
 
     /**
-     * @brief  Updates the array of character indices the InputView will draw.
+     * @brief  Updates the array of character indices the InputView will draw,
+     *         repainting only the area where the drawn text changed.
      *
      * @param updatedInput  The buffered input text string.
+     *
+     * @param suggestion    Suggested characters to draw after the input text.
      */
-    void updateInputText(const Text::CharString updatedInput);
+    void updateInputText(const Text::CharString& updatedInput,
+            const Text::CharString& suggestion);
 
 private:
+    /**
+     * @brief  Lays out all text again to fit the new component bounds.
+     */
+    void resized() override;
+
     /**
      * @brief  Draws the buffered input text.
      *
@@ -56,6 +76,27 @@ private:
      */
     void paint(juce::Graphics& g) override;
 
+    /**
+     * @brief  Gets the area within the component's outline where text is
+     *         drawn.
+     *
+     * @return  The text area, in local coordinates.
+     */
+    juce::Rectangle<int> getTextBounds() const;
+
+    /**
+     * @brief  Lays out the suggestion text in the area after the input text.
+     *
+     * @param textBounds  The area where all text is drawn.
+     */
+    void layoutSuggestion(const juce::Rectangle<int> textBounds);
+
     // Cached input text:
     Text::CharString inputText;
+    // Cached suggested characters, drawn after the input text:
+    Text::CharString suggestionText;
+    // Measured input text, shared by the input highlight and the drawn text:
+    Text::Painter::StringLayout inputLayout;
+    // Measured suggestion text:
+    Text::Painter::StringLayout suggestionLayout;
 };
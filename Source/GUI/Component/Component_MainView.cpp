@@ -45,7 +45,8 @@ Component::MainView::MainView()
 void Component::MainView::updateChordState(
         const Text::CharSet::Cache* activeSet,
         const Input::Chord heldChord,
-        const Text::CharString input)
+        const Text::CharString& input,
+        const Text::CharString& suggestion)
 {
     KeyGrid* keyGrids [] =
     {
@@ -58,7 +59,7 @@ void Component::MainView::updateChordState(
         keyGrid->updateCharacterSet(activeSet);
         keyGrid->updateChordState(heldChord);
     }
-    inputView.updateInputText(input);
+    inputView.updateInputText(input, suggestion);
     resized();
 }
 
@@ -88,6 +89,12 @@ bool Component::MainView::isHelpScreenShowing() const
 // Update child component bounds if the component changes size.
 void Component::MainView::resized()
 {
+    // Cached characters were rendered at scales chosen for the old size:
+    if (getLocalBounds() != glyphCacheBounds)
+    {
+        Text::Painter::clearGlyphCache();
+        glyphCacheBounds = getLocalBounds();
+    }
     helpScreen.setBounds(getLocalBounds());
     const Text::CharSet::Cache& charSet = charsetConfig.getActiveSet();
 
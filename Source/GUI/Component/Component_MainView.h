@@ -49,10 +49,13 @@ public:
      * @param heldChord       The current held Chord value.
      *
      * @param input           The current cached character index list.
+     *
+     * @param suggestion      Suggested characters to show after the input.
      */
     void updateChordState(const Text::CharSet::Cache* activeSet,
             const Input::Chord heldChord,
-            const Text::CharString input);
+            const Text::CharString& input,
+            const Text::CharString& suggestion);
 
     /**
      * @brief  Shows the help screen if it's not currently visible, or hides it
@@ -94,6 +97,9 @@ private:
     // Displays help info when enabled:
     HelpScreen helpScreen;
 
+    // Component bounds when the Text::Painter glyph cache was last cleared:
+    juce::Rectangle<int> glyphCacheBounds;
+
     // Keep config data loaded:
     Input::Key::ConfigFile inputConfig;
     Text::CharSet::ConfigFile charsetConfig;
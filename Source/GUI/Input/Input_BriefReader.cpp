@@ -0,0 +1,247 @@
+#include "Input_BriefReader.h"
+#include "Text_WordTrie.h"
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Input::BriefReader::";
+#endif
+
+// Number of bits used to store each chord in a sequence key:
+static const constexpr int chordBits = 5;
+// Separates chords in a dictionary line:
+static const constexpr juce::juce_wchar chordSeparator = '/';
+// Starts a comment line in the dictionary:
+static const constexpr juce::juce_wchar commentChar = '#';
+// Table value for sequences that only begin other briefs:
+static const constexpr int prefixOnly = -1;
+
+
+// Loads all briefs from a dictionary file.
+Input::BriefReader::BriefReader(const juce::File& dictionaryFile)
+{
+    if (! dictionaryFile.existsAsFile())
+    {
+        return;
+    }
+    juce::StringArray lines;
+    dictionaryFile.readLines(lines);
+    for (const juce::String& line : lines)
+    {
+        if (line.trim().isEmpty() || line.trim()[0] == commentChar)
+        {
+            continue;
+        }
+        if (! addBrief(line))
+        {
+            DBG(dbgPrefix << __func__ << ": Skipping invalid brief \""
+                    << line << "\"");
+        }
+    }
+    DBG(dbgPrefix << __func__ << ": Loaded " << expansions.size()
+            << " briefs from " << dictionaryFile.getFullPathName());
+}
+
+
+// Checks if any briefs were loaded.
+bool Input::BriefReader::isEnabled() const
+{
+    return ! expansions.isEmpty();
+}
+
+
+// Gets the number of loaded briefs.
+int Input::BriefReader::getBriefCount() const
+{
+    return expansions.size();
+}
+
+
+// Records the chord used to type the next character added to the output
+// buffer.
+void Input::BriefReader::chordEntered(const Chord chord)
+{
+    pendingChord = chord;
+}
+
+
+// Sets whether the current word may match a brief using the end of a text
+// string.
+void Input::BriefReader::readText(const Text::CharString& text)
+{
+    if (text.isEmpty() || ! isWordCharacter(text.getLast()))
+    {
+        startWord();
+    }
+    else
+    {
+        cancelWord();
+    }
+}
+
+
+// Checks if a character is part of a word, rather than a word separator.
+bool Input::BriefReader::isWordCharacter(const Text::CharValue charValue)
+{
+    return (charValue >= '0' && charValue <= '9')
+            || Text::WordTrie::getWordCharacter(charValue) != 0;
+}
+
+
+// Extends the current chord sequence when a chord adds a word character, or
+// starts a new word after a separator.
+void Input::BriefReader::characterAppended(const Text::CharValue outputChar)
+{
+    const Chord chord = pendingChord;
+    pendingChord = Chord();
+    if (! isWordCharacter(outputChar))
+    {
+        startWord();
+        return;
+    }
+    if (! matching)
+    {
+        return;
+    }
+    if (! chord.isValid() || wordLength >= maxBriefLength)
+    {
+        cancelWord();
+        return;
+    }
+    currentSequence = extendSequence(currentSequence, chord);
+    wordLength++;
+    if (briefTable.count(currentSequence) == 0)
+    {
+        cancelWord();
+    }
+}
+
+
+// Cancels brief matching when the current word is edited.
+void Input::BriefReader::lastCharDeleted(const Text::CharString& bufferedText)
+{
+    cancelWord();
+}
+
+
+// Starts a new word when the buffer is cleared.
+void Input::BriefReader::bufferCleared()
+{
+    startWord();
+}
+
+
+// Starts a new, empty chord sequence.
+void Input::BriefReader::startWord()
+{
+    currentSequence = 0;
+    wordLength = 0;
+    matching = true;
+}
+
+
+// Stops matching briefs until the next word begins.
+void Input::BriefReader::cancelWord()
+{
+    currentSequence = 0;
+    wordLength = 0;
+    matching = false;
+}
+
+
+// Gets the text that should replace the current word, if its chords form a
+// complete brief.
+const Text::CharString* Input::BriefReader::getExpansion() const
+{
+    if (! matching || wordLength == 0)
+    {
+        return nullptr;
+    }
+    const auto brief = briefTable.find(currentSequence);
+    if (brief == briefTable.end() || brief->second == prefixOnly)
+    {
+        return nullptr;
+    }
+    return &expansions.getReference(brief->second);
+}
+
+
+// Gets the number of chords entered within the current word.
+int Input::BriefReader::getWordLength() const
+{
+    return wordLength;
+}
+
+
+// Gets the key identifying a chord sequence extended by one chord.
+Input::BriefReader::SequenceKey Input::BriefReader::extendSequence
+(const SequenceKey sequence, const Chord chord)
+{
+    // Valid chords are never zero, so sequences of different lengths never
+    // share a key:
+    return (sequence << chordBits) | chord.getByteValue();
+}
+
+
+// Reads a single brief from a dictionary line, adding it and all of its
+// prefixes to the brief table.
+bool Input::BriefReader::addBrief(const juce::String& line)
+{
+    const juce::String trimmedLine = line.trim();
+    const juce::String chordText
+            = trimmedLine.initialSectionNotContaining(" \t");
+    const juce::String briefText
+            = trimmedLine.substring(chordText.length()).trim();
+    const juce::StringArray chordStrings = juce::StringArray::fromTokens(
+            chordText, juce::String::charToString(chordSeparator), "");
+    if (briefText.isEmpty() || chordStrings.isEmpty()
+            || chordStrings.size() > maxBriefLength)
+    {
+        return false;
+    }
+
+    juce::Array<SequenceKey> prefixes;
+    SequenceKey sequence = 0;
+    for (const juce::String& chordString : chordStrings)
+    {
+        Chord::uint8 chordBitmap = 0;
+        for (int i = 0; i < chordString.length(); i++)
+        {
+            const int keyNumber = chordString[i] - '0';
+            if (keyNumber < 1 || keyNumber > Chord::numChordKeys())
+            {
+                return false;
+            }
+            chordBitmap |= (Chord::uint8) (1 << (keyNumber - 1));
+        }
+        if (chordBitmap == 0)
+        {
+            return false;
+        }
+        prefixes.add(sequence);
+        sequence = extendSequence(sequence, Chord(chordBitmap));
+    }
+
+    Text::CharString expansion;
+    for (int i = 0; i < briefText.length(); i++)
+    {
+        expansion.add((Text::CharValue) briefText[i]);
+    }
+    // Later lines replace earlier briefs with the same chords:
+    const auto existing = briefTable.find(sequence);
+    if (existing != briefTable.end() && existing->second != prefixOnly)
+    {
+        expansions.getReference(existing->second) = expansion;
+    }
+    else
+    {
+        briefTable[sequence] = expansions.size();
+        expansions.add(expansion);
+    }
+    // Mark every prefix except the empty sequence, without replacing briefs
+    // that end there:
+    for (int i = 1; i < prefixes.size(); i++)
+    {
+        briefTable.emplace(prefixes[i], prefixOnly);
+    }
+    return true;
+}
@@ -0,0 +1,192 @@
+#pragma once
+/**
+ * @file  Input_BriefReader.h
+ *
+ * @brief  Expands sequences of chords into whole words, using a dictionary of
+ *         briefs.
+ */
+
+#include "Input_Chord.h"
+#include "Output_Buffer.h"
+#include "Text_CharTypes.h"
+#include "JuceHeader.h"
+#include <unordered_map>
+
+namespace Input { class BriefReader; }
+
+/**
+ * @brief  Loads a dictionary of briefs, and follows the chords used to type
+ *         each word to find when they match a brief.
+ *
+ *  A brief is a short sequence of chords that stands for a longer word or
+ * string, like the briefs used by stenographers. Briefs are loaded from a
+ * dictionary file where each line holds one brief, written as a sequence of
+ * chords followed by the text it expands to. Each chord lists its chord key
+ * numbers from one to five, and chords are separated by slashes:
+ *
+ *     1/24     the
+ *     13/5/2   because
+ *
+ *  Chords in a brief still type their normal characters as they're entered.
+ * BriefReader listens to the Output::Buffer, and only tracks whether the
+ * chords that typed the current word form the beginning of any brief. Once a
+ * word separator is entered, the word may be replaced with the brief's text if
+ * its chords form a complete brief. This resolves conflicts between briefs and
+ * normal text in favor of the brief, while still letting words that start the
+ * same way as a brief be typed normally. Deleting characters, or adding
+ * characters without chords, cancels brief matching until the next word, so
+ * normal text can always be entered.
+ *
+ *  Every brief and the beginning of every brief are stored in a single hash
+ * table, keyed by the chord sequence. Each new chord only needs one lookup to
+ * check if the sequence still matches a brief.
+ */
+class Input::BriefReader : public Output::Buffer::Listener
+{
+public:
+    // Maximum number of chords in a single brief:
+    static const constexpr int maxBriefLength = 12;
+
+    /**
+     * @brief  Loads all briefs from a dictionary file.
+     *
+     * @param dictionaryFile  The brief dictionary file. If the file doesn't
+     *                        exist, no briefs will be loaded.
+     */
+    BriefReader(const juce::File& dictionaryFile);
+
+    virtual ~BriefReader() { }
+
+    /**
+     * @brief  Checks if any briefs were loaded.
+     *
+     * @return  Whether the dictionary contains at least one brief.
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief  Gets the number of loaded briefs.
+     *
+     * @return  The number of valid briefs in the dictionary.
+     */
+    int getBriefCount() const;
+
+    /**
+     * @brief  Records the chord used to type the next character added to the
+     *         output buffer.
+     *
+     * @param chord  The entered chord.
+     */
+    void chordEntered(const Chord chord);
+
+    /**
+     * @brief  Sets whether the current word may match a brief using the end
+     *         of a text string, usually the entire contents of an
+     *         Output::Buffer.
+     *
+     * @param text  The text containing the current word.
+     */
+    void readText(const Text::CharString& text);
+
+    /**
+     * @brief  Gets the text that should replace the current word, if its
+     *         chords form a complete brief.
+     *
+     * @return  The brief's text, or nullptr if the current word doesn't match
+     *          a complete brief.
+     */
+    const Text::CharString* getExpansion() const;
+
+    /**
+     * @brief  Gets the number of chords entered within the current word.
+     *
+     * @return  The number of characters that will be replaced when the
+     *          current word's brief is expanded.
+     */
+    int getWordLength() const;
+
+    /**
+     * @brief  Checks if a character is part of a word, rather than a word
+     *         separator.
+     *
+     * @param charValue  An ISO 8859 character code, or a replacement value
+     *                   defined in Text::Values.
+     *
+     * @return           Whether the character is a letter, number, or
+     *                   apostrophe.
+     */
+    static bool isWordCharacter(const Text::CharValue charValue);
+
+private:
+    /**
+     * @brief  Extends the current chord sequence when a chord adds a word
+     *         character, or starts a new word after a separator.
+     *
+     * @param outputChar  The added character.
+     */
+    void characterAppended(const Text::CharValue outputChar) override;
+
+    /**
+     * @brief  Cancels brief matching when the current word is edited.
+     *
+     * @param bufferedText  The remaining buffered text.
+     */
+    void lastCharDeleted(const Text::CharString& bufferedText) override;
+
+    /**
+     * @brief  Starts a new word when the buffer is cleared.
+     */
+    void bufferCleared() override;
+
+    /**
+     * @brief  Starts a new, empty chord sequence.
+     */
+    void startWord();
+
+    /**
+     * @brief  Stops matching briefs until the next word begins.
+     */
+    void cancelWord();
+
+    // Identifies a chord sequence, storing five bits for each chord:
+    typedef juce::uint64 SequenceKey;
+
+    /**
+     * @brief  Gets the key identifying a chord sequence extended by one
+     *         chord.
+     *
+     * @param sequence  The key of the original sequence.
+     *
+     * @param chord     The chord added to the end of the sequence.
+     *
+     * @return          The extended sequence key.
+     */
+    static SequenceKey extendSequence(const SequenceKey sequence,
+            const Chord chord);
+
+    /**
+     * @brief  Reads a single brief from a dictionary line, adding it and all
+     *         of its prefixes to the brief table.
+     *
+     * @param line  A line from the brief dictionary.
+     *
+     * @return      Whether the line contained a valid brief.
+     */
+    bool addBrief(const juce::String& line);
+
+    // Maps each brief and each brief prefix to the index of its text in
+    // expansions, or -1 if no brief ends with that sequence:
+    std::unordered_map<SequenceKey, int> briefTable;
+    // Text for each brief:
+    juce::Array<Text::CharString> expansions;
+    // Key of the chord sequence entered in the current word:
+    SequenceKey currentSequence = 0;
+    // Number of chords entered in the current word:
+    int wordLength = 0;
+    // Whether the current word may still match a brief:
+    bool matching = true;
+    // The chord used to type the next buffered character, if known:
+    Chord pendingChord;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BriefReader)
+};
@@ -1,24 +1,66 @@
 #include "Input_ChordReader.h"
-#include "Input_Key_JSONKeys.h"
-#include <map>
-
-
-// Milliseconds to wait between key releases before assuming the user isn't
-// releasing keys to enter a chord value, and is instead changing the selected
-// chord:
-static const constexpr int keyReleaseChordUpdateDelay = 300;
+#include "Input_RawKeySource.h"
+#include "Input_SessionRecorder.h"
 
 
 // Create the ChordReader, assigning it to listen to key events from a
 // component.
 Input::ChordReader::ChordReader(juce::Component* keyComponent) :
+    releaseTiming(mainConfig.getChordReleaseDelay(),
+            mainConfig.getAdaptiveReleaseDelay()),
+    chordState(releaseTiming, mainConfig.getChordRollover()),
+    keyComponent(keyComponent),
     releaseTimer(*this)
 {
-    for (const auto* chordKey : Key::JSONKeys::chordKeys)
+    keyComponent->addKeyListener(this);
+    const juce::String sessionPath = mainConfig.getChordSessionFile();
+    if (sessionPath.isNotEmpty())
     {
-        chordKeys.add(keyConfig.getBoundKey(*chordKey));
+        sessionRecorder.reset(new SessionRecorder(
+                juce::File::getCurrentWorkingDirectory().getChildFile(
+                    sessionPath)));
+    }
+    if (mainConfig.getRawKeyInput())
+    {
+        juce::WeakReference<ChordReader> weakThis(this);
+        rawKeySource.reset(new RawKeySource([weakThis]
+                (const int keyCode, const bool isPressed,
+                 const juce::uint32 serverTime)
+        {
+            juce::MessageManager::callAsync(
+                    [weakThis, keyCode, isPressed, serverTime]()
+            {
+                ChordReader* chordReader = weakThis.get();
+                // Only start chords while the key component is focused, but
+                // always accept releases so held keys can't get stuck:
+                if (chordReader != nullptr && (! isPressed
+                        || chordReader->keyComponent->hasKeyboardFocus(true)))
+                {
+                    chordReader->rawKeyEvent(keyCode, isPressed, serverTime);
+                }
+            });
+        }));
+        if (! rawKeySource->isReading())
+        {
+            DBG("Input::ChordReader::" << __func__ << ": Raw key input is "
+                    << "unavailable, using JUCE key events instead.");
+            rawKeySource.reset(nullptr);
+        }
+    }
+}
+
+
+// Stops reading raw key events, if they were being used, and saves any
+// changes to the chord release delay.
+Input::ChordReader::~ChordReader()
+{
+    rawKeySource.reset(nullptr);
+    masterReference.clear();
+    if (releaseTiming.isAdaptive() && releaseTiming.getReleaseDelay()
+            != mainConfig.getChordReleaseDelay())
+    {
+        mainConfig.setChordReleaseDelay(releaseTiming.getReleaseDelay());
     }
-    keyComponent->addKeyListener(this);
 }
 
 
@@ -58,21 +100,15 @@ void Input::ChordReader::sendSelectionUpdate()
 bool Input::ChordReader::keyPressed
 (const juce::KeyPress& key, juce::Component* source)
 {
-    juce::String keyText = key.getTextDescription();
-
-    // Check for new chord key presses:
-    for (int i = 0; i < Chord::numChordKeys(); i++)
+    const int keyIndex = chordTable.getKeyIndex(key);
+    if (keyIndex >= 0)
     {
-        if (chordKeys[i] == key)
+        // When reading raw key events, chord keys are only consumed here:
+        if (rawKeySource == nullptr)
         {
-            heldChord = heldChord.withKeyHeld(i);
-            if (heldChord != selectedChord)
-            {
-                selectedChord = heldChord;
-                sendSelectionUpdate();
-            }
-            return true;
+            chordKeyPressed(keyIndex, juce::Time::getMillisecondCounter());
         }
+        return true;
     }
 
     // Pass any unprocessed key events on to listeners:
@@ -95,52 +131,35 @@ static inline juce::KeyPress getKey(const juce::String& description)
 bool Input::ChordReader::keyStateChanged
 (bool isKeyDown, juce::Component* source)
 {
-    using juce::String;
     if (isKeyDown)
     {
         return false;
     }
-
-    // Check for released chord keys:
-    Chord updatedChord = heldChord;
-    for (int i = 0; i < Chord::numChordKeys(); i++)
+    if (rawKeySource != nullptr)
     {
-        if (heldChord.usesChordKey(i))
+        for (Listener* listener : listeners)
         {
-            const juce::KeyPress& heldKey = chordKeys[i];
-            if (! heldKey.isCurrentlyDown())
-            {
-                updatedChord = updatedChord.withKeyReleased(i);
-            }
+            listener->keyReleased();
         }
+        return true;
     }
 
-    // Save updates to chord keys, only updating the selection if a reasonable
-    // amount of time passes between key release events:
-    if (updatedChord != heldChord)
+    // JUCE key state events don't identify the released key, so check the
+    // bound key code of each held chord key:
+    const Chord::uint8 heldKeys = chordState.getHeldKeys();
+    const juce::uint32 releaseTime = juce::Time::getMillisecondCounter();
+    bool chordKeyReleased = false;
+    for (int i = 0; (heldKeys >> i) != 0; i++)
     {
-        // Stop the release timer if it was previously running:
-        releaseTimer.stopTimer();
-
-        heldChord = updatedChord;
-        // If all keys are released, send the selected chord to registered
-        // listeners and reset the selection:
-        if (! heldChord.isValid())
-        {
-            DBG("Entered chord " << selectedChord.toString());
-            for (Listener* listener : listeners)
-            {
-                listener->chordEntered(selectedChord);
-            }
-            selectedChord = Chord();
-        }
-        // Otherwise, start the timer and let it update the selection.
-        else
+        if (((heldKeys >> i) & 1) != 0 && ! juce::KeyPress::isKeyCurrentlyDown(
+                    chordTable.getKeyCode(i)))
         {
-            releaseTimer.startTimer(keyReleaseChordUpdateDelay);
+            chordKeyReleased = true;
+            releaseChordKey(i, releaseTime);
         }
     }
-    else
+
+    if (! chordKeyReleased)
     {
         for (Listener* listener : listeners)
         {
@@ -151,22 +170,118 @@ bool Input::ChordReader::keyStateChanged
 }
 
 
+// Updates chord state using a key event read directly from the X server.
+void Input::ChordReader::rawKeyEvent
+(const int keyCode, const bool isPressed, const juce::uint32 serverTime)
+{
+    const int keyIndex = chordTable.getKeyIndex(keyCode);
+    if (keyIndex < 0)
+    {
+        return;
+    }
+    if (isPressed)
+    {
+        chordKeyPressed(keyIndex, serverTime);
+    }
+    else
+    {
+        releaseChordKey(keyIndex, serverTime);
+    }
+}
+
+
+// Updates the selected chord when a chord key is pressed.
+void Input::ChordReader::chordKeyPressed
+(const int keyIndex, const juce::uint32 eventTime)
+{
+    if (sessionRecorder != nullptr)
+    {
+        sessionRecorder->keyEvent(keyIndex, true, eventTime);
+    }
+    releaseTimer.stopTimer();
+    const Chord enteredChord = chordState.keyPressed(keyIndex, eventTime);
+    // In rollover mode, pressing a new key may enter the previous chord:
+    if (enteredChord.isValid())
+    {
+        enterChord(enteredChord);
+    }
+    setSelectedChord(chordState.getSelectedChord());
+}
+
+
+// Updates the selected chord when a chord key is released, entering the
+// selected chord if no chord keys remain held.
+void Input::ChordReader::releaseChordKey
+(const int keyIndex, const juce::uint32 eventTime)
+{
+    if (! chordState.isKeyHeld(keyIndex))
+    {
+        return;
+    }
+    if (sessionRecorder != nullptr)
+    {
+        sessionRecorder->keyEvent(keyIndex, false, eventTime);
+    }
+
+    // Stop the release timer if it was previously running:
+    releaseTimer.stopTimer();
+
+    const Chord enteredChord = chordState.keyReleased(keyIndex, eventTime);
+    // If all keys are released, send the entered chord to registered
+    // listeners and reset the selection:
+    if (enteredChord.isValid())
+    {
+        enterChord(enteredChord);
+        selectedChord = Chord();
+    }
+    // Otherwise, start the timer so the selection preview updates if the user
+    // pauses before releasing more keys. The chord state still decides which
+    // chord is entered, using key event times:
+    else
+    {
+        setSelectedChord(chordState.getSelectedChord());
+        releaseTimer.startTimer(releaseTiming.getReleaseDelay());
+    }
+}
+
+
+// Sends an entered chord to all registered listeners.
+void Input::ChordReader::enterChord(const Chord enteredChord)
+{
+    DBG("Entered chord " << enteredChord.toString());
+    if (sessionRecorder != nullptr)
+    {
+        sessionRecorder->chordEntered(enteredChord);
+    }
+    for (Listener* listener : listeners)
+    {
+        listener->chordEntered(enteredChord);
+    }
+}
+
+
+// Updates the selected chord, notifying listeners if it changed.
+void Input::ChordReader::setSelectedChord(const Chord newSelection)
+{
+    if (newSelection != selectedChord)
+    {
+        selectedChord = newSelection;
+        sendSelectionUpdate();
+    }
+}
+
+
 // Connects the timer to its chordReader on construction.
 Input::ChordReader::ReleaseTimer::ReleaseTimer(ChordReader& chordReader) :
         chordReader(chordReader) { }
 
 
-// Updates the ChordReader's selected chord and passes the update on to all
-// listeners if the delay period finishes without the user releasing all keys to
-// enter the chord.
+// Shows the held chord as the selected chord if the delay period finishes
+// without the user releasing more keys.
 void Input::ChordReader::ReleaseTimer::timerCallback()
 {
     DBG("Chord release timer finished");
     const juce::MessageManagerLock mmLock;
-    if (chordReader.heldChord != chordReader.selectedChord)
-    {
-        chordReader.selectedChord = chordReader.heldChord;
-        chordReader.sendSelectionUpdate();
-    }
+    chordReader.setSelectedChord(chordReader.chordState.getHeldChord());
     stopTimer();
 }
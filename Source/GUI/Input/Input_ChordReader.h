@@ -8,10 +8,19 @@
 #include "JuceHeader.h"
 #include "Input_Chord.h"
 #include "Input_Key_ConfigFile.h"
+#include "Input_Key_ChordTable.h"
+#include "Input_ChordState.h"
+#include "Input_ReleaseTiming.h"
+#include "Config_MainFile.h"
 #include "Text_CharSet_Cache.h"
 #include "Text_CharSet_ConfigFile.h"
 
-namespace Input { class ChordReader; }
+namespace Input
+{
+    class ChordReader;
+    class RawKeySource;
+    class SessionRecorder;
+}
 
 /**
  * @brief  Listens to keyboard input, reading and interpreting input to the
@@ -21,6 +30,17 @@ namespace Input { class ChordReader; }
  * objects update appropriately when the list of held keys changes, and forwards
  * information to Listener objects whenever the keys change or a chord is
  * entered.
+ *
+ *  If raw key input is enabled in the main configuration file and the X server
+ * supports XInput2, chord key events are read through an Input::RawKeySource
+ * instead of JUCE key events. Chords are then selected using the X server's
+ * event timestamps, so message thread delays can't change which chord is
+ * entered.
+ *
+ *  The delay between chord key releases that separates entering a chord from
+ * changing the selected chord is set by an Input::ReleaseTiming model. When
+ * the model is adaptive, its updated release delay is saved to the main
+ * configuration file when the ChordReader is destroyed.
  */
 class Input::ChordReader : public juce::KeyListener
 {
@@ -34,7 +54,11 @@ public:
      */
     ChordReader(juce::Component* keyComponent);
 
-    virtual ~ChordReader() { }
+    /**
+     * @brief  Stops reading raw key events, if they were being used, and
+     *         saves any changes to the chord release delay.
+     */
+    virtual ~ChordReader();
 
     /**
      * @brief  Gets the current Chord that will be used if all keys are
@@ -50,6 +74,22 @@ public:
      */
     Chord getSelectedChord() const;
 
+    /**
+     * @brief  Updates chord state using a key event read directly from the X
+     *         server.
+     *
+     *  Events for keys that aren't chord keys are ignored. This must be called
+     * on the message thread, with events in the order the X server sent them.
+     *
+     * @param keyCode     The JUCE key code of the pressed or released key.
+     *
+     * @param isPressed   True for key presses, false for key releases.
+     *
+     * @param serverTime  The X server timestamp of the event, in milliseconds.
+     */
+    void rawKeyEvent(const int keyCode, const bool isPressed,
+            const juce::uint32 serverTime);
+
     /**
      * @brief  Receives notifications when the selected chord state changes.
      */
@@ -142,14 +182,59 @@ private:
      */
     bool keyStateChanged(bool isKeyDown, juce::Component* source) override;
 
-    // Object tracking which keys are held down:
-    Chord heldChord = 0;
+    /**
+     * @brief  Updates the selected chord when a chord key is pressed.
+     *
+     * @param keyIndex   The index of the pressed chord key.
+     *
+     * @param eventTime  The time of the key press, in milliseconds.
+     */
+    void chordKeyPressed(const int keyIndex, const juce::uint32 eventTime);
+
+    /**
+     * @brief  Updates the selected chord when a chord key is released,
+     *         entering the selected chord if no chord keys remain held.
+     *
+     * @param keyIndex   The index of the released chord key.
+     *
+     * @param eventTime  The time of the key release, in milliseconds.
+     */
+    void releaseChordKey(const int keyIndex, const juce::uint32 eventTime);
+
+    /**
+     * @brief  Sends an entered chord to all registered listeners.
+     *
+     * @param enteredChord  The chord that was entered.
+     */
+    void enterChord(const Chord enteredChord);
 
-    // Object tracking the active key selection:
+    /**
+     * @brief  Updates the selected chord, notifying listeners if it changed.
+     *
+     * @param newSelection  The new selected chord.
+     */
+    void setSelectedChord(const Chord newSelection);
+
+    // Loads chord timing options:
+    Config::MainFile mainConfig;
+    // Sets how far apart chord key releases may be when entering a chord:
+    ReleaseTiming releaseTiming;
+    // Tracks held chord keys, and decides which chord is entered:
+    ChordState chordState;
+
+    // The selected chord shown to listeners:
     Chord selectedChord = 0;
 
-    // The list of chord Keys, in order:
-    juce::Array<juce::KeyPress> chordKeys;
+    // Records chord key timing, if a session file is configured:
+    std::unique_ptr<SessionRecorder> sessionRecorder;
+
+    // The component providing JUCE key events:
+    juce::Component* keyComponent;
+    // Reads raw key events, if raw key input is enabled and available:
+    std::unique_ptr<RawKeySource> rawKeySource;
+
+    // Maps key codes to chord key indices:
+    Key::ChordTable chordTable;
     // All registered listeners:
     juce::Array<Listener*> listeners;
 
@@ -178,13 +263,14 @@ private:
 
     private:
         /**
-         * @brief  Updates the ChordReader's selected chord and passes the
-         *         update on to all listeners if the delay period finishes
-         *         without the user releasing all keys to enter the chord.
+         * @brief  Shows the held chord as the selected chord if the delay
+         *         period finishes without the user releasing more keys.
          */
         void timerCallback() override;
 
         ChordReader& chordReader;
     };
     ReleaseTimer releaseTimer;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE(ChordReader)
 };
@@ -0,0 +1,136 @@
+#include "Input_ChordState.h"
+#include "Input_ReleaseTiming.h"
+
+
+// Creates the state machine with no chord keys held.
+Input::ChordState::ChordState
+(ReleaseTiming& releaseTiming, const bool rolloverMode) :
+    releaseTiming(releaseTiming),
+    rolloverMode(rolloverMode) { }
+
+
+// Updates the state when a chord key is pressed.
+Input::Chord Input::ChordState::keyPressed
+(const int keyIndex, const juce::uint32 eventTime)
+{
+    if (isKeyHeld(keyIndex))
+    {
+        return Chord();
+    }
+    Chord enteredChord;
+    // Roll over into a new chord if a key outside the selected chord is
+    // pressed while the selected chord is being released:
+    if (rolloverMode && releasePending)
+    {
+        // A long enough pause since the last release selects the keys held
+        // since then, just as it would if another key was released:
+        const juce::uint32 pressGap = eventTime - lastReleaseTime;
+        if (pressGap >= (juce::uint32) releaseTiming.getReleaseDelay())
+        {
+            selectedChord = heldChord;
+            releaseGaps.clearQuick();
+        }
+        if (! selectedChord.usesChordKey(keyIndex))
+        {
+            staleKeys |= heldChord.getByteValue();
+            heldChord = Chord();
+            enteredChord = enterSelectedChord();
+        }
+    }
+    heldChord = heldChord.withKeyHeld(keyIndex);
+    selectedChord = heldChord;
+    releasePending = false;
+    releaseGaps.clearQuick();
+    return enteredChord;
+}
+
+
+// Updates the state when a chord key is released.
+Input::Chord Input::ChordState::keyReleased
+(const int keyIndex, const juce::uint32 eventTime)
+{
+    const Chord::uint8 keyBit = (Chord::uint8) (1 << keyIndex);
+    if ((staleKeys & keyBit) != 0)
+    {
+        // Keys from an entered chord don't affect the new chord:
+        staleKeys &= ~ keyBit;
+        return Chord();
+    }
+    if (! heldChord.usesChordKey(keyIndex))
+    {
+        return Chord();
+    }
+
+    // After a long enough pause since the last release, the keys held since
+    // then become the selected chord:
+    if (releasePending)
+    {
+        const juce::uint32 releaseGap = eventTime - lastReleaseTime;
+        if (releaseGap >= (juce::uint32) releaseTiming.getReleaseDelay())
+        {
+            selectedChord = heldChord;
+            releaseGaps.clearQuick();
+        }
+        else
+        {
+            releaseGaps.add(releaseGap);
+        }
+    }
+    releasePending = true;
+    lastReleaseTime = eventTime;
+    heldChord = heldChord.withKeyReleased(keyIndex);
+    if (heldChord.isValid())
+    {
+        return Chord();
+    }
+
+    // All keys are released, enter the selected chord:
+    return enterSelectedChord();
+}
+
+
+// Gets the set of chord keys that are currently held down.
+Input::Chord Input::ChordState::getHeldChord() const
+{
+    return heldChord;
+}
+
+
+// Checks if a chord key is held down, including keys left over from a chord
+// that was already entered in rollover mode.
+bool Input::ChordState::isKeyHeld(const int keyIndex) const
+{
+    return ((getHeldKeys() >> keyIndex) & 1) != 0;
+}
+
+
+// Gets all chord keys that are held down, including keys left over from a
+// chord that was already entered in rollover mode.
+Input::Chord::uint8 Input::ChordState::getHeldKeys() const
+{
+    return heldChord.getByteValue() | staleKeys;
+}
+
+
+// Gets the chord that will be entered if all held keys are released without
+// pausing.
+Input::Chord Input::ChordState::getSelectedChord() const
+{
+    return selectedChord;
+}
+
+
+// Enters the selected chord, recording its release gaps in the timing model
+// and clearing the selection.
+Input::Chord Input::ChordState::enterSelectedChord()
+{
+    const Chord enteredChord = selectedChord;
+    for (const juce::uint32& releaseGap : releaseGaps)
+    {
+        releaseTiming.addReleaseGap(releaseGap);
+    }
+    releaseGaps.clearQuick();
+    selectedChord = Chord();
+    releasePending = false;
+    return enteredChord;
+}
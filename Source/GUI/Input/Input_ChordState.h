@@ -0,0 +1,144 @@
+#pragma once
+/**
+ * @file  Input_ChordState.h
+ *
+ * @brief  Decides which chord is entered from a timed series of chord key
+ *         presses and releases.
+ */
+
+#include "JuceHeader.h"
+#include "Input_Chord.h"
+
+namespace Input
+{
+    class ChordState;
+    class ReleaseTiming;
+}
+
+/**
+ * @brief  A state machine that tracks held chord keys, and selects the chord
+ *         to enter using the time of each key event.
+ *
+ *  Pressing a chord key always selects the full set of held keys. Releasing
+ * chord keys one at a time keeps that selection, as long as each release
+ * follows the last one within the ReleaseTiming's release delay. After a
+ * longer pause, the keys that were still held down become the selected chord.
+ * When the last chord key is released, the selected chord is entered.
+ *
+ *  In rollover mode, the next chord may begin before the last one is fully
+ * released. Once any key in the selected chord is released, pressing a chord
+ * key that isn't part of the selected chord immediately enters the selected
+ * chord, and starts a new chord with the pressed key. A long enough pause
+ * before the key press selects the keys that were still held, just like a
+ * pause before a release. Keys from the entered chord that are still held
+ * down are ignored until they are released.
+ *
+ *  ChordState doesn't depend on how key events are read, or when they are
+ * handled. This lets the Input::ChordReader use it with live key events, and
+ * lets recorded key events be replayed to test other timing models.
+ */
+class Input::ChordState
+{
+public:
+    /**
+     * @brief  Creates the state machine with no chord keys held.
+     *
+     * @param releaseTiming  The timing model that sets the release delay.
+     *                       Gaps between releases that enter a chord are
+     *                       recorded in this model.
+     *
+     * @param rolloverMode   Whether new chords may begin before all keys in
+     *                       the previous chord are released.
+     */
+    ChordState(ReleaseTiming& releaseTiming, const bool rolloverMode);
+
+    virtual ~ChordState() { }
+
+    /**
+     * @brief  Updates the state when a chord key is pressed.
+     *
+     * @param keyIndex   The index of the pressed chord key.
+     *
+     * @param eventTime  The time of the key press, in milliseconds.
+     *
+     * @return           The entered chord if the key press rolled over into a
+     *                   new chord, or an invalid chord otherwise.
+     */
+    Chord keyPressed(const int keyIndex, const juce::uint32 eventTime);
+
+    /**
+     * @brief  Updates the state when a chord key is released.
+     *
+     * @param keyIndex   The index of the released chord key. Releases of keys
+     *                   that aren't held are ignored.
+     *
+     * @param eventTime  The time of the key release, in milliseconds.
+     *
+     * @return           The entered chord if this released the last held
+     *                   chord key, or an invalid chord otherwise.
+     */
+    Chord keyReleased(const int keyIndex, const juce::uint32 eventTime);
+
+    /**
+     * @brief  Gets the set of chord keys that are held down as part of the
+     *         chord currently being entered.
+     *
+     * @return  The held chord, or an invalid chord if no keys are held.
+     */
+    Chord getHeldChord() const;
+
+    /**
+     * @brief  Checks if a chord key is held down, including keys left over
+     *         from a chord that was already entered in rollover mode.
+     *
+     * @param keyIndex  The index of a chord key.
+     *
+     * @return          Whether the key is held down.
+     */
+    bool isKeyHeld(const int keyIndex) const;
+
+    /**
+     * @brief  Gets all chord keys that are held down, including keys left
+     *         over from a chord that was already entered in rollover mode.
+     *
+     * @return  A chord bitmap with bits set for each held key.
+     */
+    Chord::uint8 getHeldKeys() const;
+
+    /**
+     * @brief  Gets the chord that will be entered if all held keys are
+     *         released without pausing.
+     *
+     * @return  The selected chord, or an invalid chord if no keys are held.
+     */
+    Chord getSelectedChord() const;
+
+private:
+    /**
+     * @brief  Enters the selected chord, recording its release gaps in the
+     *         timing model and clearing the selection.
+     *
+     * @return  The entered chord.
+     */
+    Chord enterSelectedChord();
+
+    // Sets the release delay, and records release gaps:
+    ReleaseTiming& releaseTiming;
+    // Whether new chords may begin before the last chord is released:
+    const bool rolloverMode;
+    // The chord keys held down for the chord being entered:
+    Chord heldChord;
+    // Keys still held down from a chord entered by rolling over:
+    Chord::uint8 staleKeys = 0;
+    // The chord that will be entered when all keys are released:
+    Chord selectedChord;
+    // Time of the last chord key release:
+    juce::uint32 lastReleaseTime = 0;
+    // Whether chord keys were released since the last chord key press:
+    bool releasePending = false;
+    // Gaps between releases since the selection last changed, recorded in
+    // the timing model once the chord is entered:
+    juce::Array<juce::uint32> releaseGaps;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChordState)
+};
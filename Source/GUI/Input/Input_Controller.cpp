@@ -1,11 +1,8 @@
 #include "Input_Controller.h"
-#include "Input_Key_JSONKeys.h"
 #include "Text_Values.h"
-#include "Output_Sending.h"
 #include "Output_Modifiers.h"
 #include "Application.h"
 #include "JuceHeader.h"
-#include <map>
 
 static const juce::Identifier localeKey("Input_Controller");
 static const juce::Identifier immediateModeKey("immediateMode");
@@ -23,11 +20,41 @@ Input::Controller::Controller(Component::MainView* mainView,
     chordReader(mainView),
     mainView(mainView),
     targetWindow(targetWindow),
-    outputBuffer(outputBuffer)
+    outputBuffer(outputBuffer),
+    wordPredictor(juce::File::getCurrentWorkingDirectory().getChildFile(
+            mainConfig.getWordListFile())),
+    briefReader(juce::File::getCurrentWorkingDirectory().getChildFile(
+            mainConfig.getBriefFile())),
+    outputSender(targetWindow)
 {
     chordReader.addListener(this);
+    outputBuffer.addListener(&wordPredictor);
+    outputBuffer.addListener(&briefReader);
+    wordPredictor.readText(outputBuffer.getBufferedText());
+    briefReader.readText(outputBuffer.getBufferedText());
     mainView->updateChordState(&charsetConfig.getActiveSet(), 0,
-            getInputPreview());
+            getInputPreview(), getSuggestionPreview());
+}
+
+
+// Stops following output buffer changes.
+Input::Controller::~Controller()
+{
+    outputBuffer.removeListener(&wordPredictor);
+    outputBuffer.removeListener(&briefReader);
+}
+
+
+// Changes the window where chord input text will be sent, reloads control key
+// bindings, and redraws the chord state.
+void Input::Controller::setTargetWindow(const int newTarget)
+{
+    const juce::ScopedLock inputLock(inputGuard);
+    targetWindow = newTarget;
+    dispatchTable.rebuild();
+    outputSender.setTargetWindow(newTarget);
+    mainView->updateChordState(&charsetConfig.getActiveSet(), 0,
+            getInputPreview(), getSuggestionPreview());
 }
 
 
@@ -73,11 +100,31 @@ Text::CharString Input::Controller::getInputPreview() const
 }
 
 
+// Gets the characters needed to complete the last buffered word with the top
+// suggested word, or the brief expansion that will replace the last word.
+Text::CharString Input::Controller::getSuggestionPreview() const
+{
+    if (mainConfig.getImmediateMode())
+    {
+        return Text::CharString();
+    }
+    const Text::CharString* expansion = briefReader.getExpansion();
+    if (expansion != nullptr)
+    {
+        Text::CharString expansionPreview;
+        expansionPreview.add(Text::Values::right);
+        expansionPreview.addArray(*expansion);
+        return expansionPreview;
+    }
+    return wordPredictor.getSuggestion();
+}
+
+
 // Updates the ChordComponent when the current held chord changes.
 void Input::Controller::selectedChordChanged(const Chord selectedChord)
 {
     mainView->updateChordState(&charsetConfig.getActiveSet(),
-            selectedChord, getInputPreview());
+            selectedChord, getInputPreview(), getSuggestionPreview());
 }
 
 
@@ -143,15 +190,20 @@ void Input::Controller::chordEntered(const Chord selected)
     }
     else if (mainConfig.getImmediateMode())
     {
-        Output::Sending::sendKey(enteredChar, outputBuffer.getModifierFlags(),
-                targetWindow);
+        outputSender.queueKey(enteredChar, outputBuffer.getModifierFlags());
     }
     else
     {
+        // Word separators replace the last word if it matches a brief:
+        if (! BriefReader::isWordCharacter(enteredChar))
+        {
+            expandBrief();
+        }
+        briefReader.chordEntered(selected);
         outputBuffer.appendCharacter(enteredChar);
     }
     mainView->updateChordState(&charsetConfig.getActiveSet(), 0,
-            getInputPreview());
+            getInputPreview(), getSuggestionPreview());
 }
 
 
@@ -173,199 +225,216 @@ void Input::Controller::keyPressed(const juce::KeyPress key)
         closeHelpScreen();
         return;
     }
-    namespace Keys = Input::Key::JSONKeys;
-    using Text::CharSet::Type;
     if (! key.isValid())
     {
         return;
     }
-
-    // Attempts to update the character set, returning whether the active set
-    // changed:
-    const std::function<bool(const Type)> charSetUpdate =
-    [this](const Type type)
+    const juce::uint32 actionFlags = dispatchTable.getActionFlags(key);
+    if (actionFlags == 0)
+    {
+        return;
+    }
+    bool sendUpdate = false;
+    for (int i = 0; i < (int) Action::actionCount; i++)
     {
-        if (charsetConfig.getActiveType() != type)
+        if (Key::DispatchTable::hasAction(actionFlags, (Action) i))
         {
-            charsetConfig.setActiveType(type);
-            return true;
+            sendUpdate = runAction((Action) i) || sendUpdate;
         }
-        return false;
-    };
+    }
+    if (sendUpdate)
+    {
+        mainView->updateChordState(&charsetConfig.getActiveSet(),
+                chordReader.getSelectedChord(),
+                getInputPreview(), getSuggestionPreview());
+    }
+}
 
-    bool sendUpdate = false;
-    const std::map<const juce::Identifier*, std::function<void()>> actionMap =
+
+// Runs a single action bound to a key press.
+bool Input::Controller::runAction(const Action action)
+{
+    using Text::CharSet::Type;
+    switch (action)
     {
+        case Action::selectMainSet:
+            return selectCharSet(Type::main);
+        case Action::selectAltSet:
+            return selectCharSet(Type::alt);
+        case Action::selectSpecialSet:
+            return selectCharSet(Type::special);
+        case Action::selectNextSet:
         {
-            &Keys::selectMainSet,
-            [this, &sendUpdate, &charSetUpdate]()
-            {
-                sendUpdate = charSetUpdate(Type::main);
-            }
-        },
-        {
-            &Keys::selectAltSet,
-            [this, &sendUpdate, &charSetUpdate]()
-            {
-                sendUpdate = charSetUpdate(Type::alt);
-            }
-        },
-        {
-            &Keys::selectSpecialSet,
-            [this, &sendUpdate, &charSetUpdate]()
-            {
-                sendUpdate = charSetUpdate(Type::special);
-            }
-        },
-        {
-            &Keys::selectNextSet,
-            [this, &sendUpdate, &charSetUpdate]()
-            {
-                int currentSetIndex = (int) charsetConfig.getActiveType();
-                Type nextSet = (Type)((currentSetIndex + 1)
-                        % Text::CharSet::numCharacterSets);
-                sendUpdate = charSetUpdate(nextSet);
-            }
-        },
-        {
-            &Keys::selectModSet,
-            [this, &sendUpdate, &charSetUpdate]()
-            {
-                sendUpdate = charSetUpdate(Type::modifier);
-            }
-        },
-        {
-            &Keys::toggleShift,
-            [this, &sendUpdate]()
-            {
-                charsetConfig.setShifted(! charsetConfig.getShifted());
-                mainView->repaint();
-            }
-        },
-        {
-            &Keys::backspace,
-            [this, &sendUpdate]()
-            {
-                // In immediate mode, actually send a backspace character
-                if (mainConfig.getImmediateMode())
-                {
-                    Output::Sending::sendKey(Text::Values::backspace, 0,
-                            targetWindow);
-                }
-                else
-                {
-                    outputBuffer.deleteLastChar();
-                }
-                sendUpdate = true;
-            }
-        },
-        {
-            &Keys::clearAll,
-            [this, &sendUpdate]()
-            {
-                outputBuffer.clear();
-                sendUpdate = true;
-            }
-        },
-        {
-            &Keys::sendText,
-            [this, &sendUpdate]()
+            int currentSetIndex = (int) charsetConfig.getActiveType();
+            Type nextSet = (Type)((currentSetIndex + 1)
+                    % Text::CharSet::numCharacterSets);
+            return selectCharSet(nextSet);
+        }
+        case Action::selectModSet:
+            return selectCharSet(Type::modifier);
+        case Action::toggleShift:
+            charsetConfig.setShifted(! charsetConfig.getShifted());
+            mainView->repaint();
+            return false;
+        case Action::backspace:
+            // In immediate mode, actually send a backspace character
+            if (mainConfig.getImmediateMode())
             {
-                // In immediate mode, send a return character instead
-                if (mainConfig.getImmediateMode())
-                {
-                    Output::Sending::sendKey(Text::Values::enter, 0,
-                            targetWindow);
-                }
-                else
-                {
-                    Output::Sending::sendBufferedOutput(outputBuffer,
-                            targetWindow);
-                }
-                sendUpdate = true;
+                outputSender.queueKey(Text::Values::backspace, 0);
             }
-        },
-        {
-            &Keys::closeAndSend,
-            [this, &sendUpdate]()
+            else
             {
-                Output::Sending::sendBufferedOutput(outputBuffer, targetWindow);
-                juce::JUCEApplication::getInstance()->systemRequestedQuit();
+                outputBuffer.deleteLastChar();
             }
-        },
-        {
-            &Keys::close,
-            [this, &sendUpdate]()
+            return true;
+        case Action::clearAll:
+            outputBuffer.clear();
+            return true;
+        case Action::sendText:
+            // In immediate mode, send a return character instead
+            if (mainConfig.getImmediateMode())
             {
-                juce::JUCEApplication::getInstance()->systemRequestedQuit();
+                outputSender.queueKey(Text::Values::enter, 0);
             }
-        },
-        {
-            &Keys::toggleImmediate,
-            [this, &sendUpdate]()
+            else
             {
-                const bool immediateMode = ! mainConfig.getImmediateMode();
-                mainConfig.setImmediateMode(immediateMode);
-                if (immediateMode && ! outputBuffer.isEmpty())
-                {
-                    Output::Sending::sendBufferedOutput(outputBuffer,
-                            targetWindow);
-                }
-                sendUpdate = true;
+                queueBufferedOutput();
             }
-        },
+            return true;
+        case Action::closeAndSend:
+            closeWhenSent();
+            return false;
+        case Action::close:
+            juce::JUCEApplication::getInstance()->systemRequestedQuit();
+            return false;
+        case Action::acceptSuggestion:
+            return acceptSuggestion();
+        case Action::toggleImmediate:
         {
-            &Keys::showHelp,
-            [this, &sendUpdate]()
+            const bool immediateMode = ! mainConfig.getImmediateMode();
+            mainConfig.setImmediateMode(immediateMode);
+            if (immediateMode && ! outputBuffer.isEmpty())
             {
-                mainView->toggleHelpScreen();
-                DBG(dbgPrefix << __func__ << ": Showing help screen.");
-                Application* application = Application::getInstance();
-                application->resetWindow(application->getWindowFlags()
-                        | (int) Application::WindowFlag::showingHelp);
+                queueBufferedOutput();
             }
-        },
+            return true;
+        }
+        case Action::showHelp:
         {
-            &Keys::toggleWindowEdge,
-            [this]()
-            {
-                mainConfig.setSnapToBottom(! mainConfig.getSnapToBottom());
-                DBG(dbgPrefix << __func__ << ": Setting windowEdge = "
-                        << (mainConfig.getSnapToBottom() ? "bottom" : "top"));
-                Application* application = Application::getInstance();
-                application->resetUpdatingFlags();
-            }
-        },
+            mainView->toggleHelpScreen();
+            DBG(dbgPrefix << __func__ << ": Showing help screen.");
+            Application* application = Application::getInstance();
+            application->resetWindow(application->getWindowFlags()
+                    | (int) Application::WindowFlag::showingHelp);
+            return false;
+        }
+        case Action::toggleWindowEdge:
         {
-            &Keys::toggleMinimize,
-            [this, &sendUpdate]()
-            {
-                mainConfig.setMinimised(! mainConfig.getMinimized());
-                DBG(dbgPrefix << __func__ << ": Setting minimized = "
-                        << (mainConfig.getMinimized() ? "true" : "false"));
-                Application* application = Application::getInstance();
-                application->resetUpdatingFlags();
-            }
-        },
-    };
-    juce::KeyPress unmoddedKey(key.getKeyCode());
-    for (const juce::Identifier* binding : Keys::allKeys)
-    {
-        juce::KeyPress boundKey = keyConfig.getBoundKey(*binding);
-        if (boundKey == key || boundKey == unmoddedKey)
+            mainConfig.setSnapToBottom(! mainConfig.getSnapToBottom());
+            DBG(dbgPrefix << __func__ << ": Setting windowEdge = "
+                    << (mainConfig.getSnapToBottom() ? "bottom" : "top"));
+            Application* application = Application::getInstance();
+            application->resetUpdatingFlags();
+            return false;
+        }
+        case Action::toggleMinimize:
         {
-            if (actionMap.count(binding) > 0)
-            {
-                actionMap.at(binding)();
-            }
+            mainConfig.setMinimised(! mainConfig.getMinimized());
+            DBG(dbgPrefix << __func__ << ": Setting minimized = "
+                    << (mainConfig.getMinimized() ? "true" : "false"));
+            Application* application = Application::getInstance();
+            application->resetUpdatingFlags();
+            return false;
         }
+        case Action::actionCount:
+            break;
     }
-    if (sendUpdate)
+    return false;
+}
+
+
+// Selects a new active character set.
+bool Input::Controller::selectCharSet(const Text::CharSet::Type type)
+{
+    if (charsetConfig.getActiveType() != type)
     {
-        mainView->updateChordState(&charsetConfig.getActiveSet(),
-                chordReader.getSelectedChord(),
-                getInputPreview());
+        charsetConfig.setActiveType(type);
+        return true;
+    }
+    return false;
+}
+
+
+// Completes the last buffered word using the top suggested word, or replaces
+// it with the matching brief's text.
+bool Input::Controller::acceptSuggestion()
+{
+    if (mainConfig.getImmediateMode())
+    {
+        return false;
+    }
+    if (expandBrief())
+    {
+        outputBuffer.appendCharacter((Text::CharValue) ' ');
+        return true;
+    }
+    if (wordPredictor.getSuggestionCount() == 0)
+    {
+        return false;
+    }
+    const Text::CharString suggestion = wordPredictor.getSuggestion();
+    for (const Text::CharValue& suggestedChar : suggestion)
+    {
+        outputBuffer.appendCharacter(suggestedChar);
     }
+    outputBuffer.appendCharacter((Text::CharValue) ' ');
+    return true;
+}
+
+
+// Replaces the last buffered word with a brief's text, if the chords that
+// typed the word form a complete brief.
+bool Input::Controller::expandBrief()
+{
+    const Text::CharString* expansion = briefReader.getExpansion();
+    if (expansion == nullptr)
+    {
+        return false;
+    }
+    const Text::CharString briefText = *expansion;
+    for (int i = briefReader.getWordLength(); i > 0; i--)
+    {
+        outputBuffer.deleteLastChar();
+    }
+    for (const Text::CharValue& briefChar : briefText)
+    {
+        outputBuffer.appendCharacter(briefChar);
+    }
+    return true;
+}
+
+
+// Moves all buffered text into the output queue.
+void Input::Controller::queueBufferedOutput()
+{
+    // Sending ends the last word, so it should be replaced if it's a brief:
+    expandBrief();
+    outputSender.queueText(outputBuffer.getBufferedText(),
+            outputBuffer.getModifierFlags());
+    outputBuffer.clear();
+}
+
+
+// Queues all buffered text, and closes the application once it has all been
+// sent.
+void Input::Controller::closeWhenSent()
+{
+    queueBufferedOutput();
+    // Wait until all queued output is sent before closing:
+    outputSender.callWhenDrained([]()
+    {
+        juce::JUCEApplication::getInstance()->systemRequestedQuit();
+    });
 }
 
 
@@ -6,9 +6,13 @@
  *         ensuring that they are handled appropriately.
  */
 
+#include "Input_BriefReader.h"
 #include "Input_ChordReader.h"
 #include "Input_Key_ConfigFile.h"
+#include "Input_Key_DispatchTable.h"
 #include "Output_Buffer.h"
+#include "Output_Sender.h"
+#include "Output_WordPredictor.h"
 #include "Text_CharSet_ConfigFile.h"
 #include "Text_CharTypes.h"
 #include "Config_MainFile.h"
@@ -26,6 +30,12 @@ namespace juce { class KeyPress; }
  * controller is completely responsible for deciding how they are handled.
  * The Controller uses the Input::Key::ConfigFile to determine which key events
  * control specific actions.
+ *
+ *  When a word list is configured, the Controller also shows the top word
+ * suggestion for the buffered text, and adds it to the buffer when the accept
+ * suggestion key is pressed. When a brief dictionary is configured, buffered
+ * words typed with a brief's chords are replaced with the brief's text when
+ * the word ends.
  */
 class Input::Controller : public ChordReader::Listener, public Locale::TextUser
 {
@@ -46,7 +56,21 @@ public:
     Controller(Component::MainView* mainView, const int targetWindow,
             Output::Buffer& buffer);
 
-    virtual ~Controller() { }
+    /**
+     * @brief  Stops following output buffer changes.
+     */
+    virtual ~Controller();
+
+    /**
+     * @brief  Changes the window where chord input text will be sent,
+     *         reloads control key bindings, and redraws the chord state. Text
+     *         that was already sent or queued still goes to the previous
+     *         target window.
+     *
+     * @param newTarget  The ID of the window where chord input text should
+     *                   now be sent.
+     */
+    void setTargetWindow(const int newTarget);
 
 private:
     /**
@@ -57,6 +81,16 @@ private:
      */
     Text::CharString getInputPreview() const;
 
+    /**
+     * @brief  Gets the characters needed to complete the last buffered word
+     *         with the top suggested word.
+     *
+     * @return  The suggested characters, an arrow followed by the text that
+     *          will replace the last word if it matches a brief, or an empty
+     *          string if there's no suggestion or immediate mode is enabled.
+     */
+    Text::CharString getSuggestionPreview() const;
+
     /**
      * @brief  Updates the MainView when the current held chord changes.
      *
@@ -80,6 +114,59 @@ private:
      */
     void keyPressed(const juce::KeyPress key) override;
 
+    // All actions that may be bound to key presses:
+    typedef Key::DispatchTable::Action Action;
+
+    /**
+     * @brief  Runs a single action bound to a key press.
+     *
+     * @param action  The action to run.
+     *
+     * @return        Whether the displayed chord state needs to be updated.
+     */
+    bool runAction(const Action action);
+
+    /**
+     * @brief  Selects a new active character set.
+     *
+     * @param type  The character set type to select.
+     *
+     * @return      Whether the active character set changed.
+     */
+    bool selectCharSet(const Text::CharSet::Type type);
+
+    /**
+     * @brief  Completes the last buffered word using the top suggested word,
+     *         or replaces it with the matching brief's text, followed by a
+     *         space.
+     *
+     * @return  Whether a suggestion or brief was added to the output buffer.
+     */
+    bool acceptSuggestion();
+
+    /**
+     * @brief  Replaces the last buffered word with a brief's text, if the
+     *         chords that typed the word form a complete brief.
+     *
+     * @return  Whether the word was replaced.
+     */
+    bool expandBrief();
+
+    /**
+     * @brief  Moves all buffered text into the output queue, and clears the
+     *         output buffer.
+     *
+     *  If the last buffered word is a complete brief, it is expanded before
+     * the text is queued.
+     */
+    void queueBufferedOutput();
+
+    /**
+     * @brief  Queues all buffered text, and closes the application once it
+     *         has all been sent.
+     */
+    void closeWhenSent();
+
     /**
      * @brief  Ensures the help screen is currently closed.
      */
@@ -94,6 +181,8 @@ private:
 
     // Loads key bindings:
     Input::Key::ConfigFile keyConfig;
+    // Finds the actions bound to each key press:
+    Input::Key::DispatchTable dispatchTable;
     // Loads configurable character set:
     Text::CharSet::ConfigFile charsetConfig;
     // Loads saved application state:
@@ -108,6 +197,12 @@ private:
     ChordReader chordReader;
     // Buffers text waiting to be sent to the target window:
     Output::Buffer& outputBuffer;
+    // Suggests completions for the last word in the output buffer:
+    Output::WordPredictor wordPredictor;
+    // Expands chord sequences in the output buffer into whole words:
+    BriefReader briefReader;
     // Stores the target window ID:
-    const int targetWindow;
+    int targetWindow;
+    // Sends output to the target window without blocking input:
+    Output::Sender outputSender;
 };
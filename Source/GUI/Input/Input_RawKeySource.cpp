@@ -0,0 +1,142 @@
+#include "Input_RawKeySource.h"
+#include <X11/XKBlib.h>
+#include <X11/keysym.h>
+#include <X11/extensions/XInput2.h>
+#include <poll.h>
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Input::RawKeySource::";
+#endif
+
+// Milliseconds to wait for new events before checking if the thread should
+// exit:
+static const constexpr int pollFrequency = 100;
+// Flag JUCE adds to Linux key codes for keys that don't produce characters:
+static const constexpr int extendedKeyFlag = 0x10000000;
+// Largest KeySym value that matches a Latin-1 character:
+static const constexpr KeySym maxLatin1KeySym = 0xff;
+
+
+// Opens a new X server connection, and starts reading raw key events if the X
+// server supports XInput2.
+Input::RawKeySource::RawKeySource(const EventCallback eventCallback) :
+juce::Thread("Input::RawKeySource"),
+eventCallback(eventCallback),
+display(XOpenDisplay(nullptr))
+{
+    if (display == nullptr)
+    {
+        DBG(dbgPrefix << __func__ << ": Failed to open X display!");
+        return;
+    }
+    int eventBase, errorBase;
+    int majorVersion = 2;
+    int minorVersion = 2;
+    if (! XQueryExtension(display, "XInputExtension", &xiOpcode, &eventBase,
+                &errorBase)
+            || XIQueryVersion(display, &majorVersion, &minorVersion) != Success
+            || majorVersion < 2)
+    {
+        DBG(dbgPrefix << __func__ << ": XInput2 is not supported!");
+        XCloseDisplay(display);
+        display = nullptr;
+        return;
+    }
+
+    unsigned char maskBits[XIMaskLen(XI_LASTEVENT)] = { 0 };
+    XISetMask(maskBits, XI_RawKeyPress);
+    XISetMask(maskBits, XI_RawKeyRelease);
+    XIEventMask eventMask;
+    eventMask.deviceid = XIAllMasterDevices;
+    eventMask.mask_len = sizeof(maskBits);
+    eventMask.mask = maskBits;
+    XISelectEvents(display, DefaultRootWindow(display), &eventMask, 1);
+    XSync(display, False);
+    DBG(dbgPrefix << __func__ << ": Reading raw key events using XInput "
+            << majorVersion << "." << minorVersion);
+    startThread();
+}
+
+
+// Stops reading key events and closes the X server connection.
+Input::RawKeySource::~RawKeySource()
+{
+    stopThread(pollFrequency * 2);
+    if (display != nullptr)
+    {
+        XCloseDisplay(display);
+        display = nullptr;
+    }
+}
+
+
+// Checks if the source is reading raw key events.
+bool Input::RawKeySource::isReading() const
+{
+    return display != nullptr;
+}
+
+
+// Waits for and handles raw key events until the thread is told to exit.
+void Input::RawKeySource::run()
+{
+    const int connectionFD = ConnectionNumber(display);
+    while (! threadShouldExit())
+    {
+        if (XPending(display) == 0)
+        {
+            pollfd pollData = { connectionFD, POLLIN, 0 };
+            poll(&pollData, 1, pollFrequency);
+            continue;
+        }
+        XEvent event;
+        XNextEvent(display, &event);
+        XGenericEventCookie* cookie = &event.xcookie;
+        if (cookie->type != GenericEvent || cookie->extension != xiOpcode
+                || ! XGetEventData(display, cookie))
+        {
+            continue;
+        }
+        if (cookie->evtype == XI_RawKeyPress
+                || cookie->evtype == XI_RawKeyRelease)
+        {
+            const XIRawEvent* rawEvent = (const XIRawEvent*) cookie->data;
+            const bool isPressed = (cookie->evtype == XI_RawKeyPress);
+            // Held keys don't change chord state, so skip auto-repeat events:
+            if (! isPressed || (rawEvent->flags & XIKeyRepeat) == 0)
+            {
+                eventCallback(getKeyCode(rawEvent->detail), isPressed,
+                        (juce::uint32) rawEvent->time);
+            }
+        }
+        XFreeEventData(display, cookie);
+    }
+}
+
+
+// Gets the JUCE key code for an X keycode.
+int Input::RawKeySource::getKeyCode(const int xKeycode) const
+{
+    const KeySym keySym = XkbKeycodeToKeysym(display, (KeyCode) xKeycode, 0,
+            0);
+    if (keySym == NoSymbol)
+    {
+        return 0;
+    }
+    if (keySym <= maxLatin1KeySym)
+    {
+        return (int) keySym;
+    }
+    switch (keySym)
+    {
+        // JUCE treats these keys as their ASCII control characters:
+        case XK_Tab:
+        case XK_Return:
+        case XK_Escape:
+        case XK_BackSpace:
+            return (int) (keySym & 0xff);
+        default:
+            return (int) (keySym & 0xff) | extendedKeyFlag;
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+/**
+ * @file  Input_RawKeySource.h
+ *
+ * @brief  Reads raw key press and release events directly from the X server.
+ */
+
+#include <X11/Xlib.h>
+#include "JuceHeader.h"
+
+namespace Input { class RawKeySource; }
+
+/**
+ * @brief  Reads XInput2 raw key events on its own thread and X server
+ *         connection, passing each event on with the X server's timestamp.
+ *
+ *  JUCE key events arrive on the message thread, so the time between them
+ * depends on how busy the message thread is. Raw key events carry the
+ * millisecond timestamp the X server assigned when the key was actually
+ * pressed or released, so the order and spacing of chord key events can be
+ * measured exactly.
+ *
+ *  Raw key events are sent for every key event on the display, including
+ * events created using the XTest extension, whether or not a KeyChord window
+ * has keyboard focus. Event handlers are responsible for ignoring events
+ * while the application shouldn't be reading input.
+ */
+class Input::RawKeySource : private juce::Thread
+{
+public:
+    /**
+     * @brief  Handles a single raw key event. This is called on the
+     *         RawKeySource's thread, not the message thread.
+     *
+     * @param keyCode     The JUCE key code of the pressed or released key.
+     *
+     * @param isPressed   True for key presses, false for key releases.
+     *
+     * @param serverTime  The X server timestamp of the event, in milliseconds.
+     */
+    typedef std::function<void(const int keyCode, const bool isPressed,
+            const juce::uint32 serverTime)> EventCallback;
+
+    /**
+     * @brief  Opens a new X server connection, and starts reading raw key
+     *         events if the X server supports XInput2.
+     *
+     * @param eventCallback  The function that will handle all raw key events.
+     */
+    RawKeySource(const EventCallback eventCallback);
+
+    /**
+     * @brief  Stops reading key events and closes the X server connection.
+     */
+    virtual ~RawKeySource();
+
+    /**
+     * @brief  Checks if the source is reading raw key events.
+     *
+     * @return  Whether the X server connection was opened and XInput2 raw key
+     *          events were selected successfully.
+     */
+    bool isReading() const;
+
+private:
+    /**
+     * @brief  Waits for and handles raw key events until the thread is told
+     *         to exit.
+     */
+    void run() override;
+
+    /**
+     * @brief  Gets the JUCE key code for an X keycode.
+     *
+     *  This follows the conventions JUCE uses on Linux: keys that produce a
+     * Latin-1 character use that character's value, and other keys use the
+     * low byte of their KeySym marked as an extended key.
+     *
+     * @param xKeycode  A keycode value from an X key event.
+     *
+     * @return          The equivalent JUCE key code, or zero if the keycode
+     *                  has no KeySym.
+     */
+    int getKeyCode(const int xKeycode) const;
+
+    const EventCallback eventCallback;
+    // The connection used to read raw key events:
+    Display* display = nullptr;
+    // The XInputExtension major opcode, used to identify XInput2 events:
+    int xiOpcode = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RawKeySource)
+};
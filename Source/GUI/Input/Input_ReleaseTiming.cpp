@@ -0,0 +1,59 @@
+#include "Input_ReleaseTiming.h"
+#include <algorithm>
+
+// Number of release gaps that must be recorded before the release delay
+// changes:
+static const constexpr int minGapCount = 16;
+// Percentage of recorded release gaps that should fall below the percentile
+// used to set the release delay:
+static const constexpr int gapPercentile = 90;
+// Multiplier applied to the release gap percentile, leaving room for
+// releases that are slower than usual:
+static const constexpr int delayMargin = 2;
+
+
+// Creates the timing model with an initial release delay.
+Input::ReleaseTiming::ReleaseTiming
+(const int initialDelay, const bool adaptive) :
+    releaseDelay(juce::jlimit(minReleaseDelay, maxReleaseDelay,
+                initialDelay)),
+    adaptive(adaptive) { }
+
+
+// Gets the current release delay.
+int Input::ReleaseTiming::getReleaseDelay() const
+{
+    return releaseDelay;
+}
+
+
+// Checks if the release delay adjusts to recorded release gaps.
+bool Input::ReleaseTiming::isAdaptive() const
+{
+    return adaptive;
+}
+
+
+// Records the time between two key releases made while entering a single
+// chord, updating the release delay if adaptive.
+void Input::ReleaseTiming::addReleaseGap(const juce::uint32 releaseGap)
+{
+    if (! adaptive)
+    {
+        return;
+    }
+    releaseGaps[gapCount % gapHistorySize] = releaseGap;
+    gapCount++;
+    if (gapCount < minGapCount)
+    {
+        return;
+    }
+    const int sampleCount = juce::jmin(gapCount, gapHistorySize);
+    juce::uint32 sortedGaps[gapHistorySize];
+    std::copy(releaseGaps, releaseGaps + sampleCount, sortedGaps);
+    juce::uint32* percentileGap = sortedGaps
+            + ((sampleCount - 1) * gapPercentile / 100);
+    std::nth_element(sortedGaps, percentileGap, sortedGaps + sampleCount);
+    releaseDelay = juce::jlimit(minReleaseDelay, maxReleaseDelay,
+            (int) (*percentileGap * delayMargin));
+}
@@ -0,0 +1,87 @@
+#pragma once
+/**
+ * @file  Input_ReleaseTiming.h
+ *
+ * @brief  Decides how long chord key releases may be spread out while still
+ *         entering a single chord.
+ */
+
+#include "JuceHeader.h"
+
+namespace Input { class ReleaseTiming; }
+
+/**
+ * @brief  Tracks the chord release delay, optionally adjusting it to match
+ *         how quickly the user releases chord keys.
+ *
+ *  When chord keys are released one at a time, a release that follows the
+ * previous one within the release delay is treated as part of entering the
+ * selected chord. A longer pause means the user is changing the selected chord
+ * to the keys still held down.
+ *
+ *  In adaptive mode, ReleaseTiming keeps the most recent gaps between releases
+ * that were part of entering a chord. Once enough gaps are recorded, the
+ * release delay is set to a multiple of a high percentile of those gaps, so
+ * fast typists don't need to wait as long to change the selected chord, while
+ * slower typists don't have chords split by a release that came a little
+ * late.
+ */
+class Input::ReleaseTiming
+{
+public:
+    /**
+     * @brief  Creates the timing model with an initial release delay.
+     *
+     * @param initialDelay  The release delay to use until enough release gaps
+     *                      are recorded, in milliseconds.
+     *
+     * @param adaptive      Whether the release delay should be adjusted to
+     *                      match recorded release gaps.
+     */
+    ReleaseTiming(const int initialDelay, const bool adaptive);
+
+    virtual ~ReleaseTiming() { }
+
+    /**
+     * @brief  Gets the current release delay.
+     *
+     * @return  The maximum number of milliseconds that may pass between two
+     *          key releases when entering a single chord.
+     */
+    int getReleaseDelay() const;
+
+    /**
+     * @brief  Checks if the release delay adjusts to recorded release gaps.
+     *
+     * @return  Whether the timing model is adaptive.
+     */
+    bool isAdaptive() const;
+
+    /**
+     * @brief  Records the time between two key releases made while entering a
+     *         single chord, updating the release delay if adaptive.
+     *
+     * @param releaseGap  Milliseconds between the two releases.
+     */
+    void addReleaseGap(const juce::uint32 releaseGap);
+
+    // The smallest release delay the timing model will use:
+    static const constexpr int minReleaseDelay = 80;
+    // The largest release delay the timing model will use:
+    static const constexpr int maxReleaseDelay = 500;
+
+private:
+    // Number of recent release gaps used to set the release delay:
+    static const constexpr int gapHistorySize = 64;
+
+    // The current release delay, in milliseconds:
+    int releaseDelay;
+    // Whether the release delay adjusts to recorded release gaps:
+    const bool adaptive;
+    // The most recent release gaps, used as a circular buffer:
+    juce::uint32 releaseGaps[gapHistorySize] = { 0 };
+    // Total number of release gaps recorded:
+    int gapCount = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ReleaseTiming)
+};
@@ -0,0 +1,49 @@
+#include "Input_SessionRecorder.h"
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Input::SessionRecorder::";
+#endif
+
+
+// Opens a session file for recording, adding to the end of any existing
+// session data.
+Input::SessionRecorder::SessionRecorder(const juce::File& sessionFile) :
+    sessionStream(sessionFile)
+{
+    if (sessionStream.failedToOpen())
+    {
+        DBG(dbgPrefix << __func__ << ": Failed to open session file "
+                << sessionFile.getFullPathName());
+    }
+}
+
+
+// Checks if the session file was opened successfully.
+bool Input::SessionRecorder::isRecording() const
+{
+    return sessionStream.openedOk();
+}
+
+
+// Saves a chord key press or release.
+void Input::SessionRecorder::keyEvent
+(const int keyIndex, const bool isPressed, const juce::uint32 eventTime)
+{
+    if (isRecording())
+    {
+        sessionStream << (isPressed ? "p " : "r ") << keyIndex << " "
+                << (juce::int64) eventTime << "\n";
+    }
+}
+
+
+// Saves an entered chord.
+void Input::SessionRecorder::chordEntered(const Chord enteredChord)
+{
+    if (isRecording())
+    {
+        sessionStream << "c " << (int) enteredChord.getByteValue() << "\n";
+        sessionStream.flush();
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+/**
+ * @file  Input_SessionRecorder.h
+ *
+ * @brief  Saves chord key timing to a file, so it can be replayed later.
+ */
+
+#include "JuceHeader.h"
+#include "Input_Chord.h"
+
+namespace Input { class SessionRecorder; }
+
+/**
+ * @brief  Appends chord key events and entered chords to a session file.
+ *
+ *  Session files are plain text, with one event per line:
+ *
+ *      p <key index> <time>     A chord key was pressed.
+ *      r <key index> <time>     A chord key was released.
+ *      c <chord value>          A chord was entered.
+ *
+ *  Times are in milliseconds, and chord values are chord bitmaps. Entered
+ * chord lines record the chord the user intended to type. The recorder saves
+ * the chord that was actually entered, so misread chords should be corrected
+ * by hand before the session is used to score timing models.
+ *
+ * @see Input_SessionReplay.h
+ */
+class Input::SessionRecorder
+{
+public:
+    /**
+     * @brief  Opens a session file for recording, adding to the end of any
+     *         existing session data.
+     *
+     * @param sessionFile  The file where key events will be saved.
+     */
+    SessionRecorder(const juce::File& sessionFile);
+
+    virtual ~SessionRecorder() { }
+
+    /**
+     * @brief  Checks if the session file was opened successfully.
+     *
+     * @return  Whether events will be saved.
+     */
+    bool isRecording() const;
+
+    /**
+     * @brief  Saves a chord key press or release.
+     *
+     * @param keyIndex   The index of the pressed or released chord key.
+     *
+     * @param isPressed  True for key presses, false for key releases.
+     *
+     * @param eventTime  The time of the event, in milliseconds.
+     */
+    void keyEvent(const int keyIndex, const bool isPressed,
+            const juce::uint32 eventTime);
+
+    /**
+     * @brief  Saves an entered chord.
+     *
+     * @param enteredChord  The chord that was entered.
+     */
+    void chordEntered(const Chord enteredChord);
+
+private:
+    juce::FileOutputStream sessionStream;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SessionRecorder)
+};
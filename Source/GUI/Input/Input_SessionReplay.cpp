@@ -0,0 +1,102 @@
+#include "Input_SessionReplay.h"
+#include "Input_ChordState.h"
+#include "Input_ReleaseTiming.h"
+
+// Number of average chord entry periods each misread chord is assumed to cost:
+static const constexpr int misreadCost = 2;
+// Milliseconds per minute, used to calculate throughput:
+static const constexpr double msPerMinute = 60000.0;
+
+
+// Gets the fraction of chords entered correctly.
+double Input::SessionReplay::Score::getAccuracy() const
+{
+    if (chordCount == 0)
+    {
+        return 0;
+    }
+    return (double) correctCount / chordCount;
+}
+
+
+// Replays a session file using a release timing model.
+Input::SessionReplay::Score Input::SessionReplay::replay
+(const juce::File& sessionFile, ReleaseTiming& releaseTiming,
+        const bool rolloverMode)
+{
+    using juce::StringArray;
+    Score score;
+    ChordState chordState(releaseTiming, rolloverMode);
+    juce::Array<Chord> enteredChords;
+    juce::Array<Chord> recordedChords;
+    juce::uint32 firstEventTime = 0;
+    juce::uint32 lastEventTime = 0;
+    juce::uint32 chordStartTime = 0;
+    double totalChordTime = 0;
+    bool eventsFound = false;
+
+    const StringArray lines = StringArray::fromLines(
+            sessionFile.loadFileAsString());
+    for (const juce::String& line : lines)
+    {
+        const StringArray tokens = StringArray::fromTokens(line, false);
+        if (tokens.size() == 2 && tokens[0] == "c")
+        {
+            recordedChords.add(Chord((Chord::uint8) tokens[1].getIntValue()));
+            continue;
+        }
+        if (tokens.size() != 3 || (tokens[0] != "p" && tokens[0] != "r"))
+        {
+            continue;
+        }
+        const int keyIndex = tokens[1].getIntValue();
+        const juce::uint32 eventTime
+                = (juce::uint32) tokens[2].getLargeIntValue();
+        if (! eventsFound)
+        {
+            firstEventTime = eventTime;
+            eventsFound = true;
+        }
+        lastEventTime = eventTime;
+        const bool isPress = (tokens[0] == "p");
+        // A chord starts on the first press after all keys are released, or on
+        // a press that rolls over into a new chord:
+        bool chordStarted = isPress && ! chordState.getHeldChord().isValid();
+        const Chord enteredChord = isPress
+                ? chordState.keyPressed(keyIndex, eventTime)
+                : chordState.keyReleased(keyIndex, eventTime);
+        if (enteredChord.isValid())
+        {
+            enteredChords.add(enteredChord);
+            totalChordTime += (juce::uint32) (eventTime - chordStartTime);
+            chordStarted = chordStarted || isPress;
+        }
+        if (chordStarted)
+        {
+            chordStartTime = eventTime;
+        }
+    }
+
+    score.chordCount = recordedChords.size();
+    for (int i = 0; i < recordedChords.size() && i < enteredChords.size(); i++)
+    {
+        if (recordedChords[i] == enteredChords[i])
+        {
+            score.correctCount++;
+        }
+    }
+    score.finalReleaseDelay = releaseTiming.getReleaseDelay();
+    if (enteredChords.isEmpty())
+    {
+        return score;
+    }
+    const double averageChordTime = totalChordTime / enteredChords.size();
+    const double sessionTime = (juce::uint32) (lastEventTime - firstEventTime)
+            + (score.chordCount - score.correctCount) * misreadCost
+            * averageChordTime;
+    if (sessionTime > 0)
+    {
+        score.chordsPerMinute = score.correctCount * msPerMinute / sessionTime;
+    }
+    return score;
+}
@@ -0,0 +1,69 @@
+#pragma once
+/**
+ * @file  Input_SessionReplay.h
+ *
+ * @brief  Scores chord release timing models using recorded typing sessions.
+ */
+
+#include "JuceHeader.h"
+
+namespace Input
+{
+    class ReleaseTiming;
+
+    /**
+     * @brief  Replays session files saved by Input::SessionRecorder through an
+     *         Input::ChordState, comparing the chords it enters with the
+     *         chords recorded in the session.
+     *
+     *  Replays run offline, as fast as the session can be read, so different
+     * release timing models can be compared on the same key events:
+     *
+     *     ./build/Debug/KeyChord --replay session.txt
+     */
+    namespace SessionReplay
+    {
+        /**
+         * @brief  The results of replaying a single session.
+         */
+        struct Score
+        {
+            // Number of chords recorded in the session:
+            int chordCount = 0;
+            // Number of replayed chords that matched the recorded chords:
+            int correctCount = 0;
+            // Correct chords per minute, counting time spent fixing misread
+            // chords:
+            double chordsPerMinute = 0;
+            // The timing model's release delay when the replay finished:
+            int finalReleaseDelay = 0;
+
+            /**
+             * @brief  Gets the fraction of chords entered correctly.
+             *
+             * @return  The accuracy, from zero to one.
+             */
+            double getAccuracy() const;
+        };
+
+        /**
+         * @brief  Replays a session file using a release timing model.
+         *
+         *  Throughput assumes that each misread chord costs the user the time
+         * needed to enter two average chords: one to delete the misread
+         * chord, and one to enter it again.
+         *
+         * @param sessionFile    A file saved by Input::SessionRecorder.
+         *
+         * @param releaseTiming  The timing model to score. Adaptive models
+         *                       will be updated as the session is replayed.
+         *
+         * @param rolloverMode   Whether new chords may begin before the last
+         *                       chord is fully released.
+         *
+         * @return               The replay's accuracy and throughput.
+         */
+        Score replay(const juce::File& sessionFile,
+                ReleaseTiming& releaseTiming, const bool rolloverMode);
+    }
+}
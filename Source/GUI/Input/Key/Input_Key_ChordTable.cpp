@@ -0,0 +1,108 @@
+#include "Input_Key_ChordTable.h"
+#include "Input_Key_ConfigFile.h"
+#include "Input_Key_JSONKeys.h"
+#include <cstring>
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Input::Key::ChordTable::";
+#endif
+
+
+// Builds the table from the current key bindings.
+Input::Key::ChordTable::ChordTable()
+{
+    rebuild();
+}
+
+
+// Reloads all chord key bindings, replacing the table's contents.
+void Input::Key::ChordTable::rebuild()
+{
+    std::memset(charKeyIndices, -1, sizeof(charKeyIndices));
+    extendedKeyIndices.clear();
+    ConfigFile keyConfig;
+    const int chordKeyCount = JSONKeys::chordKeys.size();
+    jassert(chordKeyCount <= maxChordKeys);
+    for (int i = 0; i < maxChordKeys; i++)
+    {
+        keyCodes[i] = 0;
+        modifierFlags[i] = 0;
+        if (i >= chordKeyCount)
+        {
+            continue;
+        }
+        const juce::KeyPress boundKey
+                = keyConfig.getBoundKey(*JSONKeys::chordKeys[i]);
+        if (! boundKey.isValid())
+        {
+            DBG(dbgPrefix << __func__ << ": No valid key bound to chord key "
+                    << JSONKeys::chordKeys[i]->toString());
+            continue;
+        }
+        keyCodes[i] = boundKey.getKeyCode();
+        modifierFlags[i] = boundKey.getModifiers().getRawFlags();
+        const int tableKeyCode = getTableKeyCode(keyCodes[i]);
+        if (tableKeyCode >= 0 && tableKeyCode <= maxCharKeyCode)
+        {
+            charKeyIndices[tableKeyCode] = (juce::int8) i;
+        }
+        else
+        {
+            extendedKeyIndices[tableKeyCode] = (juce::int8) i;
+        }
+    }
+}
+
+
+// Finds the chord key index bound to a key press.
+int Input::Key::ChordTable::getKeyIndex(const juce::KeyPress& key) const
+{
+    const int keyIndex = getKeyIndex(key.getKeyCode());
+    if (keyIndex < 0
+            || key.getModifiers().getRawFlags() != modifierFlags[keyIndex])
+    {
+        return -1;
+    }
+    return keyIndex;
+}
+
+
+// Finds the chord key index bound to a key code, ignoring modifiers.
+int Input::Key::ChordTable::getKeyIndex(const int keyCode) const
+{
+    const int tableKeyCode = getTableKeyCode(keyCode);
+    if (tableKeyCode >= 0 && tableKeyCode <= maxCharKeyCode)
+    {
+        return charKeyIndices[tableKeyCode];
+    }
+    const auto match = extendedKeyIndices.find(tableKeyCode);
+    if (match == extendedKeyIndices.end())
+    {
+        return -1;
+    }
+    return match->second;
+}
+
+
+// Gets the key code bound to a chord key.
+int Input::Key::ChordTable::getKeyCode(const int keyIndex) const
+{
+    if (keyIndex < 0 || keyIndex >= maxChordKeys)
+    {
+        return 0;
+    }
+    return keyCodes[keyIndex];
+}
+
+
+// Gets the key code used to store a key within the table.
+int Input::Key::ChordTable::getTableKeyCode(const int keyCode)
+{
+    if (keyCode >= 0 && keyCode <= maxCharKeyCode)
+    {
+        return (int) juce::CharacterFunctions::toLowerCase(
+                (juce::juce_wchar) keyCode);
+    }
+    return keyCode;
+}
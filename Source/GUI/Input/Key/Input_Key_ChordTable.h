@@ -0,0 +1,101 @@
+#pragma once
+/**
+ * @file  Input_Key_ChordTable.h
+ *
+ * @brief  Maps key codes directly to the chord key indices bound to them.
+ */
+
+#include "JuceHeader.h"
+#include <unordered_map>
+
+namespace Input { namespace Key { class ChordTable; } }
+
+/**
+ * @brief  A precompiled lookup table that finds which chord input key, if any,
+ *         a key code is bound to.
+ *
+ *  ChordTable reads every chord key binding from Input::Key::ConfigFile once.
+ * Character key codes are stored in a flat array indexed by key code, and all
+ * other key codes are stored in a hash table, so finding a key's chord index
+ * never searches the list of chord keys, allocates memory, or locks the key
+ * binding resource.
+ *
+ *  Like juce::KeyPress equality checks, lookups ignore the case of character
+ * key codes. The table must be rebuilt whenever key bindings change.
+ */
+class Input::Key::ChordTable
+{
+public:
+    /**
+     * @brief  Builds the table from the current key bindings.
+     */
+    ChordTable();
+
+    virtual ~ChordTable() { }
+
+    /**
+     * @brief  Reloads all chord key bindings, replacing the table's contents.
+     */
+    void rebuild();
+
+    /**
+     * @brief  Finds the chord key index bound to a key press.
+     *
+     * @param key  A key press event.
+     *
+     * @return     The index of the chord key bound to the key press, or -1 if
+     *             the key code isn't bound to a chord key or the key press
+     *             modifiers don't match the binding.
+     */
+    int getKeyIndex(const juce::KeyPress& key) const;
+
+    /**
+     * @brief  Finds the chord key index bound to a key code, ignoring
+     *         modifiers.
+     *
+     * @param keyCode  A JUCE key code.
+     *
+     * @return         The index of the chord key bound to the key code, or -1
+     *                 if the key code isn't bound to a chord key.
+     */
+    int getKeyIndex(const int keyCode) const;
+
+    /**
+     * @brief  Gets the key code bound to a chord key.
+     *
+     * @param keyIndex  A valid chord key index.
+     *
+     * @return          The bound key code, or zero if the chord key has no
+     *                  valid binding.
+     */
+    int getKeyCode(const int keyIndex) const;
+
+    // The largest number of chord keys the table can hold:
+    static const constexpr int maxChordKeys = 8;
+
+private:
+    /**
+     * @brief  Gets the key code used to store a key within the table.
+     *
+     * @param keyCode  A JUCE key code.
+     *
+     * @return         The key code, converted to lower case if it represents a
+     *                 character.
+     */
+    static int getTableKeyCode(const int keyCode);
+
+    // Largest key code stored in the flat character key array:
+    static const constexpr int maxCharKeyCode = 255;
+
+    // Chord key indices for each character key code, or -1 for unbound keys:
+    juce::int8 charKeyIndices[maxCharKeyCode + 1];
+    // Chord key indices for all bound non-character key codes:
+    std::unordered_map<int, juce::int8> extendedKeyIndices;
+
+    // Bound key codes for each chord key index:
+    int keyCodes[maxChordKeys] = { 0 };
+    // Bound raw modifier flags for each chord key index:
+    int modifierFlags[maxChordKeys] = { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChordTable)
+};
@@ -0,0 +1,120 @@
+#include "Input_Key_DispatchTable.h"
+#include "Input_Key_ConfigFile.h"
+#include "Input_Key_JSONKeys.h"
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Input::Key::DispatchTable::";
+#endif
+
+namespace JSONKeys = Input::Key::JSONKeys;
+
+// Binding IDs for each action, in Action order:
+static const juce::Identifier* bindingIDs[] =
+{
+    &JSONKeys::sendText,
+    &JSONKeys::backspace,
+    &JSONKeys::selectNextSet,
+    &JSONKeys::toggleShift,
+    &JSONKeys::clearAll,
+    &JSONKeys::closeAndSend,
+    &JSONKeys::close,
+    &JSONKeys::acceptSuggestion,
+    &JSONKeys::toggleImmediate,
+    &JSONKeys::showHelp,
+    &JSONKeys::toggleWindowEdge,
+    &JSONKeys::toggleMinimize,
+    &JSONKeys::selectMainSet,
+    &JSONKeys::selectAltSet,
+    &JSONKeys::selectSpecialSet,
+    &JSONKeys::selectModSet
+};
+static_assert(sizeof(bindingIDs) / sizeof(bindingIDs[0])
+        == (int) Input::Key::DispatchTable::Action::actionCount,
+        "Every action needs a binding ID!");
+
+// Largest key code that may be compared without case sensitivity:
+static const constexpr int maxCharKeyCode = 255;
+
+
+// Builds the table from the current key bindings.
+Input::Key::DispatchTable::DispatchTable()
+{
+    rebuild();
+}
+
+
+// Reloads all key bindings, replacing the table's contents.
+void Input::Key::DispatchTable::rebuild()
+{
+    actionTable.clear();
+    ConfigFile keyConfig;
+    for (int i = 0; i < (int) Action::actionCount; i++)
+    {
+        const juce::KeyPress boundKey = keyConfig.getBoundKey(*bindingIDs[i]);
+        if (! boundKey.isValid())
+        {
+            DBG(dbgPrefix << __func__ << ": No valid key bound to action "
+                    << bindingIDs[i]->toString());
+            continue;
+        }
+        actionTable[getTableKey(boundKey.getKeyCode(),
+                boundKey.getModifiers().getRawFlags())] |= (1u << i);
+    }
+}
+
+
+// Finds all actions bound to a key press.
+juce::uint32 Input::Key::DispatchTable::getActionFlags
+(const juce::KeyPress& key) const
+{
+    juce::uint32 actionFlags = 0;
+    const int rawModifiers = key.getModifiers().getRawFlags();
+    const auto exactMatch = actionTable.find(getTableKey(key.getKeyCode(),
+                rawModifiers));
+    if (exactMatch != actionTable.end())
+    {
+        actionFlags |= exactMatch->second;
+    }
+    if (rawModifiers != 0)
+    {
+        const auto unmoddedMatch = actionTable.find(getTableKey(
+                    key.getKeyCode(), 0));
+        if (unmoddedMatch != actionTable.end())
+        {
+            actionFlags |= unmoddedMatch->second;
+        }
+    }
+    return actionFlags;
+}
+
+
+// Checks if an action is included in a set of action flags.
+bool Input::Key::DispatchTable::hasAction
+(const juce::uint32 actionFlags, const Action action)
+{
+    return (actionFlags & (1u << (int) action)) != 0;
+}
+
+
+// Gets the key binding ID used to load an action's key from the key binding
+// configuration file.
+const juce::Identifier& Input::Key::DispatchTable::getBindingID
+(const Action action)
+{
+    jassert(action != Action::actionCount);
+    return *bindingIDs[(int) action];
+}
+
+
+// Gets the hash table key used to store a key press.
+juce::int64 Input::Key::DispatchTable::getTableKey
+(const int keyCode, const int modifierFlags)
+{
+    const int tableKeyCode = (keyCode >= 0 && keyCode <= maxCharKeyCode)
+            ? (int) juce::CharacterFunctions::toLowerCase(
+                (juce::juce_wchar) keyCode)
+            : keyCode;
+    return ((juce::int64) modifierFlags << 32)
+            | (juce::int64) (juce::uint32) tableKeyCode;
+}
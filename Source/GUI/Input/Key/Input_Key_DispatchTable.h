@@ -0,0 +1,123 @@
+#pragma once
+/**
+ * @file  Input_Key_DispatchTable.h
+ *
+ * @brief  Maps key press events directly to the control actions bound to
+ *         them.
+ */
+
+#include "JuceHeader.h"
+#include <unordered_map>
+
+namespace Input { namespace Key { class DispatchTable; } }
+
+/**
+ * @brief  A precompiled lookup table that finds all control actions bound to a
+ *         key press.
+ *
+ *  DispatchTable reads every control key binding from Input::Key::ConfigFile
+ * once, storing each bound key in a hash table. Finding the actions for a key
+ * press then takes two hash lookups, without locking the key binding resource
+ * or allocating memory.
+ *
+ *  Key press lookups match the Input::Controller's original binding rules: a
+ * binding applies to a key press if the bound key matches the key press
+ * exactly, or if it matches the key press with all modifiers removed. When
+ * several bindings apply to the same key press, all of their actions are
+ * returned.
+ *
+ *  The table must be rebuilt whenever key bindings change. The
+ * Input::Controller rebuilds its table each time the resident window is shown
+ * again. Chord keys aren't included, as they are handled by the
+ * Input::ChordReader.
+ */
+class Input::Key::DispatchTable
+{
+public:
+    /**
+     * @brief  All control actions that may be bound to keys.
+     */
+    enum class Action
+    {
+        sendText,
+        backspace,
+        selectNextSet,
+        toggleShift,
+        clearAll,
+        closeAndSend,
+        close,
+        acceptSuggestion,
+        toggleImmediate,
+        showHelp,
+        toggleWindowEdge,
+        toggleMinimize,
+        selectMainSet,
+        selectAltSet,
+        selectSpecialSet,
+        selectModSet,
+        actionCount
+    };
+
+    /**
+     * @brief  Builds the table from the current key bindings.
+     */
+    DispatchTable();
+
+    virtual ~DispatchTable() { }
+
+    /**
+     * @brief  Reloads all key bindings, replacing the table's contents.
+     */
+    void rebuild();
+
+    /**
+     * @brief  Finds all actions bound to a key press.
+     *
+     * @param key  A key press event.
+     *
+     * @return     A set of flags where each action bound to the key press has
+     *             the bit (1 << (int) action) set.
+     */
+    juce::uint32 getActionFlags(const juce::KeyPress& key) const;
+
+    /**
+     * @brief  Checks if an action is included in a set of action flags.
+     *
+     * @param actionFlags  A set of action flags returned by getActionFlags.
+     *
+     * @param action       The action to find.
+     *
+     * @return             Whether the action's flag is set.
+     */
+    static bool hasAction(const juce::uint32 actionFlags, const Action action);
+
+    /**
+     * @brief  Gets the key binding ID used to load an action's key from the
+     *         key binding configuration file.
+     *
+     * @param action  Any action besides Action::actionCount.
+     *
+     * @return        The action's Input::Key::JSONKeys identifier.
+     */
+    static const juce::Identifier& getBindingID(const Action action);
+
+private:
+    /**
+     * @brief  Gets the hash table key used to store a key press.
+     *
+     *  Like juce::KeyPress equality checks, this ignores text characters and
+     * the case of character key codes.
+     *
+     * @param keyCode        The key press's key code.
+     *
+     * @param modifierFlags  The key press's raw modifier flags.
+     *
+     * @return               A value unique to that key code and modifier set.
+     */
+    static juce::int64 getTableKey(const int keyCode, const int modifierFlags);
+
+    // Action flags for every bound key press:
+    std::unordered_map<juce::int64, juce::uint32> actionTable;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DispatchTable)
+};
@@ -34,6 +34,8 @@ namespace Input { namespace Key { namespace JSONKeys
             "Close and send");
     static const juce::Identifier close(
             "Close");
+    static const juce::Identifier acceptSuggestion(
+            "Accept suggestion");
 
     // Misc. control keys:
     static const juce::Identifier toggleImmediate(
@@ -69,6 +71,7 @@ namespace Input { namespace Key { namespace JSONKeys
         &clearAll,
         &closeAndSend,
         &close,
+        &acceptSuggestion,
         &toggleImmediate,
         &showHelp,
         &toggleWindowEdge,
@@ -27,6 +27,10 @@ int Output::Buffer::getModifierFlags() const
 void Output::Buffer::appendCharacter(const Text::CharValue outputChar)
 {
     bufferedText.add(outputChar);
+    for (Listener* listener : listeners)
+    {
+        listener->characterAppended(outputChar);
+    }
 }
 
 
@@ -40,7 +44,15 @@ void Output::Buffer::setModifiers(const int modifierFlags)
 // Removes the last character from the end of the output string.
 void Output::Buffer::deleteLastChar()
 {
+    if (bufferedText.isEmpty())
+    {
+        return;
+    }
     bufferedText.removeLast();
+    for (Listener* listener : listeners)
+    {
+        listener->lastCharDeleted(bufferedText);
+    }
 }
 
 
@@ -52,6 +64,10 @@ void Output::Buffer::clear(const bool clearModifiers)
     {
         keyModifiers = 0;
     }
+    for (Listener* listener : listeners)
+    {
+        listener->bufferCleared();
+    }
 }
 
 
@@ -60,3 +76,17 @@ bool Output::Buffer::isEmpty() const
 {
     return bufferedText.isEmpty();
 }
+
+
+// Adds a listener to the list of registered listeners.
+void Output::Buffer::addListener(Listener* listener)
+{
+    listeners.addIfNotAlreadyThere(listener);
+}
+
+
+// Removes a listener from the list of registered listeners.
+void Output::Buffer::removeListener(Listener* listener)
+{
+    listeners.removeAllInstancesOf(listener);
+}
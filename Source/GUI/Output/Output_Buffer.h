@@ -14,6 +14,10 @@ namespace Output { class Buffer; }
  * @brief  Unless immediate mode is enabled, all keyboard input is cached within
  *         this object until the user chooses to forward the input to the target
  *         window.
+ *
+ *  Listener objects may register with the Buffer to follow each change to the
+ * buffered text as it happens, without needing to read the entire buffer after
+ * every change.
  */
 class Output::Buffer
 {
@@ -72,9 +76,60 @@ public:
      */
     bool isEmpty() const;
 
+    /**
+     * @brief  Receives updates whenever the buffered text changes.
+     */
+    class Listener
+    {
+    public:
+        Listener() { }
+
+        virtual ~Listener() { }
+
+        friend class Buffer;
+
+    private:
+        /**
+         * @brief  Notifies the Listener that a character was added to the end
+         *         of the buffered text.
+         *
+         * @param outputChar  The added character.
+         */
+        virtual void characterAppended(const Text::CharValue outputChar) = 0;
+
+        /**
+         * @brief  Notifies the Listener that the last character was removed
+         *         from the buffered text.
+         *
+         * @param bufferedText  The remaining buffered text.
+         */
+        virtual void lastCharDeleted(const Text::CharString& bufferedText) = 0;
+
+        /**
+         * @brief  Notifies the Listener that all buffered text was removed.
+         */
+        virtual void bufferCleared() = 0;
+    };
+
+    /**
+     * @brief  Adds a listener to the list of registered listeners.
+     *
+     * @param listener  An object that will receive buffer updates.
+     */
+    void addListener(Listener* listener);
+
+    /**
+     * @brief  Removes a listener from the list of registered listeners.
+     *
+     * @param listener  The object that will no longer receive updates.
+     */
+    void removeListener(Listener* listener);
+
 private:
     // Buffered text/keys:
     Text::CharString bufferedText;
     // Combined key modifier flags, as defined in Output::Modifiers.
     int keyModifiers = 0;
+    // All objects receiving buffer updates:
+    juce::Array<Listener*> listeners;
 };
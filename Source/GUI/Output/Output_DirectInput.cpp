@@ -0,0 +1,94 @@
+#include "Output_DirectInput.h"
+#include "Output_Modifiers.h"
+#include "Config_MainFile.h"
+#include "Windows_XInterface.h"
+#include "Text_Values.h"
+#include "JuceHeader.h"
+
+#ifdef JUCE_DEBUG
+// Print the full namespace name before all debug output:
+static const constexpr char* dbgPrefix = "Output::DirectInput::";
+#endif
+
+/**
+ * @brief  Gets the XInterface used to send all direct key events, so that a
+ *         new X display connection isn't opened for each key.
+ *
+ * @return  The shared XInterface object.
+ */
+static Windows::XInterface& getXInterface()
+{
+    static Windows::XInterface xInterface;
+    return xInterface;
+}
+
+
+/**
+ * @brief  Converts Output::Modifiers flags to X11 modifier state flags.
+ *
+ * @param modifierFlags  A combination of Output::Modifiers::TypeFlag values.
+ *
+ * @return               The equivalent combination of X11 modifier masks.
+ */
+static unsigned int getModifierMask(const int modifierFlags)
+{
+    namespace Modifiers = Output::Modifiers;
+    const std::pair<Modifiers::TypeFlag, unsigned int> modMasks [] =
+    {
+        { Modifiers::control, ControlMask },
+        { Modifiers::shift,   ShiftMask   },
+        { Modifiers::alt,     Mod1Mask    },
+        { Modifiers::super,   Mod4Mask    }
+    };
+    unsigned int modifierMask = 0;
+    for (const auto& modMask : modMasks)
+    {
+        if ((modifierFlags & (int) modMask.first) != 0)
+        {
+            modifierMask |= modMask.second;
+        }
+    }
+    return modifierMask;
+}
+
+
+// Checks if a window's class allows it to receive direct key input.
+bool Output::DirectInput::isAllowed(const int targetWindow)
+{
+    Config::MainFile mainConfig;
+    const juce::StringArray allowedClasses
+            = mainConfig.getDirectInputClasses();
+    if (allowedClasses.isEmpty())
+    {
+        return false;
+    }
+    const Windows::XInterface& xInterface = getXInterface();
+    const Window window = (Window) targetWindow;
+    return allowedClasses.contains(xInterface.getWindowClass(window), true)
+            || allowedClasses.contains(xInterface.getWindowClassName(window),
+                    true);
+}
+
+
+// Sends a single key directly to a window.
+bool Output::DirectInput::sendKey(const Text::CharValue keyValue,
+        const int modifierFlags, const int targetWindow)
+{
+    // XStringToKeysym accepts both KeySym names and "0x" prefixed KeySym
+    // values, so both types of X string are handled here:
+    const juce::String keyString = Text::Values::getXString(keyValue);
+    if (keyString.isEmpty())
+    {
+        DBG(dbgPrefix << __func__ << ": Invalid key value " << (int) keyValue);
+        return false;
+    }
+    const KeySym keySym = XStringToKeysym(keyString.toRawUTF8());
+    if (keySym == NoSymbol)
+    {
+        DBG(dbgPrefix << __func__ << ": No KeySym for key string "
+                << keyString);
+        return false;
+    }
+    return getXInterface().sendKeyEvent((Window) targetWindow, keySym,
+            getModifierMask(modifierFlags));
+}
@@ -0,0 +1,52 @@
+#pragma once
+/**
+ * @file  Output_DirectInput.h
+ *
+ * @brief  Sends key events directly to a target window without changing
+ *         window focus.
+ */
+
+#include "Text_CharTypes.h"
+
+namespace Output
+{
+    /**
+     * @brief  Delivers synthetic key events straight to the target window.
+     *
+     *  Sending keys this way skips the focus changes and window repositioning
+     * needed by the other output methods. Many applications ignore synthetic
+     * key events, so direct input is only used with windows whose class is
+     * listed under "directInputClasses" in the main configuration file.
+     */
+    namespace DirectInput
+    {
+        /**
+         * @brief  Checks if a window's class allows it to receive direct key
+         *         input.
+         *
+         * @param targetWindow  The ID of a window that will receive key input.
+         *
+         * @return              Whether the window class or class name is found
+         *                      in the configured direct input class list.
+         */
+        bool isAllowed(const int targetWindow);
+
+        /**
+         * @brief  Sends a single key directly to a window.
+         *
+         * @param keyValue       A key value to type.
+         *
+         * @param modifierFlags  Modifier flags to apply to the key, as defined
+         *                       in Output::Modifiers.
+         *
+         * @param targetWindow   The ID of the window that will receive the key.
+         *
+         * @return               Whether the key events were sent. This will
+         *                       return false if the key value has no X11
+         *                       KeySym, or if its KeySym isn't mapped to any
+         *                       keycode.
+         */
+        bool sendKey(const Text::CharValue keyValue, const int modifierFlags,
+                const int targetWindow);
+    }
+}
@@ -0,0 +1,51 @@
+#include "Output_KeyQueue.h"
+
+static_assert((Output::KeyQueue::capacity & (Output::KeyQueue::capacity - 1))
+        == 0, "Output::KeyQueue capacity must be a power of two!");
+
+// Converts an event count to an index in the event buffer:
+static const constexpr juce::uint32 indexMask = Output::KeyQueue::capacity - 1;
+
+
+// Adds an event to the end of the queue.
+bool Output::KeyQueue::push(const Event& event)
+{
+    const juce::uint32 writePos = writeCount.get();
+    if ((writePos - readCount.get()) >= (juce::uint32) capacity)
+    {
+        return false;
+    }
+    events[writePos & indexMask] = event;
+    // The event must be stored before the consumer can see the new count:
+    writeCount.set(writePos + 1);
+    return true;
+}
+
+
+// Removes the event at the front of the queue.
+bool Output::KeyQueue::pop(Event& event)
+{
+    const juce::uint32 readPos = readCount.get();
+    if (readPos == writeCount.get())
+    {
+        return false;
+    }
+    event = events[readPos & indexMask];
+    // The event must be copied before the producer may replace it:
+    readCount.set(readPos + 1);
+    return true;
+}
+
+
+// Gets the number of events currently in the queue.
+int Output::KeyQueue::size() const
+{
+    return (int) (writeCount.get() - readCount.get());
+}
+
+
+// Gets the number of events that may still be added to the queue.
+int Output::KeyQueue::freeSpace() const
+{
+    return capacity - size();
+}
@@ -0,0 +1,95 @@
+#pragma once
+/**
+ * @file  Output_KeyQueue.h
+ *
+ * @brief  Passes key events waiting to be sent from one thread to another
+ *         without locking.
+ */
+
+#include "Text_CharTypes.h"
+#include "JuceHeader.h"
+
+namespace Output { class KeyQueue; }
+
+/**
+ * @brief  A fixed-size, lock-free, single-producer single-consumer queue of
+ *         key events.
+ *
+ *  Exactly one thread may add events to the queue, and exactly one other
+ * thread may remove them. Events are removed in the same order that they were
+ * added.
+ */
+class Output::KeyQueue
+{
+public:
+    // Maximum number of events the queue can hold, always a power of two:
+    static const constexpr int capacity = 256;
+
+    /**
+     * @brief  A single queued key event.
+     */
+    struct Event
+    {
+        // The key value to send:
+        Text::CharValue keyValue = 0;
+        // Modifier flags to apply to the key, as defined in Output::Modifiers:
+        int modifierFlags = 0;
+        // The ID of the window where the key should be sent:
+        int targetWindow = 0;
+        // Whether this is the last event in a group of keys that should be
+        // sent together:
+        bool endsGroup = true;
+        // The high resolution tick count when the event was queued:
+        juce::int64 queuedTicks = 0;
+    };
+
+    KeyQueue() { }
+
+    virtual ~KeyQueue() { }
+
+    /**
+     * @brief  Adds an event to the end of the queue. This should only be
+     *         called by the producer thread.
+     *
+     * @param event  The event to add.
+     *
+     * @return       Whether the event was added, or false if the queue was
+     *               full.
+     */
+    bool push(const Event& event);
+
+    /**
+     * @brief  Removes the event at the front of the queue. This should only be
+     *         called by the consumer thread.
+     *
+     * @param event  An event object that will be set to the removed event's
+     *               value.
+     *
+     * @return       Whether an event was removed, or false if the queue was
+     *               empty.
+     */
+    bool pop(Event& event);
+
+    /**
+     * @brief  Gets the number of events currently in the queue.
+     *
+     * @return  The queue depth. This may already be outdated if either thread
+     *          is acting on the queue.
+     */
+    int size() const;
+
+    /**
+     * @brief  Gets the number of events that may still be added to the queue.
+     *
+     * @return  The number of unused event slots.
+     */
+    int freeSpace() const;
+
+private:
+    // Queued event storage, used as a circular buffer:
+    Event events[capacity];
+    // Total number of events ever removed, only changed by the consumer:
+    juce::Atomic<juce::uint32> readCount;
+    // Total number of events ever added, only changed by the producer:
+    juce::Atomic<juce::uint32> writeCount;
+};
@@ -0,0 +1,260 @@
+#include "Output_Sender.h"
+#include "Output_Sending.h"
+#include "Config_MainFile.h"
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Output::Sender::";
+#endif
+
+// Milliseconds to wait for the sender thread to exit before killing it:
+static const constexpr int threadExitTimeout = 3000;
+
+
+/**
+ * @brief  Gets the configured time to wait for more keys before sending output.
+ *
+ * @return  The output coalesce time in milliseconds.
+ */
+static int getConfiguredCoalesceTime()
+{
+    Config::MainFile mainConfig;
+    return std::max(0, mainConfig.getOutputCoalesceTime());
+}
+
+
+// Starts the sender thread.
+Output::Sender::Sender(const int targetWindow, const int coalesceTime) :
+    juce::Thread("Output::Sender"),
+    targetWindow(targetWindow),
+    coalesceTime((coalesceTime < 0) ? getConfiguredCoalesceTime()
+            : coalesceTime)
+{
+    startThread();
+}
+
+
+// Stops the sender thread, discarding any keys not yet sent.
+Output::Sender::~Sender()
+{
+    signalThreadShouldExit();
+    notify();
+    stopThread(threadExitTimeout);
+    DBG(dbgPrefix << __func__ << ": Sent " << counters.sentKeys
+            << " keys, peak queue depth " << counters.peakQueueDepth
+            << ", mean drain latency "
+            << juce::String(counters.meanDrainLatency, 2)
+            << "ms, max drain latency "
+            << juce::String(counters.maxDrainLatency, 2) << "ms");
+    if (counters.sentKeys > 0)
+    {
+        // Without batching, every key would need two focus switches:
+        const double switchesPerKey = 2.0 * counters.sentBatches
+                / counters.sentKeys;
+        DBG(dbgPrefix << __func__ << ": Sent keys in " << counters.sentBatches
+                << " batches, using up to "
+                << juce::String(switchesPerKey, 2)
+                << " focus switches per key, saving up to "
+                << juce::String(2.0 - switchesPerKey, 2));
+    }
+}
+
+
+// Queues a single key to send to the target window.
+void Output::Sender::queueKey(const Text::CharValue keyValue,
+        const int modifierFlags)
+{
+    KeyQueue::Event event;
+    event.keyValue = keyValue;
+    event.modifierFlags = modifierFlags;
+    event.targetWindow = targetWindow;
+    event.queuedTicks = juce::Time::getHighResolutionTicks();
+    pushEvent(event);
+    notify();
+}
+
+
+// Queues a string of text to send to the target window as a single group.
+void Output::Sender::queueText(const Text::CharString& text,
+        const int modifierFlags)
+{
+    if (text.isEmpty())
+    {
+        return;
+    }
+    KeyQueue::Event event;
+    event.modifierFlags = modifierFlags;
+    event.targetWindow = targetWindow;
+    event.queuedTicks = juce::Time::getHighResolutionTicks();
+    for (int i = 0; i < text.size(); i++)
+    {
+        event.keyValue = text[i];
+        event.endsGroup = (i == (text.size() - 1));
+        pushEvent(event);
+    }
+    notify();
+}
+
+
+// Changes the window where keys queued from now on will be sent.
+void Output::Sender::setTargetWindow(const int newTarget)
+{
+    targetWindow = newTarget;
+}
+
+
+// Runs a function on the message thread once all keys queued so far have been
+// sent.
+void Output::Sender::callWhenDrained(const std::function<void()> callback)
+{
+    const juce::ScopedLock callbackLock(sendLock);
+    drainCallback = callback;
+    notify();
+}
+
+
+// Gets the current queue performance counters.
+Output::Sender::Counters Output::Sender::getCounters() const
+{
+    const juce::ScopedLock counterLock(sendLock);
+    Counters currentCounters = counters;
+    currentCounters.queueDepth = keyQueue.size() + overflowEvents.size()
+            - overflowReadIndex;
+    return currentCounters;
+}
+
+
+// Waits for queued keys, sending them as they become available.
+void Output::Sender::run()
+{
+    // Dequeued keys waiting to be sent together:
+    Text::CharString batchText;
+    juce::Array<juce::int64> batchTicks;
+    int batchModifiers = 0;
+    int batchTarget = 0;
+    // Whether the last key in the batch ended its group:
+    bool batchComplete = true;
+    while (! threadShouldExit())
+    {
+        KeyQueue::Event event;
+        while (! threadShouldExit() && popEvent(event))
+        {
+            // Keys with different modifiers or target windows can't be sent
+            // together:
+            if (! batchText.isEmpty() && (event.modifierFlags != batchModifiers
+                        || event.targetWindow != batchTarget))
+            {
+                sendBatch(batchText, batchModifiers, batchTarget, batchTicks);
+                batchText.clearQuick();
+                batchTicks.clearQuick();
+            }
+            batchText.add(event.keyValue);
+            batchTicks.add(event.queuedTicks);
+            batchModifiers = event.modifierFlags;
+            batchTarget = event.targetWindow;
+            batchComplete = event.endsGroup;
+        }
+        if (batchText.isEmpty())
+        {
+            std::function<void()> callback;
+            {
+                const juce::ScopedLock callbackLock(sendLock);
+                callback.swap(drainCallback);
+            }
+            if (callback)
+            {
+                juce::MessageManager::callAsync(callback);
+            }
+            wait(-1);
+            continue;
+        }
+        if (! batchComplete)
+        {
+            // The rest of the group is still being queued:
+            wait(-1);
+            continue;
+        }
+        // Wait for more keys until the first key has waited long enough:
+        const double waitedMs = 1000.0
+                * juce::Time::highResolutionTicksToSeconds(
+                    juce::Time::getHighResolutionTicks() - batchTicks[0]);
+        const int remainingMs = coalesceTime - (int) waitedMs;
+        if (remainingMs > 0)
+        {
+            wait(remainingMs);
+            continue;
+        }
+        sendBatch(batchText, batchModifiers, batchTarget, batchTicks);
+        batchText.clearQuick();
+        batchTicks.clearQuick();
+    }
+}
+
+
+// Sends a batch of dequeued keys, and updates latency counters.
+void Output::Sender::sendBatch(const Text::CharString& text,
+        const int modifierFlags, const int targetWindow,
+        const juce::Array<juce::int64>& queuedTicks)
+{
+    Sending::sendText(text, modifierFlags, targetWindow);
+    const juce::int64 sentTicks = juce::Time::getHighResolutionTicks();
+    const juce::ScopedLock counterLock(sendLock);
+    for (const juce::int64& ticks : queuedTicks)
+    {
+        const double latency = 1000.0
+                * juce::Time::highResolutionTicksToSeconds(sentTicks - ticks);
+        totalDrainLatency += latency;
+        counters.maxDrainLatency = std::max(counters.maxDrainLatency,
+                latency);
+    }
+    counters.sentKeys += queuedTicks.size();
+    counters.sentBatches++;
+    counters.meanDrainLatency = totalDrainLatency / counters.sentKeys;
+}
+
+
+// Adds an event to the key queue, or to the overflow list if the key queue is
+// full or overflow events are still waiting, and records the new queue depth.
+void Output::Sender::pushEvent(const KeyQueue::Event& event)
+{
+    const juce::ScopedLock queueLock(sendLock);
+    // Keys can't go in the key queue while older keys are in the overflow
+    // list, or they would be sent first:
+    if (overflowReadIndex < overflowEvents.size() || ! keyQueue.push(event))
+    {
+        overflowEvents.add(event);
+    }
+    const int queueDepth = keyQueue.size() + overflowEvents.size()
+            - overflowReadIndex;
+    counters.peakQueueDepth = std::max(counters.peakQueueDepth, queueDepth);
+}
+
+
+// Removes the oldest waiting event from the key queue, or from the overflow
+// list once the key queue is empty.
+bool Output::Sender::popEvent(KeyQueue::Event& event)
+{
+    if (keyQueue.pop(event))
+    {
+        return true;
+    }
+    const juce::ScopedLock queueLock(sendLock);
+    // Keys added to the key queue since the last check are older than any
+    // overflow keys, so check again while no keys can be added:
+    if (keyQueue.pop(event))
+    {
+        return true;
+    }
+    if (overflowReadIndex >= overflowEvents.size())
+    {
+        return false;
+    }
+    event = overflowEvents.getReference(overflowReadIndex);
+    overflowReadIndex++;
+    if (overflowReadIndex == overflowEvents.size())
+    {
+        overflowEvents.clearQuick();
+        overflowReadIndex = 0;
+    }
+    return true;
+}
@@ -0,0 +1,195 @@
+#pragma once
+/**
+ * @file  Output_Sender.h
+ *
+ * @brief  Sends queued key events to the target window on a dedicated thread.
+ */
+
+#include "Output_KeyQueue.h"
+#include "Text_CharTypes.h"
+#include "JuceHeader.h"
+#include <functional>
+
+namespace Output { class Sender; }
+
+/**
+ * @brief  Accepts key events from the message thread, and sends them to the
+ *         target window in order on its own thread.
+ *
+ *  Sending a key to the target window may take a long time, especially when
+ * window focus needs to change. Queuing keys through the Sender lets the
+ * application keep accepting chord input while earlier keys are still being
+ * sent. Each queued key keeps the modifier flags that were active when it was
+ * queued.
+ *
+ *  Keys that are queued close together are sent together, so the target
+ * window only needs to be focused once for the whole batch. Once the first key
+ * in a batch is queued, the Sender waits for the configured output coalesce
+ * time before sending it, and any keys queued while a batch is being sent are
+ * added to the next batch.
+ *
+ *  Keys normally pass to the sender thread through a lock-free KeyQueue. When
+ * more keys are waiting than the KeyQueue can hold, the rest wait in an
+ * overflow list until the KeyQueue is empty, so any amount of text may be
+ * queued at once.
+ *
+ *  The target window may be changed while keys are queued. Keys are always
+ * sent to the window that was the target when they were queued.
+ *
+ *  Only one thread may queue key events or change the target window, normally
+ * the JUCE message thread.
+ */
+class Output::Sender : private juce::Thread
+{
+public:
+    /**
+     * @brief  Performance counters describing the Sender's queue.
+     */
+    struct Counters
+    {
+        // Number of keys currently waiting to be sent:
+        int queueDepth = 0;
+        // Largest number of keys that have been waiting at once:
+        int peakQueueDepth = 0;
+        // Total number of keys sent:
+        int sentKeys = 0;
+        // Number of batches sent, each needing at most one focus change:
+        int sentBatches = 0;
+        // Average milliseconds between queuing a key and finishing sending it:
+        double meanDrainLatency = 0;
+        // Longest time in milliseconds between queuing a key and finishing
+        // sending it:
+        double maxDrainLatency = 0;
+    };
+
+    /**
+     * @brief  Starts the sender thread.
+     *
+     * @param targetWindow  The ID of the window where all keys will be sent.
+     *
+     * @param coalesceTime  Milliseconds to wait for more keys after a key is
+     *                      queued before sending it, or -1 to use the time
+     *                      set in the main configuration file.
+     */
+    Sender(const int targetWindow, const int coalesceTime = -1);
+
+    /**
+     * @brief  Stops the sender thread, discarding any keys not yet sent.
+     *
+     *  Once told to exit, the sender thread stops waiting for the message
+     * thread to change window focus, so the Sender may be safely destroyed on
+     * the message thread while keys are being sent.
+     */
+    virtual ~Sender();
+
+    /**
+     * @brief  Queues a single key to send to the target window.
+     *
+     * @param keyValue       A key value to type.
+     *
+     * @param modifierFlags  Modifier flags to apply to the key, as defined in
+     *                       Output::Modifiers.
+     */
+    void queueKey(const Text::CharValue keyValue, const int modifierFlags);
+
+    /**
+     * @brief  Queues a string of text to send to the target window as a
+     *         single group.
+     *
+     * @param text           The text to send.
+     *
+     * @param modifierFlags  Modifier flags to apply to each key, as defined in
+     *                       Output::Modifiers.
+     */
+    void queueText(const Text::CharString& text, const int modifierFlags);
+
+    /**
+     * @brief  Changes the window where keys queued from now on will be sent.
+     *
+     * @param newTarget  The ID of the window where new keys will be sent.
+     */
+    void setTargetWindow(const int newTarget);
+
+    /**
+     * @brief  Runs a function on the message thread once all keys queued so
+     *         far have been sent.
+     *
+     * @param callback  The function to run. This replaces any earlier callback
+     *                  that hasn't run yet.
+     */
+    void callWhenDrained(const std::function<void()> callback);
+
+    /**
+     * @brief  Gets the current queue performance counters.
+     *
+     * @return  The counter values.
+     */
+    Counters getCounters() const;
+
+private:
+    /**
+     * @brief  Waits for queued keys, sending them as they become available.
+     */
+    void run() override;
+
+    /**
+     * @brief  Sends a batch of dequeued keys, and updates latency counters.
+     *
+     * @param text           The batch text.
+     *
+     * @param modifierFlags  Modifier flags to apply to each key.
+     *
+     * @param targetWindow   The ID of the window where the keys are sent.
+     *
+     * @param queuedTicks    The high resolution tick count when each key was
+     *                       queued.
+     */
+    void sendBatch(const Text::CharString& text, const int modifierFlags,
+            const int targetWindow,
+            const juce::Array<juce::int64>& queuedTicks);
+
+    /**
+     * @brief  Adds an event to the key queue, or to the overflow list if the
+     *         key queue is full or overflow events are still waiting, and
+     *         records the new queue depth.
+     *
+     * @param event  The key event to queue.
+     */
+    void pushEvent(const KeyQueue::Event& event);
+
+    /**
+     * @brief  Removes the oldest waiting event from the key queue, or from the
+     *         overflow list once the key queue is empty.
+     *
+     * @param event  Set to the removed event.
+     *
+     * @return       Whether an event was removed, or false if no events were
+     *               waiting.
+     */
+    bool popEvent(KeyQueue::Event& event);
+
+    // The ID of the window where newly queued keys will be sent. This is only
+    // used by the thread queuing keys.
+    int targetWindow;
+    // Milliseconds to wait for more keys before sending a batch:
+    const int coalesceTime;
+    // Holds keys waiting to be sent:
+    KeyQueue keyQueue;
+    // Holds keys that didn't fit in the key queue. While this holds any keys,
+    // new keys are added here instead of the key queue, so every overflow key
+    // is newer than all keys in the key queue.
+    juce::Array<KeyQueue::Event> overflowEvents;
+    // Index of the next overflow event to send:
+    int overflowReadIndex = 0;
+    // A function to run once the queue is empty:
+    std::function<void()> drainCallback;
+    // Queue performance counters:
+    Counters counters;
+    // Total milliseconds spent waiting by all sent keys:
+    double totalDrainLatency = 0;
+    // Protects the drain callback, counters, and overflow list, and keeps the
+    // key queue from changing between checks for overflow events:
+    juce::CriticalSection sendLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Sender)
+};
@@ -1,10 +1,17 @@
 #include "Output_Sending.h"
 #include "Application.h"
 #include "Output_Modifiers.h"
+#include "Output_XTest.h"
+#include "Output_DirectInput.h"
+#include "Config_MainFile.h"
 #include "Windows_XInterface.h"
 #include "Windows_FocusControl.h"
 #include "Text_Values.h"
 
+#ifdef INCLUDE_TESTING
+#include "Debug_ScopeTimer.h"
+#endif
+
 /**
  * @brief  The set of Application::WindowFlags values that should be applied to
  *         the application window before shifting focus to the target window and
@@ -22,11 +29,74 @@ static const constexpr int windowReadyForSending =
 // Commmand prefix used to transmit key presses to the focused window.
 static const juce::String keyCommand("xdotool key ");
 
+// Output method names used in the main configuration file:
+static const juce::String xdotoolMethodName("xdotool");
+static const juce::String xTestMethodName("xtest");
+
 // Print the full namespace name before all debug output:
 #ifdef JUCE_DEBUG
 static const constexpr char* dbgPrefix = "Input::Sending::";
 #endif
 
+// Milliseconds between checks for thread exit requests while waiting for the
+// message thread:
+static const constexpr int messageWaitPollTime = 50;
+// Message thread action states:
+static const constexpr int actionPending = 0;
+static const constexpr int actionStarted = 1;
+static const constexpr int actionCancelled = 2;
+
+/**
+ * @brief  Runs a function on the JUCE message thread, waiting for it to finish.
+ *
+ *  Window state and focus changes must happen on the message thread, but keys
+ * may be sent from any thread. Waiting stops if the calling thread is told to
+ * exit before the message thread starts the function, and the function is
+ * cancelled. This lets the message thread stop a thread sending keys without
+ * both threads waiting on each other.
+ *
+ * @param action  The function to run. If called from the message thread, this
+ *                will run immediately.
+ *
+ * @return        Whether the function ran, or false if it was cancelled.
+ */
+static bool runOnMessageThread(const std::function<void()> action)
+{
+    if (juce::MessageManager::getInstance()->isThisTheMessageThread())
+    {
+        action();
+        return true;
+    }
+    // Shared with the message thread, in case the action is cancelled before
+    // the message thread reaches it:
+    struct PendingAction
+    {
+        std::function<void()> action;
+        juce::Atomic<int> state { actionPending };
+        juce::WaitableEvent finished;
+    };
+    std::shared_ptr<PendingAction> pending = std::make_shared<PendingAction>();
+    pending->action = action;
+    juce::MessageManager::callAsync([pending]()
+    {
+        if (pending->state.compareAndSetBool(actionStarted, actionPending))
+        {
+            pending->action();
+            pending->finished.signal();
+        }
+    });
+    while (! pending->finished.wait(messageWaitPollTime))
+    {
+        if (juce::Thread::currentThreadShouldExit()
+                && pending->state.compareAndSetBool(actionCancelled,
+                    actionPending))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 /**
  * @brief  Ensures the application window is positioned so that it focus can be
  *         transferred to the target window, saving and returning the previous
@@ -149,22 +219,111 @@ static void runXCommand(const juce::String keyString)
 }
 
 
+// Gets the key event creation method selected in the main configuration file.
+Output::Sending::Method Output::Sending::getConfiguredMethod()
+{
+    Config::MainFile mainConfig;
+    const juce::String methodName = mainConfig.getOutputMethod();
+    if (methodName == xdotoolMethodName)
+    {
+        return Method::xdotool;
+    }
+    if (methodName != xTestMethodName)
+    {
+        DBG(dbgPrefix << __func__ << ": Unknown output method \"" << methodName
+                << "\", using " << xTestMethodName);
+    }
+    if (! XTest::isAvailable())
+    {
+        DBG(dbgPrefix << __func__
+                << ": XTest unavailable, falling back to xdotool.");
+        return Method::xdotool;
+    }
+    return Method::xTest;
+}
+
+
+// Types a single key into whichever window currently has keyboard focus,
+// without changing window focus.
+void Output::Sending::typeKey(const Text::CharValue keyValue,
+        const int modifierFlags, const Method method)
+{
+    if (method == Method::xTest && XTest::sendKey(keyValue, modifierFlags))
+    {
+        return;
+    }
+    runXCommand(getKeyString(keyValue,
+                Modifiers::getModString(modifierFlags)));
+}
+
+
 // Sends a single key press event to a window.
 void Output::Sending::sendKey(
         const Text::CharValue keyValue,
         const int modifierFlags,
         const int targetWindow)
 {
-    const int previousState = prepareAppWindow();
-    const juce::String modifiers = Modifiers::getModString(modifierFlags);
-    const bool focusedTarget = focusTarget(targetWindow);
+    Text::CharString keyText;
+    keyText.add(keyValue);
+    sendText(keyText, modifierFlags, targetWindow);
+}
+
+
+// Sends a string of text to a window, changing window focus no more than once.
+void Output::Sending::sendText(const Text::CharString& text,
+        const int modifierFlags, const int targetWindow)
+{
+    // Send as much as possible directly to the target window, only changing
+    // focus if a key can't be sent directly:
+    int sentCount = 0;
+    if (DirectInput::isAllowed(targetWindow))
+    {
+        while (sentCount < text.size() && DirectInput::sendKey(
+                    text[sentCount], modifierFlags, targetWindow))
+        {
+            sentCount++;
+        }
+    }
+    if (sentCount == text.size())
+    {
+        return;
+    }
+
+    #ifdef INCLUDE_TESTING
+    Debug::ScopeTimer focusCycleTimer("Output::Sending::sendText focus cycle");
+    #endif
+    const Method method = getConfiguredMethod();
+    int previousState = 0;
+    bool focusedTarget = false;
+    if (! runOnMessageThread([&previousState, &focusedTarget, targetWindow]()
+    {
+        previousState = prepareAppWindow();
+        focusedTarget = focusTarget(targetWindow);
+    }))
+    {
+        DBG(dbgPrefix << __func__ << ": Stopped before focusing the target "
+                << "window.");
+        return;
+    }
     if (! focusedTarget)
     {
         DBG(dbgPrefix << __func__ << ": Failed to focus target window!");
         jassertfalse;
     }
-    runXCommand(getKeyString(keyValue, modifiers));
-    const bool restoreFocus = focusAppWindow(previousState);
+    for (; sentCount < text.size(); sentCount++)
+    {
+        typeKey(text[sentCount], modifierFlags, method);
+    }
+    bool restoreFocus = false;
+    if (! runOnMessageThread([&restoreFocus, previousState]()
+    {
+        restoreFocus = focusAppWindow(previousState);
+    }))
+    {
+        DBG(dbgPrefix << __func__ << ": Stopped before restoring window "
+                << "focus.");
+        return;
+    }
     if (! restoreFocus)
     {
         DBG(dbgPrefix << __func__ << ": Failed to restore window focus!");
@@ -177,25 +336,8 @@ void Output::Sending::sendKey(
 void Output::Sending::sendBufferedOutput
 (Buffer& outputBuffer, const int targetWindow)
 {
-    const int previousState = prepareAppWindow();
-    const bool focusedTarget = focusTarget(targetWindow);
-    if (! focusedTarget)
-    {
-        DBG(dbgPrefix << __func__ << ": Failed to focus target window!");
-        jassertfalse;
-    }
-    const juce::String modifiers
-            = Modifiers::getModString(outputBuffer.getModifierFlags());
+    const int modifierFlags = outputBuffer.getModifierFlags();
     const Text::CharString inputText = outputBuffer.getBufferedText();
-    for (const Text::CharValue& keyValue : inputText)
-    {
-        runXCommand(getKeyString(keyValue, modifiers));
-    }
     outputBuffer.clear();
-    const bool restoreFocus = focusAppWindow(previousState);
-    if (! restoreFocus)
-    {
-        DBG(dbgPrefix << __func__ << ": Failed to restore window focus!");
-        jassertfalse;
-    }
+    sendText(inputText, modifierFlags, targetWindow);
 }
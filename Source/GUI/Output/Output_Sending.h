@@ -11,9 +11,52 @@ namespace Output
 {
     namespace Sending
     {
+        /**
+         * @brief  Methods that may be used to create key events.
+         */
+        enum class Method
+        {
+            // Run an xdotool process for each key event:
+            xdotool,
+            // Synthesize key events within this process using the XTest
+            // extension:
+            xTest
+        };
+
+        /**
+         * @brief  Gets the key event creation method selected in the main
+         *         configuration file.
+         *
+         * @return  The configured method, or Method::xdotool if the XTest
+         *          method is selected but the X server doesn't support it.
+         */
+        Method getConfiguredMethod();
+
+        /**
+         * @brief  Types a single key into whichever window currently has
+         *         keyboard focus, without changing window focus.
+         *
+         * @param keyValue       A key value to type.
+         *
+         * @param modifierFlags  Modifier flags to apply to the key, as defined
+         *                       in Input::Modifiers.
+         *
+         * @param method         The method used to create the key event.
+         */
+        void typeKey(const Text::CharValue keyValue, const int modifierFlags,
+                const Method method);
+
         /**
          * @brief  Sends a single key press event to a window.
          *
+         *  If the window's class is listed as accepting direct input, the key
+         * is sent without changing window focus. Otherwise, the target window
+         * is focused before typing the key, and focus returns to the KeyChord
+         * window afterwards.
+         *
+         *  This may be called from any thread. Window focus changes will
+         * always run on the message thread.
+         *
          * @param keyValue       A key value to type.
          *
          * @param modifierFlags  Modifier flags to apply to the key, as defined
@@ -25,6 +68,24 @@ namespace Output
         void sendKey(const Text::CharValue keyValue, const int modifierFlags,
                 const int targetWindow);
 
+        /**
+         * @brief  Sends a string of text to a window, changing window focus no
+         *         more than once.
+         *
+         *  This may be called from any thread. Window focus changes will
+         * always run on the message thread.
+         *
+         * @param text           The text to send.
+         *
+         * @param modifierFlags  Modifier flags to apply to each key, as
+         *                       defined in Input::Modifiers.
+         *
+         * @param targetWindow   The ID of the window where the text should be
+         *                       sent.
+         */
+        void sendText(const Text::CharString& text, const int modifierFlags,
+                const int targetWindow);
+
         /**
          * @brief  Take all text from a buffer object, and sends it to a window.
          *
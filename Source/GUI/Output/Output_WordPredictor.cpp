@@ -0,0 +1,166 @@
+#include "Output_WordPredictor.h"
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Output::WordPredictor::";
+#endif
+
+// Extension added to word list file names to get their index file names:
+static const juce::String indexExtension(".trie");
+
+
+// Loads the word list index, building or updating it if needed.
+Output::WordPredictor::WordPredictor(const juce::File& wordList)
+{
+    if (! wordList.existsAsFile())
+    {
+        return;
+    }
+    const juce::File indexFile = wordList.getSiblingFile(
+            wordList.getFileName() + indexExtension);
+    if (! indexFile.existsAsFile() || indexFile.getLastModificationTime()
+            < wordList.getLastModificationTime())
+    {
+        DBG(dbgPrefix << __func__ << ": Building word index "
+                << indexFile.getFullPathName());
+        Text::WordTrie::buildIndex(wordList, indexFile);
+    }
+    // Indexes saved by older versions may need to be rebuilt:
+    if (! wordTrie.loadIndex(indexFile)
+            && Text::WordTrie::buildIndex(wordList, indexFile))
+    {
+        wordTrie.loadIndex(indexFile);
+    }
+}
+
+
+// Checks if word suggestions are available.
+bool Output::WordPredictor::isEnabled() const
+{
+    return wordTrie.isLoaded();
+}
+
+
+// Replaces the current word using the end of a text string.
+void Output::WordPredictor::readText(const Text::CharString& text)
+{
+    wordNodes.clearQuick();
+    if (! isEnabled())
+    {
+        return;
+    }
+    int wordStart = text.size();
+    while (wordStart > 0
+            && Text::WordTrie::getWordCharacter(text[wordStart - 1]) != 0)
+    {
+        wordStart--;
+    }
+    Text::WordTrie::NodeIndex node = Text::WordTrie::rootNode;
+    for (int i = wordStart; i < text.size(); i++)
+    {
+        if (node != Text::WordTrie::noNode)
+        {
+            node = wordTrie.getChild(node, text[i]);
+        }
+        wordNodes.add(node);
+    }
+    updateSuggestions();
+}
+
+
+// Gets the number of suggestions available for the current word.
+int Output::WordPredictor::getSuggestionCount() const
+{
+    return suggestionCount;
+}
+
+
+// Gets the characters needed to complete the current word with a suggested
+// word.
+Text::CharString Output::WordPredictor::getSuggestion(const int index) const
+{
+    if (index < 0 || index >= suggestionCount)
+    {
+        return Text::CharString();
+    }
+    return suggestions[index];
+}
+
+
+// Extends the current word, or starts a new word, when a character is added to
+// the buffer.
+void Output::WordPredictor::characterAppended(const Text::CharValue outputChar)
+{
+    if (! isEnabled())
+    {
+        return;
+    }
+    if (Text::WordTrie::getWordCharacter(outputChar) == 0)
+    {
+        wordNodes.clearQuick();
+    }
+    else
+    {
+        const Text::WordTrie::NodeIndex lastNode = wordNodes.isEmpty()
+                ? Text::WordTrie::rootNode : wordNodes.getLast();
+        wordNodes.add((lastNode == Text::WordTrie::noNode)
+                ? Text::WordTrie::noNode
+                : wordTrie.getChild(lastNode, outputChar));
+    }
+    updateSuggestions();
+}
+
+
+// Shortens the current word when the last character is removed from the
+// buffer.
+void Output::WordPredictor::lastCharDeleted
+(const Text::CharString& bufferedText)
+{
+    if (! isEnabled())
+    {
+        return;
+    }
+    if (wordNodes.isEmpty())
+    {
+        // A separator was deleted, so the previous word is current again:
+        readText(bufferedText);
+        return;
+    }
+    wordNodes.removeLast();
+    updateSuggestions();
+}
+
+
+// Clears the current word when the buffer is cleared.
+void Output::WordPredictor::bufferCleared()
+{
+    wordNodes.clearQuick();
+    updateSuggestions();
+}
+
+
+// Reloads suggestions for the current word.
+void Output::WordPredictor::updateSuggestions()
+{
+    suggestionCount = 0;
+    if (wordNodes.isEmpty() || wordNodes.getLast() == Text::WordTrie::noNode)
+    {
+        return;
+    }
+    const int completionCount = wordTrie.getCompletions(wordNodes.getLast(),
+            suggestions, maxSuggestions + 1);
+    // Skip the empty completion if the current word is already complete:
+    for (int i = 0; i < completionCount && suggestionCount < maxSuggestions;
+            i++)
+    {
+        if (suggestions[i].isEmpty())
+        {
+            continue;
+        }
+        if (i != suggestionCount)
+        {
+            suggestions[suggestionCount].swapWith(suggestions[i]);
+        }
+        suggestionCount++;
+    }
+}
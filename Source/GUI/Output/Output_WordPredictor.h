@@ -0,0 +1,119 @@
+#pragma once
+/**
+ * @file  Output_WordPredictor.h
+ *
+ * @brief  Suggests completions for the word being entered into an
+ *         Output::Buffer.
+ */
+
+#include "Output_Buffer.h"
+#include "Text_WordTrie.h"
+#include "JuceHeader.h"
+
+namespace Output { class WordPredictor; }
+
+/**
+ * @brief  Follows the text entered into an Output::Buffer, keeping a list of
+ *         the most frequent words that complete the last word in the buffer.
+ *
+ *  Words are loaded from a Text::WordTrie index built from a word list file.
+ * The index is saved next to the word list with the ".trie" extension, and is
+ * only rebuilt when the word list changes.
+ *
+ *  Suggestions are updated incrementally. The WordPredictor keeps the trie
+ * node matching each character of the current word, so adding a character
+ * only needs one child lookup, and deleting a character only needs to drop
+ * the last node. The whole word is read again only when deleting a word
+ * separator makes the previous word current again.
+ */
+class Output::WordPredictor : public Buffer::Listener
+{
+public:
+    // Maximum number of suggestions kept for the current word:
+    static const constexpr int maxSuggestions = 3;
+
+    /**
+     * @brief  Loads the word list index, building or updating it if needed.
+     *
+     * @param wordList  The word list file. If the file doesn't exist, no
+     *                  suggestions will be made.
+     */
+    WordPredictor(const juce::File& wordList);
+
+    virtual ~WordPredictor() { }
+
+    /**
+     * @brief  Checks if word suggestions are available.
+     *
+     * @return  Whether the word list index was loaded.
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief  Replaces the current word using the end of a text string,
+     *         usually the entire contents of an Output::Buffer.
+     *
+     * @param text  The text containing the current word.
+     */
+    void readText(const Text::CharString& text);
+
+    /**
+     * @brief  Gets the number of suggestions available for the current word.
+     *
+     * @return  The suggestion count, from zero to maxSuggestions.
+     */
+    int getSuggestionCount() const;
+
+    /**
+     * @brief  Gets the characters needed to complete the current word with a
+     *         suggested word.
+     *
+     * @param index  The suggestion index, where suggestions are sorted from
+     *               most to least frequent.
+     *
+     * @return       The suggested word's characters after the current word,
+     *               or an empty string if the index isn't valid.
+     */
+    Text::CharString getSuggestion(const int index = 0) const;
+
+private:
+    /**
+     * @brief  Extends the current word, or starts a new word, when a
+     *         character is added to the buffer.
+     *
+     * @param outputChar  The added character.
+     */
+    void characterAppended(const Text::CharValue outputChar) override;
+
+    /**
+     * @brief  Shortens the current word when the last character is removed
+     *         from the buffer.
+     *
+     * @param bufferedText  The remaining buffered text.
+     */
+    void lastCharDeleted(const Text::CharString& bufferedText) override;
+
+    /**
+     * @brief  Clears the current word when the buffer is cleared.
+     */
+    void bufferCleared() override;
+
+    /**
+     * @brief  Reloads suggestions for the current word.
+     */
+    void updateSuggestions();
+
+    // The loaded word index:
+    Text::WordTrie wordTrie;
+    // The trie node matching each prefix of the current word. Once no words
+    // match, each following character adds Text::WordTrie::noNode:
+    juce::Array<Text::WordTrie::NodeIndex> wordNodes;
+    // Completions for the current word, from most to least frequent. One
+    // extra completion is loaded, in case the current word is already a
+    // complete word:
+    Text::CharString suggestions[maxSuggestions + 1];
+    // Number of valid suggestions:
+    int suggestionCount = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WordPredictor)
+};
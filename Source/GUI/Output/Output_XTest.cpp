@@ -0,0 +1,265 @@
+#include "Output_XTest.h"
+#include "Output_Modifiers.h"
+#include "Text_Values.h"
+#include "JuceHeader.h"
+#include <X11/Xlib.h>
+#include <X11/XKBlib.h>
+#include <X11/keysym.h>
+#include <X11/extensions/XTest.h>
+
+#ifdef JUCE_DEBUG
+// Print the full namespace name before all debug output:
+static const constexpr char* dbgPrefix = "Output::XTest::";
+#endif
+
+/**
+ * @brief  Holds the X display connection used for all XTest key events.
+ *
+ *  The connection is opened the first time it is needed, and stays open until
+ * the application exits.
+ */
+class XTestDisplay
+{
+public:
+    /**
+     * @brief  Opens the display connection and checks for XTest support.
+     */
+    XTestDisplay() : display(XOpenDisplay(nullptr))
+    {
+        if (display == nullptr)
+        {
+            DBG(dbgPrefix << __func__ << ": Failed to open X display!");
+            return;
+        }
+        int eventBase, errorBase, majorVersion, minorVersion;
+        extensionFound = XTestQueryExtension(display, &eventBase, &errorBase,
+                &majorVersion, &minorVersion);
+        if (! extensionFound)
+        {
+            DBG(dbgPrefix << __func__
+                    << ": XTest extension is not supported!");
+        }
+    }
+
+    /**
+     * @brief  Restores the scratch keycode and closes the display connection.
+     */
+    ~XTestDisplay()
+    {
+        if (display != nullptr)
+        {
+            if (scratchKeycode != 0)
+            {
+                KeySym noSymbol[] = { NoSymbol, NoSymbol };
+                XChangeKeyboardMapping(display, scratchKeycode, 2, noSymbol,
+                        1);
+            }
+            XCloseDisplay(display);
+            display = nullptr;
+        }
+    }
+
+    /**
+     * @brief  Finds a keycode with no assigned KeySyms, which may be
+     *         temporarily remapped to send keys missing from the current
+     *         keyboard layout.
+     *
+     * @return  The unused keycode, or zero if no unused keycodes exist.
+     */
+    KeyCode getScratchKeycode()
+    {
+        if (scratchKeycode != 0 || scratchSearched)
+        {
+            return scratchKeycode;
+        }
+        scratchSearched = true;
+        int minKeycode, maxKeycode, keysymsPerKeycode;
+        XDisplayKeycodes(display, &minKeycode, &maxKeycode);
+        KeySym* keySyms = XGetKeyboardMapping(display, minKeycode,
+                maxKeycode - minKeycode + 1, &keysymsPerKeycode);
+        if (keySyms == nullptr)
+        {
+            return 0;
+        }
+        for (int keycode = maxKeycode; keycode >= minKeycode; keycode--)
+        {
+            bool unused = true;
+            const int offset = (keycode - minKeycode) * keysymsPerKeycode;
+            for (int i = 0; i < keysymsPerKeycode && unused; i++)
+            {
+                unused = (keySyms[offset + i] == NoSymbol);
+            }
+            if (unused)
+            {
+                scratchKeycode = keycode;
+                break;
+            }
+        }
+        XFree(keySyms);
+        DBG(dbgPrefix << __func__ << ": Using scratch keycode "
+                << (int) scratchKeycode);
+        return scratchKeycode;
+    }
+
+    // The persistent display connection:
+    Display* display = nullptr;
+    // Whether the X server supports XTest:
+    bool extensionFound = false;
+
+private:
+    // An unused keycode that may be remapped to any KeySym:
+    KeyCode scratchKeycode = 0;
+    // Whether the keyboard mapping was already searched for a scratch keycode:
+    bool scratchSearched = false;
+};
+
+
+/**
+ * @brief  Gets the shared XTest display connection, opening it if necessary.
+ *
+ * @return  The display connection object.
+ */
+static XTestDisplay& getXTestDisplay()
+{
+    static XTestDisplay xTestDisplay;
+    return xTestDisplay;
+}
+
+
+/**
+ * @brief  Gets the X11 KeySym used to type a character value.
+ *
+ * @param keyValue  An ISO 8859 character code, or a replacement value defined
+ *                  in Text::Values.
+ *
+ * @return          The matching KeySym, or NoSymbol if the value has no KeySym.
+ */
+static KeySym getKeySym(const Text::CharValue keyValue)
+{
+    using namespace Text::Values;
+    // Latin-1 KeySym values are identical to their ISO 8859-1 character codes:
+    if ((keyValue >= normalPrintMin && keyValue < normalPrintMax)
+            || (keyValue >= extraPrintMin && keyValue <= extraPrintMax))
+    {
+        return (KeySym) keyValue;
+    }
+    const juce::String keyString = getXString(keyValue);
+    if (keyString.isEmpty())
+    {
+        return NoSymbol;
+    }
+    return XStringToKeysym(keyString.toRawUTF8());
+}
+
+
+/**
+ * @brief  Sends a single press or release event for a keycode.
+ *
+ * @param display  The XTest display connection.
+ *
+ * @param keycode  The keycode of the pressed or released key.
+ *
+ * @param pressed  True to send a key press event, false to send a key release
+ *                 event.
+ */
+static inline void fakeKeyEvent(Display* display, const KeyCode keycode,
+        const bool pressed)
+{
+    XTestFakeKeyEvent(display, keycode, pressed ? True : False, CurrentTime);
+}
+
+
+// Checks if the X server supports the XTest extension.
+bool Output::XTest::isAvailable()
+{
+    const XTestDisplay& xTestDisplay = getXTestDisplay();
+    return xTestDisplay.display != nullptr && xTestDisplay.extensionFound;
+}
+
+
+// Types a single key into the focused window.
+bool Output::XTest::sendKey
+(const Text::CharValue keyValue, const int modifierFlags)
+{
+    if (! isAvailable())
+    {
+        return false;
+    }
+    XTestDisplay& xTestDisplay = getXTestDisplay();
+    Display* display = xTestDisplay.display;
+    const KeySym keySym = getKeySym(keyValue);
+    if (keySym == NoSymbol)
+    {
+        DBG(dbgPrefix << __func__ << ": No KeySym for key value "
+                << (int) keyValue);
+        return false;
+    }
+
+    KeyCode keycode = XKeysymToKeycode(display, keySym);
+    bool remapped = false;
+    bool needsShift = false;
+    if (keycode != 0)
+    {
+        // Check if the KeySym is on the shifted level of its key:
+        needsShift = XkbKeycodeToKeysym(display, keycode, 0, 0) != keySym
+                && XkbKeycodeToKeysym(display, keycode, 0, 1) == keySym;
+    }
+    else
+    {
+        // The KeySym isn't in the keyboard layout, temporarily assign it to an
+        // unused key:
+        keycode = xTestDisplay.getScratchKeycode();
+        if (keycode == 0)
+        {
+            DBG(dbgPrefix << __func__ << ": No spare keycode available to "
+                    << "send key value " << (int) keyValue);
+            return false;
+        }
+        KeySym keySymLevels[] = { keySym, keySym };
+        XChangeKeyboardMapping(display, keycode, 2, keySymLevels, 1);
+        XSync(display, False);
+        remapped = true;
+    }
+
+    // Press modifiers, then the key, then release everything in reverse order:
+    namespace Modifiers = Output::Modifiers;
+    const std::pair<Modifiers::TypeFlag, KeySym> modKeys [] =
+    {
+        { Modifiers::control, XK_Control_L },
+        { Modifiers::alt,     XK_Alt_L     },
+        { Modifiers::shift,   XK_Shift_L   },
+        { Modifiers::super,   XK_Super_L   }
+    };
+    juce::Array<KeyCode> heldModifiers;
+    for (const auto& modKey : modKeys)
+    {
+        const bool shiftLevel = (modKey.first == Modifiers::shift)
+                && needsShift;
+        if ((modifierFlags & (int) modKey.first) != 0 || shiftLevel)
+        {
+            const KeyCode modCode = XKeysymToKeycode(display, modKey.second);
+            if (modCode != 0)
+            {
+                fakeKeyEvent(display, modCode, true);
+                heldModifiers.add(modCode);
+            }
+        }
+    }
+    fakeKeyEvent(display, keycode, true);
+    fakeKeyEvent(display, keycode, false);
+    for (int i = heldModifiers.size() - 1; i >= 0; i--)
+    {
+        fakeKeyEvent(display, heldModifiers[i], false);
+    }
+
+    // Make sure the server has processed all events before returning, so that
+    // focus changes made on other connections can't reorder them:
+    XSync(display, False);
+    if (remapped)
+    {
+        KeySym noSymbol[] = { NoSymbol, NoSymbol };
+        XChangeKeyboardMapping(display, keycode, 2, noSymbol, 1);
+        XSync(display, False);
+    }
+    return true;
+}
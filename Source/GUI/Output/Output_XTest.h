@@ -0,0 +1,48 @@
+#pragma once
+/**
+ * @file  Output_XTest.h
+ *
+ * @brief  Creates artificial key events within the X server using the XTest
+ *         extension.
+ */
+
+#include "Text_CharTypes.h"
+
+namespace Output
+{
+    /**
+     * @brief  Synthesizes key events on a single persistent X display
+     *         connection.
+     *
+     *  Key events created through XTest are handled by the X server exactly
+     * like physical key events, so they are delivered to whichever window
+     * currently has keyboard focus. Unlike running xdotool, sending a key this
+     * way doesn't create a new process or a new X server connection.
+     */
+    namespace XTest
+    {
+        /**
+         * @brief  Checks if the X server supports the XTest extension.
+         *
+         * @return  Whether key events may be sent using XTest.
+         */
+        bool isAvailable();
+
+        /**
+         * @brief  Types a single key into the focused window.
+         *
+         *  If the key value isn't mapped to any keycode in the current keyboard
+         * layout, a spare keycode will be temporarily remapped to send it.
+         *
+         * @param keyValue       A key value to type.
+         *
+         * @param modifierFlags  Modifier flags to apply to the key, as defined
+         *                       in Output::Modifiers.
+         *
+         * @return               Whether the key event was sent. This will
+         *                       return false if XTest is unavailable or the
+         *                       key value has no X11 KeySym.
+         */
+        bool sendKey(const Text::CharValue keyValue, const int modifierFlags);
+    }
+}
@@ -1,4 +1,5 @@
 #include "Text_CharSet_Cache.h"
+#include "Text_CharSet_JSONKeys.h"
 #include "Text_Values.h"
 
 #ifdef JUCE_DEBUG
@@ -11,7 +12,7 @@ static const constexpr int numChords = 31;
 
 // Chords arranged in order by how easy they are to type. Chords with higher
 // priority levels are assigned easier chords.
-static const juce::uint8 chordConvenienceOrder [] =
+static const constexpr juce::uint8 chordConvenienceOrder [] =
 {
     // Single key:
     0b00001,
@@ -73,10 +74,10 @@ Text::CharSet::Cache::Cache(const juce::var setData)
         return;
     }
     // character object keys:
-    static const Identifier charKey("character");
-    static const juce::Identifier shiftCharKey("shifted");
-    static const juce::Identifier chordKey("chord");
-    static const juce::Identifier priorityKey("chord priority");
+    const Identifier& charKey = JSONKeys::character;
+    const Identifier& shiftCharKey = JSONKeys::shiftedCharacter;
+    const Identifier& chordKey = JSONKeys::chord;
+    const Identifier& priorityKey = JSONKeys::chordPriority;
 
     struct PrioritizedCharPair
     {
@@ -124,32 +125,7 @@ Text::CharSet::Cache::Cache(const juce::var setData)
         }
         PrioritizedCharPair newPair;
 
-        // Load a character as either a string or a character code:
-        const std::function<CharValue(const var&, const Identifier&)> getVarChar
-                = [](const var& varCharPair, const Identifier& key)
-        {
-            CharValue charValue = 0;
-            if (! varCharPair.hasProperty(key))
-            {
-                return charValue;
-            }
-            var varChar = varCharPair[key];
-            if (varChar.isInt())
-            {
-                // Convert integers to hex strings so they can't be
-                // misinterpreted as nonstandard character values:
-                int value = varChar.operator int();
-                charValue = Values::getCharValue(String("0x")
-                        + String::toHexString(value));
-            }
-            else
-            {
-                charValue = Values::getCharValue(
-                        varChar.operator String());
-            }
-            return charValue;
-        };
-        newPair.charPair.charValue = getVarChar(charVar, charKey);
+        newPair.charPair.charValue = readCharacter(charVar, charKey);
         if (newPair.charPair.charValue == 0)
         {
             DBG(dbgPrefix << __func__ << ": Warning: character value \""
@@ -158,7 +134,7 @@ Text::CharSet::Cache::Cache(const juce::var setData)
             continue;
         }
 
-        newPair.charPair.shiftedValue = getVarChar(charVar, shiftCharKey);
+        newPair.charPair.shiftedValue = readCharacter(charVar, shiftCharKey);
         // Reuse the main character value if there's no shifted value provided:
         if (newPair.charPair.shiftedValue == 0)
         {
@@ -244,7 +220,8 @@ Text::CharSet::Cache::Cache(const juce::var setData)
     {
         Input::Chord nextChord(chordConvenienceOrder[chordIndex]);
         // Skip chords that were explicitly assigned:
-        while (charPairMap.count(nextChord) > 0)
+        while (chordTables.chordCharacters[nextChord.getByteValue()].charValue
+                != 0)
         {
             chordIndex++;
             nextChord = Input::Chord(chordConvenienceOrder[chordIndex]);
@@ -258,25 +235,46 @@ Text::CharSet::Cache::Cache(const juce::var setData)
 }
 
 
+// Modifier keys, in the order they're assigned chords:
+static const constexpr Text::CharValue modKeys [] =
+{
+    Text::Values::shift,
+    Text::Values::ctrl,
+    Text::Values::alt,
+    Text::Values::super
+};
+// Number of modifier keys:
+static const constexpr int modKeyCount = sizeof(modKeys) / sizeof(modKeys[0]);
+
+
+// Creates the lookup tables for the modifier character set.
+constexpr Text::CharSet::Cache::ChordTables
+Text::CharSet::Cache::createModTables()
+{
+    ChordTables modTables {};
+    for (int i = 0; i < modKeyCount; i++)
+    {
+        const juce::uint8 modChord = chordConvenienceOrder[i];
+        modTables.chordCharacters[modChord].charValue = modKeys[i];
+        modTables.chordCharacters[modChord].shiftedValue = modKeys[i];
+        modTables.characterChords[modKeys[i]] = modChord;
+    }
+    return modTables;
+}
+
+
 // Creates a character set cache for the modifier keys.
 Text::CharSet::Cache Text::CharSet::Cache::getModCharset()
 {
+    // The modifier set never changes, so its tables are built at compile time:
+    static constexpr ChordTables modTables = createModTables();
     Cache modCache;
-    juce::Array<Text::CharValue> modKeys =
+    modCache.chordTables = modTables;
+    for (const Text::CharValue& modKey : modKeys)
     {
-        Values::shift,
-        Values::ctrl,
-        Values::alt,
-        Values::super
-    };
-    for (int i = 0; i < modKeys.size(); i++)
-    {
-        CharPair modPair = { modKeys[i], modKeys[i] };
+        CharPair modPair = { modKey, modKey };
         modCache.charSet.add(modPair);
-        Input::Chord modChord(chordConvenienceOrder[i]);
-        modCache.chordMap[modKeys[i]] = modChord;
-        modCache.charPairMap[modChord] = modPair;
-        if (Values::isWideValue(modKeys[i]))
+        if (Values::isWideValue(modKey))
         {
             modCache.wideDrawCharacters++;
         }
@@ -285,6 +283,27 @@ Text::CharSet::Cache Text::CharSet::Cache::getModCharset()
 }
 
 
+// Reads a character value from a character set data object.
+Text::CharValue Text::CharSet::Cache::readCharacter
+(const juce::var& charData, const juce::Identifier& key)
+{
+    if (! charData.hasProperty(key))
+    {
+        return 0;
+    }
+    const juce::var varChar = charData[key];
+    if (varChar.isInt())
+    {
+        // Convert integers to hex strings so they can't be misinterpreted as
+        // nonstandard character values:
+        const int value = varChar.operator int();
+        return Values::getCharValue(juce::String("0x")
+                + juce::String::toHexString(value));
+    }
+    return Values::getCharValue(varChar.operator juce::String());
+}
+
+
 // Gets the character in the alphabet with a particular index value.
 Text::CharValue Text::CharSet::Cache::getCharAtIndex
 (const unsigned int index, const bool shifted) const
@@ -301,15 +320,9 @@ Text::CharValue Text::CharSet::Cache::getCharAtIndex
 Text::CharValue Text::CharSet::Cache::getChordCharacter
 (const Input::Chord chord, const bool shifted) const
 {
-    try
-    {
-        return shifted ? charPairMap.at(chord).shiftedValue :
-            charPairMap.at(chord).charValue;
-    }
-    catch(const std::out_of_range& e)
-    {
-        return 0;
-    }
+    const CharPair& charPair = chordTables.chordCharacters[
+            chord.getByteValue() & (chordTableSize - 1)];
+    return shifted ? charPair.shiftedValue : charPair.charValue;
 }
 
 
@@ -317,17 +330,11 @@ Text::CharValue Text::CharSet::Cache::getChordCharacter
 Input::Chord Text::CharSet::Cache::getCharacterChord
 (const Text::CharValue character) const
 {
-    try
-    {
-        return chordMap.at(character);
-    }
-    catch(const std::out_of_range& e)
+    if (character >= charTableSize)
     {
-        DBG(dbgPrefix << __func__ << ": Couldn't find chord for char value 0x"
-                << juce::String::toHexString((Text::CharValue) character)
-                << " (" << juce::String((Text::CharValue) character) << ")");
         return Input::Chord();
     }
+    return Input::Chord(chordTables.characterChords[character]);
 }
 
 
@@ -350,12 +357,14 @@ bool Text::CharSet::Cache::assignChord
 (const CharPair& character, const Input::Chord& chord)
 {
     if (! chord.isValid() || character.charValue == 0
-            || charPairMap.count(chord) > 0)
+            || character.charValue >= charTableSize
+            || character.shiftedValue >= charTableSize
+            || chordTables.chordCharacters[chord.getByteValue()].charValue != 0)
     {
         return false;
     }
-    chordMap[character.charValue] = chord;
-    chordMap[character.shiftedValue] = chord;
-    charPairMap[chord] = character;
+    chordTables.characterChords[character.charValue] = chord.getByteValue();
+    chordTables.characterChords[character.shiftedValue] = chord.getByteValue();
+    chordTables.chordCharacters[chord.getByteValue()] = character;
     return true;
 }
@@ -8,7 +8,6 @@
 
 #include "Input_Chord.h"
 #include "Text_CharTypes.h"
-#include <map>
 
 namespace Text { namespace CharSet { class Cache; } }
 
@@ -38,6 +37,21 @@ public:
      */
     static Cache getModCharset();
 
+    /**
+     * @brief  Reads a character value from a character set data object.
+     *
+     * @param charData  A character object from a character set data array.
+     *
+     * @param key       The key where the character is stored, either
+     *                  JSONKeys::character or JSONKeys::shiftedCharacter.
+     *
+     * @return          The character value, loaded from either a string or a
+     *                  character code, or 0 if the value is missing or
+     *                  invalid.
+     */
+    static Text::CharValue readCharacter(const juce::var& charData,
+            const juce::Identifier& key);
+
     /**
      * @brief  Gets the character in the alphabet with a particular index value.
      *
@@ -99,6 +113,29 @@ private:
         Text::CharValue shiftedValue = 0;
     };
 
+    // Number of chord bitmap values, including the invalid empty chord:
+    static const constexpr int chordTableSize = 32;
+    // Number of character values that may be assigned chords:
+    static const constexpr int charTableSize = 256;
+
+    // Stores lookup tables mapping chords and characters to each other:
+    struct ChordTables
+    {
+        // The character pair typed by each chord, indexed by chord bitmap.
+        // Unused chords hold an empty pair:
+        CharPair chordCharacters [chordTableSize] = {};
+        // The chord bitmap used to type each character, indexed by character
+        // value. Characters that aren't in the set hold the empty chord:
+        Input::Chord::uint8 characterChords [charTableSize] = {};
+    };
+
+    /**
+     * @brief  Creates the lookup tables for the modifier character set.
+     *
+     * @return  Tables assigning each modifier key one of the easiest chords.
+     */
+    static constexpr ChordTables createModTables();
+
     /**
      * @brief  Attempts to assign a character value to a specific Chord.
      *
@@ -114,10 +151,8 @@ private:
 
     // All characters in the Alphabet, in order:
     juce::Array<CharPair> charSet;
-    // Map of each individual character to its chord value:
-    std::map<Text::CharValue, Input::Chord> chordMap;
-    // Map of each chord to its character set:
-    std::map<Input::Chord, CharPair> charPairMap;
+    // Chord and character lookup tables:
+    ChordTables chordTables;
     // Number of wide-draw characters:
     int wideDrawCharacters = 0;
 };
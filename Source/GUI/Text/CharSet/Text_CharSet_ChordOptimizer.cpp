@@ -0,0 +1,369 @@
+#include "Text_CharSet_ChordOptimizer.h"
+#include "Text_CharSet_JSONKeys.h"
+#include "Text_Values.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Text::CharSet::ChordOptimizer::";
+#endif
+
+// Cost of each held key in a chord:
+static const constexpr double keyCost = 1.0;
+// Cost of each unheld key between a chord's first and last held keys:
+static const constexpr double gapCost = 0.5;
+// Cost of each key that changes between two consecutive chords:
+static const constexpr double keyChangeCost = 0.25;
+// Annealing temperature at the start and end of optimization, measured in
+// average cost per character:
+static const constexpr double startTemperature = 0.5;
+static const constexpr double endTemperature = 0.0005;
+
+
+// Loads a character set and its configured chord assignments.
+Text::CharSet::ChordOptimizer::ChordOptimizer(const juce::var setData) :
+setData(setData)
+{
+    const Cache defaultSet(setData);
+    setSize = defaultSet.getSize();
+    for (int i = 0; i < setSize; i++)
+    {
+        const Text::CharValue charValue = defaultSet.getCharAtIndex(i, false);
+        defaultChords.add(defaultSet.getCharacterChord(charValue)
+                .getByteValue());
+    }
+    bestChords = defaultChords;
+    charCounts.insertMultiple(0, 0.0, setSize);
+    pairCounts.insertMultiple(0, 0.0, setSize * setSize);
+
+    // Map sample characters to set characters, reading newlines and tabs as
+    // the special enter and tab values:
+    for (int sampleChar = 0; sampleChar < 256; sampleChar++)
+    {
+        Text::CharValue charValue = 0;
+        if (sampleChar == '\n')
+        {
+            charValue = Values::enter;
+        }
+        else if (sampleChar == '\t')
+        {
+            charValue = Values::tab;
+        }
+        else if (sampleChar >= (int) Values::normalPrintMin
+                && sampleChar <= (int) Values::normalPrintMax)
+        {
+            charValue = Values::getCharValue(juce::String::charToString(
+                    (juce::juce_wchar) sampleChar));
+        }
+        else if (sampleChar >= (int) Values::extraPrintMin)
+        {
+            // Extra printable values match their ISO 8859-1 code points:
+            charValue = (Text::CharValue) sampleChar;
+        }
+        sampleIndices[sampleChar] = -1;
+        for (int i = 0; i < setSize && charValue != 0; i++)
+        {
+            if (defaultSet.getCharAtIndex(i, false) == charValue
+                    || defaultSet.getCharAtIndex(i, true) == charValue)
+            {
+                sampleIndices[sampleChar] = i;
+                break;
+            }
+        }
+    }
+
+    for (int first = 0; first < bitmapCount; first++)
+    {
+        chordCosts[first] = getChordCost(Input::Chord(first));
+        for (int second = 0; second < bitmapCount; second++)
+        {
+            transitionCosts[first * bitmapCount + second]
+                    = getTransitionCost(Input::Chord(first),
+                            Input::Chord(second));
+        }
+    }
+}
+
+
+// Counts all character set characters in a text file.
+bool Text::CharSet::ChordOptimizer::readCorpus(const juce::File& corpusFile)
+{
+    if (! corpusFile.existsAsFile())
+    {
+        DBG(dbgPrefix << __func__ << ": Corpus file "
+                << corpusFile.getFullPathName() << " not found.");
+        return false;
+    }
+    addText(corpusFile.loadFileAsString());
+    return true;
+}
+
+
+// Counts all character set characters in a sample string.
+void Text::CharSet::ChordOptimizer::addText(const juce::String& text)
+{
+    for (juce::String::CharPointerType textChar = text.getCharPointer();
+            ! textChar.isEmpty(); ++textChar)
+    {
+        const juce::juce_wchar sampleChar = *textChar;
+        // Skip carriage returns so that Windows line endings are only counted
+        // once:
+        if (sampleChar == '\r')
+        {
+            continue;
+        }
+        const int index = (sampleChar < 256) ? sampleIndices[sampleChar] : -1;
+        if (index >= 0)
+        {
+            charCounts.getReference(index) += 1.0;
+            characterCount++;
+            if (lastIndex >= 0)
+            {
+                pairCounts.getReference(lastIndex * setSize + index) += 1.0;
+            }
+        }
+        lastIndex = index;
+    }
+}
+
+
+// Gets the number of sample characters that were in the character set.
+juce::int64 Text::CharSet::ChordOptimizer::getCharacterCount() const
+{
+    return characterCount;
+}
+
+
+// Searches for the chord assignment with the lowest expected typing cost.
+void Text::CharSet::ChordOptimizer::optimize
+(const int iterations, const juce::int64 seed)
+{
+    if (characterCount == 0 || setSize < 2)
+    {
+        return;
+    }
+    juce::Random random(seed);
+    juce::Array<Input::Chord::uint8> chordBitmaps = bestChords;
+    // Set index of the character using each chord, or -1 for unused chords:
+    int chordOwners [bitmapCount];
+    std::fill(chordOwners, chordOwners + bitmapCount, -1);
+    for (int i = 0; i < setSize; i++)
+    {
+        chordOwners[chordBitmaps[i]] = i;
+    }
+
+    double cost = getTotalCost(chordBitmaps);
+    double bestCost = cost;
+    for (int step = 0; step < iterations; step++)
+    {
+        const int index = random.nextInt(setSize);
+        const Input::Chord::uint8 oldChord = chordBitmaps[index];
+        const Input::Chord::uint8 newChord
+                = (Input::Chord::uint8) (1 + random.nextInt(bitmapCount - 1));
+        if (newChord == oldChord)
+        {
+            continue;
+        }
+        const int other = chordOwners[newChord];
+        const double oldLocalCost = getLocalCost(chordBitmaps, index, other);
+        chordBitmaps.set(index, newChord);
+        if (other >= 0)
+        {
+            chordBitmaps.set(other, oldChord);
+        }
+        const double costChange = getLocalCost(chordBitmaps, index, other)
+                - oldLocalCost;
+
+        const double temperature = startTemperature * std::pow(
+                endTemperature / startTemperature, (double) step / iterations)
+                * characterCount;
+        if (costChange <= 0
+                || random.nextDouble() < std::exp(-costChange / temperature))
+        {
+            cost += costChange;
+            chordOwners[newChord] = index;
+            chordOwners[oldChord] = other;
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestChords = chordBitmaps;
+            }
+        }
+        else
+        {
+            chordBitmaps.set(index, oldChord);
+            if (other >= 0)
+            {
+                chordBitmaps.set(other, newChord);
+            }
+        }
+    }
+    DBG(dbgPrefix << __func__ << ": Reduced average cost from "
+            << getDefaultCost() << " to " << getOptimizedCost());
+}
+
+
+// Gets the expected cost of typing each character using the configured chord
+// assignments.
+double Text::CharSet::ChordOptimizer::getDefaultCost() const
+{
+    if (characterCount == 0)
+    {
+        return 0.0;
+    }
+    return getTotalCost(defaultChords) / characterCount;
+}
+
+
+// Gets the expected cost of typing each character using the best chord
+// assignments found so far.
+double Text::CharSet::ChordOptimizer::getOptimizedCost() const
+{
+    if (characterCount == 0)
+    {
+        return 0.0;
+    }
+    return getTotalCost(bestChords) / characterCount;
+}
+
+
+// Gets the best chord found for a character.
+Input::Chord Text::CharSet::ChordOptimizer::getChord(const int index) const
+{
+    if (index < 0 || index >= setSize)
+    {
+        return Input::Chord();
+    }
+    return Input::Chord(bestChords[index]);
+}
+
+
+// Creates a copy of the character set data, with every character explicitly
+// assigned its best chord.
+juce::var Text::CharSet::ChordOptimizer::getSetData() const
+{
+    juce::var optimizedSet;
+    if (! setData.isArray())
+    {
+        return optimizedSet;
+    }
+    optimizedSet = juce::Array<juce::var>();
+    // Characters are added to the cache in order, skipping the same invalid
+    // objects:
+    int index = 0;
+    for (const juce::var& charVar : *setData.getArray())
+    {
+        if (! charVar.isObject() || index >= setSize
+                || Cache::readCharacter(charVar, JSONKeys::character) == 0)
+        {
+            optimizedSet.append(charVar);
+            continue;
+        }
+        juce::DynamicObject::Ptr charObject
+                = charVar.getDynamicObject()->clone();
+        charObject->removeProperty(JSONKeys::chordPriority);
+        charObject->setProperty(JSONKeys::chord,
+                getChord(index).toString());
+        optimizedSet.append(juce::var(charObject.get()));
+        index++;
+    }
+    return optimizedSet;
+}
+
+
+// Gets the cost of typing a single chord.
+double Text::CharSet::ChordOptimizer::getChordCost(const Input::Chord chord)
+{
+    int firstKey = -1;
+    int lastKey = -1;
+    int heldKeys = 0;
+    for (int i = 0; i < Input::Chord::numChordKeys(); i++)
+    {
+        if (chord.usesChordKey(i))
+        {
+            if (firstKey < 0)
+            {
+                firstKey = i;
+            }
+            lastKey = i;
+            heldKeys++;
+        }
+    }
+    if (heldKeys == 0)
+    {
+        return 0.0;
+    }
+    const int gaps = lastKey - firstKey + 1 - heldKeys;
+    return heldKeys * keyCost + gaps * gapCost;
+}
+
+
+// Gets the extra cost of typing one chord right after another.
+double Text::CharSet::ChordOptimizer::getTransitionCost
+(const Input::Chord first, const Input::Chord second)
+{
+    int changedKeys = 0;
+    for (int i = 0; i < Input::Chord::numChordKeys(); i++)
+    {
+        if (first.usesChordKey(i) != second.usesChordKey(i))
+        {
+            changedKeys++;
+        }
+    }
+    return changedKeys * keyChangeCost;
+}
+
+
+// Gets the total cost of typing all counted characters.
+double Text::CharSet::ChordOptimizer::getTotalCost
+(const juce::Array<Input::Chord::uint8>& chordBitmaps) const
+{
+    double cost = 0.0;
+    for (int first = 0; first < setSize; first++)
+    {
+        const int firstChord = chordBitmaps[first];
+        cost += charCounts[first] * chordCosts[firstChord];
+        for (int second = 0; second < setSize; second++)
+        {
+            cost += pairCounts[first * setSize + second]
+                    * transitionCosts[firstChord * bitmapCount
+                        + chordBitmaps[second]];
+        }
+    }
+    return cost;
+}
+
+
+// Gets the part of the total cost that changes when the chords of one or two
+// characters change.
+double Text::CharSet::ChordOptimizer::getLocalCost
+(const juce::Array<Input::Chord::uint8>& chordBitmaps, const int first,
+        const int second) const
+{
+    double cost = 0.0;
+    for (const int changed : { first, second })
+    {
+        if (changed < 0)
+        {
+            continue;
+        }
+        const int changedChord = chordBitmaps[changed];
+        cost += charCounts[changed] * chordCosts[changedChord];
+        for (int i = 0; i < setSize; i++)
+        {
+            const int chord = chordBitmaps[i];
+            // Pairs starting with a changed character:
+            cost += pairCounts[changed * setSize + i]
+                    * transitionCosts[changedChord * bitmapCount + chord];
+            // Pairs ending with a changed character, skipping pairs already
+            // counted as starting with a changed character:
+            if (i != first && i != second)
+            {
+                cost += pairCounts[i * setSize + changed]
+                        * transitionCosts[chord * bitmapCount + changedChord];
+            }
+        }
+    }
+    return cost;
+}
@@ -0,0 +1,203 @@
+#pragma once
+/**
+ * @file  Text_CharSet_ChordOptimizer.h
+ *
+ * @brief  Chooses chords for a character set using character frequencies
+ *         measured from a text corpus.
+ */
+
+#include "Text_CharSet_Cache.h"
+#include "Input_Chord.h"
+#include "JuceHeader.h"
+
+namespace Text { namespace CharSet { class ChordOptimizer; } }
+
+/**
+ * @brief  Counts how often each character and each pair of characters in a
+ *         character set appear in sample text, and searches for the chord
+ *         assignment that makes that text easiest to type.
+ *
+ *  The typing cost of a chord increases with the number of keys it holds, and
+ * with the number of unheld keys between its first and last held key. Moving
+ * from one chord to the next also costs a smaller amount for each key that's
+ * held in one chord but not the other. The expected cost of a chord assignment
+ * is the total cost of typing every counted character and character pair,
+ * divided by the number of counted characters.
+ *
+ *  Chords are assigned using simulated annealing. Starting from the chords
+ * assigned by the character set's configuration, the optimizer repeatedly
+ * swaps the chords of two characters, or moves a character to an unused chord.
+ * Changes that lower the cost are always kept, and changes that raise it are
+ * kept with a probability that shrinks as the search goes on, so the search
+ * can escape assignments that no single swap would improve.
+ *
+ *  Shifted characters share their unshifted character's chord, so they are
+ * counted as the same character. Characters outside of the set interrupt
+ * character pairs, as typing them requires changing character sets.
+ */
+class Text::CharSet::ChordOptimizer
+{
+public:
+    /**
+     * @brief  Loads a character set and its configured chord assignments.
+     *
+     * @param setData  A character set data array, read from the character set
+     *                 configuration file.
+     */
+    ChordOptimizer(const juce::var setData);
+
+    virtual ~ChordOptimizer() { }
+
+    /**
+     * @brief  Counts all character set characters in a text file.
+     *
+     * @param corpusFile  A file containing sample text.
+     *
+     * @return            Whether the file could be read.
+     */
+    bool readCorpus(const juce::File& corpusFile);
+
+    /**
+     * @brief  Counts all character set characters in a sample string.
+     *
+     * @param text  Sample text. Newlines and tabs are counted as the enter and
+     *              tab characters.
+     */
+    void addText(const juce::String& text);
+
+    /**
+     * @brief  Gets the number of sample characters that were in the character
+     *         set.
+     *
+     * @return  The number of characters used to measure chord costs.
+     */
+    juce::int64 getCharacterCount() const;
+
+    /**
+     * @brief  Searches for the chord assignment with the lowest expected
+     *         typing cost.
+     *
+     * @param iterations  The number of chord changes to try.
+     *
+     * @param seed        The random number seed, so that results can be
+     *                    repeated.
+     */
+    void optimize(const int iterations, const juce::int64 seed);
+
+    /**
+     * @brief  Gets the expected cost of typing each character using the
+     *         configured chord assignments.
+     *
+     * @return  The average cost of each counted character.
+     */
+    double getDefaultCost() const;
+
+    /**
+     * @brief  Gets the expected cost of typing each character using the best
+     *         chord assignments found so far.
+     *
+     * @return  The average cost of each counted character.
+     */
+    double getOptimizedCost() const;
+
+    /**
+     * @brief  Gets the best chord found for a character.
+     *
+     * @param index  The index of a character in the character set.
+     *
+     * @return       The character's chord, or an invalid chord if the index
+     *               is out of bounds.
+     */
+    Input::Chord getChord(const int index) const;
+
+    /**
+     * @brief  Creates a copy of the character set data, with every character
+     *         explicitly assigned its best chord.
+     *
+     * @return  The updated character set data array.
+     */
+    juce::var getSetData() const;
+
+    /**
+     * @brief  Gets the cost of typing a single chord.
+     *
+     * @param chord  A valid chord.
+     *
+     * @return       A cost value based on the number and spacing of the
+     *               chord's held keys.
+     */
+    static double getChordCost(const Input::Chord chord);
+
+    /**
+     * @brief  Gets the extra cost of typing one chord right after another.
+     *
+     * @param first   The first chord typed.
+     *
+     * @param second  The chord typed next.
+     *
+     * @return        A cost value based on the number of keys held in only
+     *                one of the chords.
+     */
+    static double getTransitionCost(const Input::Chord first,
+            const Input::Chord second);
+
+private:
+    /**
+     * @brief  Gets the total cost of typing all counted characters.
+     *
+     * @param chordBitmaps  The chord assigned to each character.
+     *
+     * @return              The cost of all counted characters and character
+     *                      pairs.
+     */
+    double getTotalCost(const juce::Array<Input::Chord::uint8>& chordBitmaps)
+        const;
+
+    /**
+     * @brief  Gets the part of the total cost that changes when the chords of
+     *         one or two characters change.
+     *
+     * @param chordBitmaps  The chord assigned to each character.
+     *
+     * @param first         The index of a character in the set.
+     *
+     * @param second        The index of another character in the set, or -1
+     *                      if only one character is changing.
+     *
+     * @return              The cost of both characters and every character
+     *                      pair containing either of them.
+     */
+    double getLocalCost(const juce::Array<Input::Chord::uint8>& chordBitmaps,
+            const int first, const int second) const;
+
+    // Number of values a chord bitmap can hold, including the invalid empty
+    // chord:
+    static const constexpr int bitmapCount = 32;
+
+    // Original character set data:
+    const juce::var setData;
+    // Number of characters in the set:
+    int setSize = 0;
+    // Set index of each sample text character, or -1 for characters that
+    // aren't in the set:
+    int sampleIndices [256];
+    // Number of times each set character was counted:
+    juce::Array<double> charCounts;
+    // Number of times each pair of set characters was counted, stored in rows
+    // indexed by the first character:
+    juce::Array<double> pairCounts;
+    // Total number of counted characters:
+    juce::int64 characterCount = 0;
+    // Set index of the last counted character, or -1 if the last sample
+    // character wasn't in the set:
+    int lastIndex = -1;
+    // Cached chord and transition costs, indexed by chord bitmap:
+    double chordCosts [bitmapCount];
+    double transitionCosts [bitmapCount * bitmapCount];
+    // Chords assigned by the character set configuration:
+    juce::Array<Input::Chord::uint8> defaultChords;
+    // Best chords found by optimization:
+    juce::Array<Input::Chord::uint8> bestChords;
+
+    JUCE_LEAK_DETECTOR(ChordOptimizer)
+};
@@ -25,4 +25,12 @@ namespace Text { namespace CharSet { namespace JSONKeys
     const juce::Identifier mainCharSet("main character set");
     const juce::Identifier altCharSet("alternate character set");
     const juce::Identifier specialCharSet("special character set");
+
+    // ####### Character object keys: #######
+    // Each character set array holds objects using these keys to define a
+    // character, its shifted value, and how its chord is chosen:
+    const juce::Identifier character("character");
+    const juce::Identifier shiftedCharacter("shifted");
+    const juce::Identifier chord("chord");
+    const juce::Identifier chordPriority("chord priority");
 } } }
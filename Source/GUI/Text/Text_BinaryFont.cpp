@@ -1,8 +1,8 @@
 #include "Text_BinaryFont.h"
 
 // Encodes all font data. This array is generated from a 160x160 black and white
-// image file using project-scripts/ImageBin.pl.
-const juce::uint32 fontMap [800] =
+// image file using project-scripts/BitFontGen.pl.
+static const constexpr juce::uint32 fontMap [800] =
 {
     0b00000000001111111111111111111100, 0b00000000000000000000000000000000, 0b00000000000000000000000000000000, 0b00000000000000000000000000000000, 0b00000000000000000000000000000000,
     0b00000000001000000001111111111100, 0b00000000000000000000000000000000, 0b00000000000000000000000000000000, 0b00000000000000000000000000000000, 0b00000000000000000000000000000000,
@@ -171,63 +171,146 @@ const juce::uint32 fontMap [800] =
 // Image row width, in number of characters:
 static const constexpr int charRowWidth = 16;
 // Character width and height, in number of bits/pixels:
-static const constexpr int charSize = 10;
+static const constexpr int charSize = Text::BinaryFont::charSize;
+// Font image width, in number of bits/pixels:
+static const constexpr int imageWidth = charRowWidth * charSize;
 // Array value size in bits:
 static const constexpr int arrayValSize = 32;
-// Largest valid character value:
-static const constexpr int maxChar = 255;
+// Number of values in the font data array:
+static const constexpr int fontMapSize = sizeof(fontMap) / sizeof(fontMap[0]);
+// Number of character values stored in the font:
+static const constexpr int charCount = 256;
 
-template <typename RowType>
-static RowType getVariableRow(const Text::CharValue character, const int row,
-        const int rowSize)
+// Unpacked font data and character measurements:
+struct FontTables
 {
-    using juce::uint8;
-    using juce::uint16;
-    using juce::uint32;
-    using juce::uint64;
-    if (character > maxChar)
-    {
-        return 0;
-    }
-    const uint8 charIndex = (uint8) character;
-    const uint8 charColumnIndex = charIndex % charRowWidth;
-    const uint8 charRowIndex    = charIndex / charRowWidth;
-
-    const uint16 bitX = charColumnIndex * charSize;
-    const uint16 bitY = charRowIndex * charSize + row;
-    const uint32 bitIndex = bitX + (bitY * charRowWidth * charSize);
+    // Each character's rows of pixels, with the leftmost pixel stored in the
+    // most significant of the row's charSize bits:
+    juce::uint16 charRows [charCount][charSize] = {};
+    // Rows of pixels for each character drawn at double width, covering the
+    // character and the character to its right in the font image:
+    juce::uint32 doubleCharRows [charCount][charSize] = {};
+    // Pixel column bounds of each character:
+    Text::BinaryFont::GlyphBounds charBounds [charCount] = {};
+    // Pixel column bounds of each double-wide character:
+    Text::BinaryFont::GlyphBounds doubleCharBounds [charCount] = {};
+};
 
-    const uint32 arrayIndex = bitIndex / (uint32) arrayValSize;
+/**
+ * @brief  Reads a row of pixels from the packed font data.
+ *
+ * @param character  The index of a character in the font image.
+ *
+ * @param row        The index of a row of pixels in the character image,
+ *                   ordered from top to bottom.
+ *
+ * @param rowSize    The number of pixels to read, either charSize or
+ *                   charSize * 2.
+ *
+ * @return           The row's pixels, with the leftmost pixel stored in the
+ *                   most significant of the row's rowSize bits.
+ */
+static constexpr juce::uint32 readPackedRow(const int character,
+        const int row, const int rowSize)
+{
+    const int charColumnIndex = character % charRowWidth;
+    const int charRowIndex    = character / charRowWidth;
+    const int bitIndex = charColumnIndex * charSize
+            + (charRowIndex * charSize + row) * imageWidth;
+    const int arrayIndex = bitIndex / arrayValSize;
     const int indexBitOffset = bitIndex % arrayValSize;
     const int overflow = (indexBitOffset + rowSize) - arrayValSize;
+    const juce::uint32 rowMask = (1u << rowSize) - 1;
+    if (overflow > 0)
+    {
+        // Rows past the end of the image are read as empty:
+        const juce::uint32 nextValue = (arrayIndex + 1 < fontMapSize)
+                ? fontMap[arrayIndex + 1] : 0;
+        return ((fontMap[arrayIndex] << overflow)
+                | (nextValue >> (arrayValSize - overflow))) & rowMask;
+    }
+    const int rightShift = arrayValSize - (indexBitOffset + rowSize);
+    return (fontMap[arrayIndex] >> rightShift) & rowMask;
+}
 
-    // DBG("Character value: " << (unsigned char ) character
-    // << ", arrayIndex: "
-    // << (int) arrayIndex << " bitX:" << (int) bitX << ", bitY:"
-    // << (int) bitY << " bitIndex:" << (int) bitIndex);
-
+/**
+ * @brief  Finds the pixel column bounds of a character.
+ *
+ * @param rowUnion  All of the character's rows, combined with bitwise OR.
+ *
+ * @param rowSize   The number of pixels in each row.
+ *
+ * @return          The indices of the leftmost column containing pixels and
+ *                  the column after the rightmost column containing pixels,
+ *                  or { -1, -1 } if the character is empty.
+ */
+static constexpr Text::BinaryFont::GlyphBounds findBounds
+(const juce::uint32 rowUnion, const int rowSize)
+{
+    Text::BinaryFont::GlyphBounds bounds {};
+    for (int column = 0; column < rowSize; column++)
+    {
+        if ((rowUnion & (1u << (rowSize - column - 1))) != 0)
+        {
+            if (bounds.left < 0)
+            {
+                bounds.left = column;
+            }
+            bounds.right = column + 1;
+        }
+    }
+    return bounds;
+}
 
-    if (overflow > 0)
+/**
+ * @brief  Unpacks every character's rows from the font data and measures each
+ *         character.
+ *
+ * @return  The unpacked font tables.
+ */
+static constexpr FontTables createFontTables()
+{
+    FontTables tables {};
+    for (int character = 0; character < charCount; character++)
     {
-        uint32 overflowMask = 0;
-        for (int i = 0; i < overflow; i++)
+        juce::uint32 rowUnion = 0;
+        juce::uint32 doubleRowUnion = 0;
+        for (int row = 0; row < charSize; row++)
         {
-            overflowMask |= (1 << i);
+            const juce::uint32 charRow
+                    = readPackedRow(character, row, charSize);
+            const juce::uint32 doubleCharRow
+                    = readPackedRow(character, row, charSize * 2);
+            tables.charRows[character][row] = (juce::uint16) charRow;
+            tables.doubleCharRows[character][row] = doubleCharRow;
+            rowUnion |= charRow;
+            doubleRowUnion |= doubleCharRow;
         }
-        RowType rowValue = (fontMap[arrayIndex] << overflow);
-        rowValue += (fontMap[arrayIndex + 1] >> (arrayValSize - overflow));
-        return rowValue;
+        const Text::BinaryFont::GlyphBounds bounds
+                = findBounds(rowUnion, charSize);
+        tables.charBounds[character].left = bounds.left;
+        tables.charBounds[character].right = bounds.right;
+        const Text::BinaryFont::GlyphBounds doubleBounds
+                = findBounds(doubleRowUnion, charSize * 2);
+        tables.doubleCharBounds[character].left = doubleBounds.left;
+        tables.doubleCharBounds[character].right = doubleBounds.right;
     }
-    const int rightShift = arrayValSize - (indexBitOffset + rowSize);
-    return fontMap[arrayIndex] >> rightShift;
+    return tables;
 }
 
+// All unpacked font data, generated at compile time:
+static constexpr FontTables fontTables = createFontTables();
+
 
 // Gets one row of image data for a specific character.
 juce::uint16 Text::BinaryFont::getCharacterRow(const CharValue character,
         const int row)
 {
-    return getVariableRow<juce::uint16>(character, row, charSize);
+    if (character >= charCount || row < 0 || row >= charSize)
+    {
+        return 0;
+    }
+    return fontTables.charRows[character][row];
 }
 
 
@@ -235,5 +318,47 @@ juce::uint16 Text::BinaryFont::getCharacterRow(const CharValue character,
 juce::uint32 Text::BinaryFont::getDoubleCharRow
 (const CharValue character, const int row)
 {
-    return getVariableRow<juce::uint32>(character, row, charSize * 2);
+    if (character >= charCount || row < 0 || row >= charSize)
+    {
+        return 0;
+    }
+    return fontTables.doubleCharRows[character][row];
+}
+
+
+// Gets the pixel column bounds of a character.
+Text::BinaryFont::GlyphBounds Text::BinaryFont::getCharacterBounds
+(const CharValue character)
+{
+    if (character >= charCount)
+    {
+        return GlyphBounds();
+    }
+    return fontTables.charBounds[character];
+}
+
+
+// Gets the pixel column bounds of a double-wide character.
+Text::BinaryFont::GlyphBounds Text::BinaryFont::getDoubleCharBounds
+(const CharValue character)
+{
+    if (character >= charCount)
+    {
+        return GlyphBounds();
+    }
+    return fontTables.doubleCharBounds[character];
+}
+
+
+// Reads a single pixel directly from the packed font image.
+bool Text::BinaryFont::getImagePixel(const int imageX, const int imageY)
+{
+    const int bitIndex = imageX + imageY * imageWidth;
+    if (imageX < 0 || imageY < 0 || bitIndex >= fontMapSize * arrayValSize)
+    {
+        return false;
+    }
+    const juce::uint32 value = fontMap[bitIndex / arrayValSize];
+    return (value & (1u << (arrayValSize - (bitIndex % arrayValSize) - 1)))
+            != 0;
 }
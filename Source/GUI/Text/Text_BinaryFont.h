@@ -1,3 +1,4 @@
+#pragma once
 /**
  * @file  Text_BinaryFont.h
  *
@@ -14,6 +15,17 @@ namespace Text
         // The width and height of each character:
         static const constexpr int charSize = 10;
 
+        // The range of pixel columns that contain a character's pixels:
+        struct GlyphBounds
+        {
+            // Index of the leftmost column containing pixels, or -1 if the
+            // character is empty:
+            int left = -1;
+            // Index of the column after the rightmost column containing
+            // pixels, or -1 if the character is empty:
+            int right = -1;
+        };
+
         /**
          * @brief  Gets one row of image data for a specific character.
          *
@@ -44,5 +56,44 @@ namespace Text
          */
         juce::uint32 getDoubleCharRow(const CharValue character,
                 const int row);
+
+        /**
+         * @brief  Gets the range of pixel columns that contain a character's
+         *         pixels.
+         *
+         * @param character  Either a standard printable character within the
+         *                   ISO-8859 character set, or one of the nonstandard
+         *                   character values defined in this namespace
+         *
+         * @return           The character's bounds, measured in unscaled
+         *                   pixels from the character's left edge.
+         */
+        GlyphBounds getCharacterBounds(const CharValue character);
+
+        /**
+         * @brief  Gets the range of pixel columns that contain a double-wide
+         *         character's pixels.
+         *
+         * @param character  One of the double-wide character values defined
+         *                   in this namespace.
+         *
+         * @return           The character's bounds, measured in unscaled
+         *                   pixels from the character's left edge.
+         */
+        GlyphBounds getDoubleCharBounds(const CharValue character);
+
+        /**
+         * @brief  Reads a single pixel directly from the packed font image,
+         *         without using the unpacked character tables.
+         *
+         * @param imageX  The pixel's column in the font image. Columns past the
+         *                right edge of the image continue on the next row.
+         *
+         * @param imageY  The pixel's row in the font image.
+         *
+         * @return        Whether the pixel is drawn, or false if the pixel is
+         *                outside of the image.
+         */
+        bool getImagePixel(const int imageX, const int imageY);
     }
 }
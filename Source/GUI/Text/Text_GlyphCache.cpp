@@ -0,0 +1,127 @@
+#include "Text_GlyphCache.h"
+#include "Text_BinaryFont.h"
+#include "Text_Values.h"
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Text::GlyphCache::";
+#endif
+
+
+// Gets a rendered character, rendering and saving it first if it's not
+// already cached.
+const Text::GlyphCache::Glyph& Text::GlyphCache::getGlyph
+(const CharValue character, const int pixelWidth, const int pixelHeight)
+{
+    static const Glyph emptyGlyph;
+    if (character >= glyphCount)
+    {
+        return emptyGlyph;
+    }
+    int scaleIndex = 0;
+    while (scaleIndex < scales.size()
+            && (scales[scaleIndex]->pixelWidth != pixelWidth
+                || scales[scaleIndex]->pixelHeight != pixelHeight))
+    {
+        scaleIndex++;
+    }
+    if (scaleIndex == scales.size())
+    {
+        if (scales.size() == maxScales)
+        {
+            DBG(dbgPrefix << __func__ << ": Cache full, removing scale "
+                    << scales.getLast()->pixelWidth << "x"
+                    << scales.getLast()->pixelHeight);
+            scales.removeLast();
+        }
+        ScaleGlyphs* newScale = new ScaleGlyphs;
+        newScale->pixelWidth = pixelWidth;
+        newScale->pixelHeight = pixelHeight;
+        scales.insert(0, newScale);
+    }
+    else if (scaleIndex > 0)
+    {
+        scales.move(scaleIndex, 0);
+    }
+
+    ScaleGlyphs& scale = *scales.getUnchecked(0);
+    if (! scale.rendered[character])
+    {
+        scale.glyphs[character] = renderGlyph(character, pixelWidth,
+                pixelHeight);
+        scale.rendered[character] = true;
+    }
+    return scale.glyphs[character];
+}
+
+
+// Removes all cached glyphs.
+void Text::GlyphCache::clear()
+{
+    scales.clear();
+}
+
+
+// Gets the number of pixel scales currently cached.
+int Text::GlyphCache::getScaleCount() const
+{
+    return scales.size();
+}
+
+
+// Renders a character, decoding its BinaryFont data and filling each
+// horizontal run of pixels.
+Text::GlyphCache::Glyph Text::GlyphCache::renderGlyph
+(const CharValue character, const int pixelWidth, const int pixelHeight)
+{
+    using BinaryFont::charSize;
+    const bool doubleWidth = Values::isWideValue(character);
+    const int charWidth = doubleWidth ? charSize * 2 : charSize;
+
+    Glyph glyph;
+    glyph.imageOffset = -pixelWidth;
+    juce::RectangleList<int> pixelRuns;
+    for (int row = 0; row < charSize; row++)
+    {
+        juce::uint32 rowPixels;
+        if (doubleWidth)
+        {
+            rowPixels = BinaryFont::getDoubleCharRow(character, row);
+        }
+        else
+        {
+            rowPixels = BinaryFont::getCharacterRow(character, row);
+        }
+        int pixelsToDraw = 0;
+        for (int xPixel = 0; xPixel < charWidth; xPixel++)
+        {
+            const bool pixelFound = ((1 << (charWidth - xPixel - 1))
+                    & rowPixels);
+            if (pixelFound)
+            {
+                pixelsToDraw++;
+            }
+            if ((pixelsToDraw > 0) && (xPixel == (charWidth - 1)
+                        || !pixelFound))
+            {
+                const int xPos = (xPixel - (pixelFound ? pixelsToDraw
+                        : pixelsToDraw + 1)) * pixelWidth;
+                const int width = pixelsToDraw * pixelWidth;
+                pixelRuns.addWithoutMerging(juce::Rectangle<int>(
+                            xPos - glyph.imageOffset, row * pixelHeight,
+                            width, pixelHeight));
+                glyph.rightEdge = std::max(glyph.rightEdge, xPos + width + 1);
+                pixelsToDraw = 0;
+            }
+        }
+    }
+    if (! pixelRuns.isEmpty())
+    {
+        glyph.image = juce::Image(juce::Image::SingleChannel,
+                charWidth * pixelWidth, charSize * pixelHeight, true);
+        juce::Graphics g(glyph.image);
+        g.setColour(juce::Colours::white);
+        g.fillRectList(pixelRuns);
+    }
+    return glyph;
+}
@@ -0,0 +1,113 @@
+#pragma once
+/**
+ * @file  Text_GlyphCache.h
+ *
+ * @brief  Stores pre-rendered character images so they can be drawn without
+ *         decoding Text::BinaryFont data.
+ */
+
+#include "Text_CharTypes.h"
+#include "JuceHeader.h"
+
+namespace Text { class GlyphCache; }
+
+/**
+ * @brief  Renders BinaryFont characters into single-channel images the first
+ *         time they're drawn at a particular scale, and keeps those images so
+ *         later paint operations only need to draw one image per character.
+ *
+ *  Glyphs are grouped by the width and height of each scaled font pixel. Only
+ * a limited number of scales are kept, and the least recently used scale is
+ * removed whenever a new scale needs to be added. Glyph scales depend on the
+ * size of the window, so the cache should be cleared whenever the window is
+ * resized.
+ */
+class Text::GlyphCache
+{
+public:
+    // Maximum number of pixel scales kept in the cache:
+    static const constexpr int maxScales = 8;
+
+    // A rendered character:
+    struct Glyph
+    {
+        // Image where the character's pixels are opaque, or a null image if
+        // the character has no pixels:
+        juce::Image image;
+        // Distance from the left edge of the character to the left edge of
+        // its image. Characters are drawn starting one scaled pixel to the
+        // left of their position:
+        int imageOffset = 0;
+        // Distance from the left edge of the character to one pixel past its
+        // rightmost drawn pixel, or zero if the character has no pixels:
+        int rightEdge = 0;
+    };
+
+    GlyphCache() { }
+
+    virtual ~GlyphCache() { }
+
+    /**
+     * @brief  Gets a rendered character, rendering and saving it first if
+     *         it's not already cached.
+     *
+     * @param character    An ISO 8859 character code, or a replacement value
+     *                     defined in Text::Values.
+     *
+     * @param pixelWidth   The width of each scaled font pixel.
+     *
+     * @param pixelHeight  The height of each scaled font pixel.
+     *
+     * @return             The rendered character, or an empty glyph if the
+     *                     character value is invalid.
+     */
+    const Glyph& getGlyph(const CharValue character, const int pixelWidth,
+            const int pixelHeight);
+
+    /**
+     * @brief  Removes all cached glyphs.
+     */
+    void clear();
+
+    /**
+     * @brief  Gets the number of pixel scales currently cached.
+     *
+     * @return  The number of scales holding rendered glyphs.
+     */
+    int getScaleCount() const;
+
+private:
+    // Number of character values that may be cached:
+    static const constexpr int glyphCount = 256;
+
+    // All glyphs rendered at one scale:
+    struct ScaleGlyphs
+    {
+        int pixelWidth = 0;
+        int pixelHeight = 0;
+        // Glyphs indexed by character value:
+        Glyph glyphs [glyphCount];
+        // Whether each glyph has been rendered:
+        bool rendered [glyphCount] = {};
+    };
+
+    /**
+     * @brief  Renders a character, decoding its BinaryFont data and filling
+     *         each horizontal run of pixels.
+     *
+     * @param character    A valid character value.
+     *
+     * @param pixelWidth   The width of each scaled font pixel.
+     *
+     * @param pixelHeight  The height of each scaled font pixel.
+     *
+     * @return             The rendered character.
+     */
+    static Glyph renderGlyph(const CharValue character, const int pixelWidth,
+            const int pixelHeight);
+
+    // Cached scales, ordered from most to least recently used:
+    juce::OwnedArray<ScaleGlyphs> scales;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GlyphCache)
+};
@@ -1,8 +1,8 @@
 #include "Text_Painter.h"
 #include "Text_BinaryFont.h"
+#include "Text_GlyphCache.h"
 #include "Text_Values.h"
 #include "Util_Math.h"
-#include <map>
 
 // Character width in bits/pixels
 static const constexpr int charSize = 10;
@@ -17,57 +17,98 @@ static const constexpr int whitespaceWidth = 2;
 static const constexpr char* dbgPrefix = "Text::Painter::";
 #endif
 
+// Stores characters rendered at each pixel scale:
+static Text::GlyphCache glyphCache;
+
 // Returns the leftmost and rightmost horizontal indices of the area in a
 // character that actually contain pixels, or { -1, -1} if the character is
 // empty.
 static std::pair<int, int> charBounds(const Text::CharValue toMeasure)
 {
-    const bool doubleWidth = Text::Values::isWideValue(toMeasure);
-    const int charWidth = doubleWidth ? charSize * 2 : charSize;
+    const Text::BinaryFont::GlyphBounds bounds
+            = Text::Values::isWideValue(toMeasure)
+            ? Text::BinaryFont::getDoubleCharBounds(toMeasure)
+            : Text::BinaryFont::getCharacterBounds(toMeasure);
+    return { bounds.left, bounds.right };
+}
 
-    std::pair<int, int> bounds = {-1, -1 };
 
-    for (int row = 0; row < charSize; row++)
+// Returns the width of the area a character takes up within a string,
+// including padding.
+static int drawnWidth(const Text::CharValue toMeasure)
+{
+    const std::pair<int, int> bounds = charBounds(toMeasure);
+    int width = bounds.second - bounds.first;
+    if (width == 0)
     {
-        juce::uint32 rowPixels;
-        if (doubleWidth)
-        {
-            rowPixels = Text::BinaryFont::getDoubleCharRow(toMeasure, row);
-        }
-        else
-        {
-            rowPixels = Text::BinaryFont::getCharacterRow(toMeasure, row);
-        }
-        for (int xPixel = 0; xPixel < charWidth; xPixel++)
-        {
-            if ((xPixel >= bounds.first && bounds.first != -1)
-                    && xPixel <= bounds.second)
-            {
-                continue;
-            }
-            const bool pixelFound = ((1 << (charWidth - xPixel - 1))
-                    & rowPixels);
-            if (pixelFound)
-            {
-                if ((bounds.first < 0) || bounds.first > xPixel)
-                {
-                    bounds.first = xPixel;
-                }
-                if (bounds.second <= xPixel)
-                {
-                    bounds.second = xPixel + 1;
-                }
-            }
-        }
+        width = whitespaceWidth;
     }
-    if (doubleWidth)
+    return width + charPixelPadding;
+}
+
+
+// Returns the size of each scaled font pixel used when drawing a string.
+static float getPixelSize(const int unscaledWidth, const int width,
+        const int height, const int maxCharSize)
+{
+    const float pixelSize = Util::Math::median<float>(1.0f,
+            (float) width / (float) unscaledWidth,
+            (float) maxCharSize / (float) charSize);
+    return std::min(pixelSize, (float) height / float(charSize));
+}
+
+
+// Returns the distance from a character's left edge to one pixel past its
+// rightmost drawn pixel, when the character is drawn at a specific size.
+static int glyphRightEdge(const Text::CharValue toMeasure, const int drawSize)
+{
+    const std::pair<int, int> bounds = charBounds(toMeasure);
+    if (bounds.second < 0)
     {
-        DBG(dbgPrefix << __func__ << ": bounds of " << juce::String(toMeasure)
-                << " are " << bounds.first << " to " <<bounds.second);
+        return 0;
     }
-    return bounds;
+    const int charWidth = Text::Values::isWideValue(toMeasure)
+            ? charSize * 2 : charSize;
+    const int pixelWidth = std::max(1, drawSize / charWidth);
+    return (bounds.second - 1) * pixelWidth + 1;
 }
 
+
+// Finds the positions of all characters in a string that come after the
+// characters already stored in a layout.
+static void positionGlyphs(Text::Painter::StringLayout& layout,
+        const Text::CharString& toPrint)
+{
+    int i = layout.glyphs.size();
+    layout.glyphs.ensureStorageAllocated(toPrint.size());
+    int xPos = layout.x + layout.pixelSize;
+    if (i > 0)
+    {
+        const Text::Painter::GlyphPosition& last
+                = layout.glyphs.getReference(i - 1);
+        xPos = layout.pixelSize * charPixelPadding
+                + (last.x + glyphRightEdge(last.character, layout.charSize));
+    }
+    for (; i < toPrint.size(); i++)
+    {
+        const Text::CharValue& charIndex = toPrint.getReference(i);
+        const int xStart = charBounds(charIndex).first;
+        if (i > 0 && xStart >= 0)
+        {
+            xPos -= (xStart - 1) * layout.pixelSize;
+        }
+        Text::Painter::GlyphPosition glyph;
+        glyph.character = charIndex;
+        glyph.x = xPos;
+        layout.glyphs.add(glyph);
+        xPos = layout.pixelSize * charPixelPadding
+                + (xPos + glyphRightEdge(charIndex, layout.charSize));
+    }
+    layout.rightEdge = xPos;
+}
+
+
+// Paints a single character value using Text::BinaryFont.
 int Text::Painter::paintChar(juce::Graphics& g, const CharValue toPrint,
         int x, int y, int width, int height, const bool preserveAspectRatio)
 {
@@ -92,96 +133,130 @@ int Text::Painter::paintChar(juce::Graphics& g, const CharValue toPrint,
     const int pixelWidth = std::max(1, width / charWidth);
     const int pixelHeight = std::max(1, height / charSize);
 
-    int rightmost = x;
-
-    for (int row = 0; row < charSize; row++)
+    const GlyphCache::Glyph& glyph = glyphCache.getGlyph(toPrint, pixelWidth,
+            pixelHeight);
+    if (glyph.image.isValid())
     {
-        juce::uint32 rowPixels;
-        if (doubleWidth)
-        {
-            rowPixels = Text::BinaryFont::getDoubleCharRow(toPrint, row);
-        }
-        else
-        {
-            rowPixels = Text::BinaryFont::getCharacterRow(toPrint, row);
-        }
-        int pixelsToDraw = 0;
-        for (int xPixel = 0; xPixel < charWidth; xPixel++)
-        {
-            const bool pixelFound = ((1 << (charWidth - xPixel - 1))
-                    & rowPixels);
-            if (pixelFound)
-            {
-                pixelsToDraw++;
-            }
-            if ((pixelsToDraw > 0) && (xPixel == (charWidth - 1)
-                        || !pixelFound))
-            {
-                const int xPos = (xPixel - (pixelFound ? pixelsToDraw
-                        : pixelsToDraw + 1)) * pixelWidth + x;
-                const int yPos = row * pixelHeight + y;
-                const int width = pixelsToDraw * pixelWidth;
-                g.fillRect(xPos, yPos, width, pixelHeight);
-                rightmost = std::max(rightmost, xPos + width + 1);
-                pixelsToDraw = 0;
-            }
-        }
+        g.drawImageAt(glyph.image, x + glyph.imageOffset, y, true);
     }
-    return rightmost;
+    return x + glyph.rightEdge;
 }
 
 
-// Draws an entire string using Text::BinaryFont.
-int Text::Painter::paintString(juce::Graphics& g,
-        const CharString toPrint,
+// Removes all cached character images.
+void Text::Painter::clearGlyphCache()
+{
+    glyphCache.clear();
+}
+
+
+// Measures a string and finds where each of its characters should be drawn.
+int Text::Painter::layoutString(StringLayout& layout,
+        const CharString& toPrint,
         const int x,
         const int y,
         const int width,
         const int height,
         const int maxCharSize)
 {
-    // Map character widths:
-    std::map<CharValue, int> drawnWidths;
-    std::map<CharValue, std::pair<int, int>> borders;
+    // Measure the string, reusing the layout's existing storage:
+    layout.glyphs.clearQuick();
     int widthSum = 0;
     for (const CharValue& charIndex : toPrint)
     {
-        try
-        {
-            widthSum += drawnWidths.at(charIndex);
-        }
-        catch(const std::out_of_range& e)
-        {
-            const std::pair<CharValue, int> border = charBounds(charIndex);
-            int width = border.second - border.first;
-            if (width == 0)
-            {
-                width = whitespaceWidth;
-            }
-            width += charPixelPadding;
-            drawnWidths[charIndex] = width;
-            borders[charIndex] = border;
-            widthSum += width;
-        }
+        widthSum += drawnWidth(charIndex);
     }
+    layout.x = x;
+    layout.y = y;
+    layout.width = width;
+    layout.height = height;
+    layout.maxCharSize = maxCharSize;
+    layout.unscaledWidth = widthSum;
+    layout.pixelSize = getPixelSize(widthSum, width, height, maxCharSize);
+    layout.charSize = layout.pixelSize * charSize;
+    positionGlyphs(layout, toPrint);
+    return layout.rightEdge;
+}
 
-    float pixelSize = Util::Math::median<float>(1.0f,
-            (float) width / (float) widthSum,
-            (float) maxCharSize / (float) charSize);
-    pixelSize = std::min(pixelSize, (float) height / float(charSize));
 
-    int xPos = x + pixelSize;
-    for (int i = 0; i < toPrint.size(); i++)
+// Updates a layout after its string changes, only repositioning characters
+// after the first changed character whenever possible.
+int Text::Painter::updateLayout(StringLayout& layout,
+        const CharString& toPrint,
+        const int x,
+        const int y,
+        const int width,
+        const int height,
+        const int maxCharSize)
+{
+    if (x != layout.x || y != layout.y || width != layout.width
+            || height != layout.height || maxCharSize != layout.maxCharSize)
+    {
+        layoutString(layout, toPrint, x, y, width, height, maxCharSize);
+        return 0;
+    }
+    const int oldSize = layout.glyphs.size();
+    int firstChange = 0;
+    while (firstChange < oldSize && firstChange < toPrint.size()
+            && layout.glyphs.getReference(firstChange).character
+                == toPrint.getReference(firstChange))
+    {
+        firstChange++;
+    }
+    if (firstChange == oldSize && firstChange == toPrint.size())
+    {
+        return firstChange;
+    }
+
+    // Only the changed characters need to be measured:
+    int widthSum = layout.unscaledWidth;
+    for (int i = firstChange; i < oldSize; i++)
     {
-        const CharValue& charIndex = toPrint[i];
-        const int xStart = borders[charIndex].first;
-        if (i > 0 && xStart >= 0)
-        {
-            xPos -= (xStart - 1) * pixelSize;
-        }
-        xPos = pixelSize * charPixelPadding
-                + paintChar(g, charIndex, xPos, y, pixelSize * charSize,
-                pixelSize * charSize);
+        widthSum -= drawnWidth(layout.glyphs.getReference(i).character);
+    }
+    for (int i = firstChange; i < toPrint.size(); i++)
+    {
+        widthSum += drawnWidth(toPrint.getReference(i));
+    }
+    // If the string needs to be scaled differently, every character moves:
+    if (getPixelSize(widthSum, width, height, maxCharSize) != layout.pixelSize)
+    {
+        layoutString(layout, toPrint, x, y, width, height, maxCharSize);
+        return 0;
+    }
+    layout.unscaledWidth = widthSum;
+    if (firstChange < oldSize)
+    {
+        layout.glyphs.removeLast(oldSize - firstChange);
+    }
+    positionGlyphs(layout, toPrint);
+    return firstChange;
+}
+
+
+// Draws a string that was already measured by layoutString.
+void Text::Painter::paintLayout(juce::Graphics& g, const StringLayout& layout)
+{
+    for (const GlyphPosition& glyph : layout.glyphs)
+    {
+        paintChar(g, glyph.character, glyph.x, layout.y, layout.charSize,
+                layout.charSize);
     }
-    return xPos;
+}
+
+
+// Draws an entire string using Text::BinaryFont.
+int Text::Painter::paintString(juce::Graphics& g,
+        const CharString& toPrint,
+        const int x,
+        const int y,
+        const int width,
+        const int height,
+        const int maxCharSize)
+{
+    static StringLayout layout;
+    const int rightEdge = layoutString(layout, toPrint, x, y, width, height,
+            maxCharSize);
+    paintLayout(g, layout);
+    return rightEdge;
 }
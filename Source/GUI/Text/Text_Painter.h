@@ -6,6 +6,47 @@ namespace Text
 {
     namespace Painter
     {
+        /**
+         * @brief  The position of one character within a laid out string.
+         */
+        struct GlyphPosition
+        {
+            // The character value to draw:
+            CharValue character = 0;
+            // X coordinate where the character will be drawn:
+            int x = 0;
+        };
+
+        /**
+         * @brief  Stores the measured positions of all characters in a string,
+         *         so the string can be drawn without measuring it again.
+         *
+         *  Layouts are meant to be reused. Laying out a new string keeps the
+         * layout's existing storage, so once a layout has held a string of a
+         * given length, it may lay out strings of that length or shorter
+         * without allocating any memory.
+         */
+        struct StringLayout
+        {
+            // Positions of each character, in string order:
+            juce::Array<GlyphPosition> glyphs;
+            // Area where the string was laid out:
+            int x = 0;
+            int y = 0;
+            int width = 0;
+            int height = 0;
+            // Maximum size allowed when drawing characters:
+            int maxCharSize = 0;
+            // Total width of all characters and padding, in unscaled pixels:
+            int unscaledWidth = 0;
+            // Size of each scaled font pixel:
+            float pixelSize = 0;
+            // Width and height of the area where each character is drawn:
+            int charSize = 0;
+            // X coordinate of the end of the string:
+            int rightEdge = 0;
+        };
+
         /**
          * @brief  Paints a single character value using Text::BinaryFont.
          *
@@ -40,6 +81,95 @@ namespace Text
                 int height,
                 const bool preserveAspectRatio = false);
 
+        /**
+         * @brief  Removes all cached character images.
+         *
+         *  Characters are rendered once at each pixel scale and reused by
+         * later paint operations. The cache should be cleared whenever the
+         * window size changes, as old scales will no longer be used.
+         */
+        void clearGlyphCache();
+
+        /**
+         * @brief  Measures a string and finds where each of its characters
+         *         should be drawn.
+         *
+         * @param layout       The layout where character positions will be
+         *                     saved. Any previous layout data is replaced.
+         *
+         * @param toPrint      ISO 8859 character value array containing the
+         *                     string to measure.
+         *
+         * @param x            X coordinate where the string will be drawn.
+         *
+         * @param y            Y coordinate where the string will be drawn.
+         *
+         * @param width        Width of the area where the string will be
+         *                     drawn.
+         *
+         * @param height       Height of the drawn characters.
+         *
+         * @param maxCharSize  Maximum size to draw characters.
+         *
+         * @return             The x-coordinate of the end of the string.
+         */
+        int layoutString(StringLayout& layout,
+                const CharString& toPrint,
+                const int x,
+                const int y,
+                const int width,
+                const int height,
+                const int maxCharSize);
+
+        /**
+         * @brief  Updates a layout after its string changes, only
+         *         repositioning characters after the first changed character
+         *         whenever possible.
+         *
+         *  Characters before the first changed character keep their
+         * positions, so appending or deleting characters at the end of a
+         * string only measures those characters. If the layout area changes,
+         * or the string's new width requires a different character scale, the
+         * entire string is laid out again. Removing characters from a layout
+         * may release unused storage once most of it is no longer needed.
+         *
+         * @param layout       A layout previously created by layoutString.
+         *
+         * @param toPrint      The updated string.
+         *
+         * @param x            X coordinate where the string will be drawn.
+         *
+         * @param y            Y coordinate where the string will be drawn.
+         *
+         * @param width        Width of the area where the string will be
+         *                     drawn.
+         *
+         * @param height       Height of the drawn characters.
+         *
+         * @param maxCharSize  Maximum size to draw characters.
+         *
+         * @return             The index of the first character that was
+         *                     repositioned, zero if the entire string was laid
+         *                     out again, or the string's length if the string
+         *                     didn't change.
+         */
+        int updateLayout(StringLayout& layout,
+                const CharString& toPrint,
+                const int x,
+                const int y,
+                const int width,
+                const int height,
+                const int maxCharSize);
+
+        /**
+         * @brief  Draws a string that was already measured by layoutString.
+         *
+         * @param g       JUCE graphics context used for drawing.
+         *
+         * @param layout  The measured string to draw.
+         */
+        void paintLayout(juce::Graphics& g, const StringLayout& layout);
+
         /**
          * @brief  Draws an entire string using Text::BinaryFont.
          *
@@ -52,7 +182,8 @@ namespace Text
          *
          * @param y              Y coordinate where the string will be drawn.
          *
-         * @param width          Width of the area where the string
+         * @param width          Width of the area where the string will be
+         *                       drawn.
          *
          * @param height         Height of the drawn character.
          *
@@ -61,7 +192,7 @@ namespace Text
          * @return               The x-coordinate of the end of the string.
          */
         int paintString(juce::Graphics& g,
-                const CharString toPrint,
+                const CharString& toPrint,
                 const int x,
                 const int y,
                 const int width,
@@ -0,0 +1,342 @@
+#include "Text_WordTrie.h"
+#include <map>
+#include <queue>
+#include <vector>
+
+#ifdef JUCE_DEBUG
+// Print the full class name before all debug output:
+static const constexpr char* dbgPrefix = "Text::WordTrie::";
+#endif
+
+// Identifies trie index files:
+static const constexpr char indexMagic[4] = { 'K', 'C', 'W', 'T' };
+// Index file format version, increased whenever the node layout changes:
+static const constexpr juce::uint32 indexVersion = 1;
+
+/**
+ * @brief  Data stored at the start of each index file, before the node array.
+ */
+struct IndexHeader
+{
+    char magic[4];
+    juce::uint32 version;
+    juce::uint32 nodeCount;
+    juce::uint32 padding;
+};
+
+/**
+ * @brief  A trie node used while building an index, before nodes are sorted
+ *         and flattened.
+ */
+struct BuildNode
+{
+    std::map<juce::uint8, juce::uint32> children;
+    juce::uint32 frequency = 0;
+    juce::uint32 bestFrequency = 0;
+};
+
+/**
+ * @brief  A node waiting to be checked when searching for completions.
+ *
+ *  Node entries stand for every word in a node's subtree, while word entries
+ * stand only for the word ending at the node.
+ */
+struct SearchEntry
+{
+    juce::uint32 frequency;
+    Text::WordTrie::NodeIndex node;
+    bool isWord;
+
+    bool operator< (const SearchEntry& rhs) const
+    {
+        if (frequency == rhs.frequency)
+        {
+            return ! isWord && rhs.isWord;
+        }
+        return frequency < rhs.frequency;
+    }
+};
+
+
+// Builds a trie index file from a word list.
+bool Text::WordTrie::buildIndex
+(const juce::File& wordList, const juce::File& indexFile)
+{
+    using juce::uint32;
+    using juce::uint8;
+    if (! wordList.existsAsFile())
+    {
+        DBG(dbgPrefix << __func__ << ": Missing word list "
+                << wordList.getFullPathName());
+        return false;
+    }
+
+    // Add all words to an unsorted trie:
+    const juce::StringArray lines = juce::StringArray::fromLines(
+            wordList.loadFileAsString());
+    std::vector<BuildNode> buildNodes(1);
+    juce::Array<uint8> wordChars;
+    for (int i = 0; i < lines.size(); i++)
+    {
+        const juce::StringArray tokens
+                = juce::StringArray::fromTokens(lines[i], false);
+        if (tokens.isEmpty())
+        {
+            continue;
+        }
+        const uint32 frequency = (tokens.size() > 1)
+                ? (uint32) tokens[1].getLargeIntValue()
+                : (uint32) (lines.size() - i);
+        wordChars.clearQuick();
+        for (int c = 0; c < tokens[0].length(); c++)
+        {
+            const uint8 wordChar = getWordCharacter((CharValue) tokens[0][c]);
+            if (wordChar == 0)
+            {
+                wordChars.clearQuick();
+                break;
+            }
+            wordChars.add(wordChar);
+        }
+        if (wordChars.isEmpty() || frequency == 0)
+        {
+            continue;
+        }
+        uint32 nodeIndex = 0;
+        for (const uint8& wordChar : wordChars)
+        {
+            const auto child = buildNodes[nodeIndex].children.find(wordChar);
+            if (child != buildNodes[nodeIndex].children.end())
+            {
+                nodeIndex = child->second;
+                continue;
+            }
+            const uint32 childIndex = (uint32) buildNodes.size();
+            buildNodes[nodeIndex].children[wordChar] = childIndex;
+            buildNodes.emplace_back();
+            nodeIndex = childIndex;
+        }
+        buildNodes[nodeIndex].frequency = std::max(frequency,
+                buildNodes[nodeIndex].frequency);
+    }
+
+    // Children are always added after their parents, so best frequencies can
+    // be found in a single backwards pass:
+    for (size_t i = buildNodes.size(); i-- > 0;)
+    {
+        BuildNode& buildNode = buildNodes[i];
+        buildNode.bestFrequency = buildNode.frequency;
+        for (const auto& child : buildNode.children)
+        {
+            buildNode.bestFrequency = std::max(buildNode.bestFrequency,
+                    buildNodes[child.second].bestFrequency);
+        }
+    }
+
+    // Flatten the trie breadth-first, so each node's children are stored
+    // together, sorted by best frequency:
+    std::vector<Node> indexNodes(buildNodes.size());
+    std::vector<uint32> buildIndices;
+    buildIndices.reserve(buildNodes.size());
+    buildIndices.push_back(0);
+    indexNodes[0] = { 0, noNode, buildNodes[0].frequency,
+            buildNodes[0].bestFrequency, 0, 0, 0 };
+    std::vector<std::pair<uint8, uint32>> children;
+    for (size_t i = 0; i < buildIndices.size(); i++)
+    {
+        const BuildNode& buildNode = buildNodes[buildIndices[i]];
+        children.assign(buildNode.children.begin(), buildNode.children.end());
+        std::stable_sort(children.begin(), children.end(),
+                [&buildNodes](const std::pair<uint8, uint32>& first,
+                    const std::pair<uint8, uint32>& second)
+        {
+            return buildNodes[first.second].bestFrequency
+                    > buildNodes[second.second].bestFrequency;
+        });
+        indexNodes[i].firstChild = (uint32) buildIndices.size();
+        indexNodes[i].childCount = (uint8) children.size();
+        for (const auto& child : children)
+        {
+            const BuildNode& childNode = buildNodes[child.second];
+            indexNodes[buildIndices.size()] = { 0, (uint32) i,
+                    childNode.frequency, childNode.bestFrequency,
+                    child.first, 0, 0 };
+            buildIndices.push_back(child.second);
+        }
+    }
+
+    // Write to a temporary file first, so an existing index is never left
+    // partially written:
+    IndexHeader header = { { 0 }, indexVersion, (uint32) indexNodes.size(), 0 };
+    memcpy(header.magic, indexMagic, sizeof(indexMagic));
+    juce::TemporaryFile tempFile(indexFile);
+    {
+        juce::FileOutputStream indexStream(tempFile.getFile());
+        if (indexStream.failedToOpen()
+                || ! indexStream.write(&header, sizeof(header))
+                || ! indexStream.write(indexNodes.data(),
+                    indexNodes.size() * sizeof(Node)))
+        {
+            DBG(dbgPrefix << __func__ << ": Failed to write index file "
+                    << indexFile.getFullPathName());
+            return false;
+        }
+    }
+    return tempFile.overwriteTargetFileWithTemporary();
+}
+
+
+// Maps a trie index file into memory, replacing any index that was already
+// loaded.
+bool Text::WordTrie::loadIndex(const juce::File& indexFile)
+{
+    mappedFile.reset();
+    nodes = nullptr;
+    nodeCount = 0;
+    std::unique_ptr<juce::MemoryMappedFile> newFile(new juce::MemoryMappedFile(
+            indexFile, juce::MemoryMappedFile::readOnly));
+    if (newFile->getData() == nullptr
+            || newFile->getSize() < sizeof(IndexHeader))
+    {
+        DBG(dbgPrefix << __func__ << ": Failed to map index file "
+                << indexFile.getFullPathName());
+        return false;
+    }
+    const IndexHeader* header
+            = static_cast<const IndexHeader*>(newFile->getData());
+    if (memcmp(header->magic, indexMagic, sizeof(indexMagic)) != 0
+            || header->version != indexVersion || header->nodeCount == 0
+            || newFile->getSize() != sizeof(IndexHeader)
+                + (size_t) header->nodeCount * sizeof(Node))
+    {
+        DBG(dbgPrefix << __func__ << ": Invalid index file "
+                << indexFile.getFullPathName());
+        return false;
+    }
+    nodeCount = header->nodeCount;
+    nodes = reinterpret_cast<const Node*>(header + 1);
+    mappedFile = std::move(newFile);
+    return true;
+}
+
+
+// Checks if a trie index is loaded.
+bool Text::WordTrie::isLoaded() const
+{
+    return nodes != nullptr;
+}
+
+
+// Gets the node that matches a prefix extended by one character.
+Text::WordTrie::NodeIndex Text::WordTrie::getChild
+(const NodeIndex node, const CharValue wordChar) const
+{
+    const juce::uint8 character = getWordCharacter(wordChar);
+    if (node >= nodeCount || character == 0)
+    {
+        return noNode;
+    }
+    const Node& parent = nodes[node];
+    const juce::uint32 lastChild = std::min<juce::uint32>(
+            parent.firstChild + parent.childCount, nodeCount);
+    // Children are sorted by frequency, so common characters are found first:
+    for (juce::uint32 i = parent.firstChild; i < lastChild; i++)
+    {
+        if (nodes[i].character == character)
+        {
+            return i;
+        }
+    }
+    return noNode;
+}
+
+
+// Finds the most frequent words that begin with a node's prefix.
+int Text::WordTrie::getCompletions
+(const NodeIndex node, CharString* completions, const int maxCount) const
+{
+    if (node >= nodeCount || maxCount <= 0)
+    {
+        return 0;
+    }
+    // Search best-first. Since children are sorted by best frequency, only
+    // the first child of each node needs to be queued when it's checked, and
+    // each child queues its next sibling once it's checked.
+    std::priority_queue<SearchEntry> searchQueue;
+    searchQueue.push({ nodes[node].bestFrequency, node, false });
+    int completionCount = 0;
+    while (! searchQueue.empty() && completionCount < maxCount)
+    {
+        const SearchEntry entry = searchQueue.top();
+        searchQueue.pop();
+        const Node& searchNode = nodes[entry.node];
+        if (entry.isWord)
+        {
+            CharString& completion = completions[completionCount];
+            completion.clearQuick();
+            for (NodeIndex i = entry.node; i != node; i = nodes[i].parent)
+            {
+                completion.add(nodes[i].character);
+            }
+            std::reverse(completion.begin(), completion.end());
+            completionCount++;
+            continue;
+        }
+        if (searchNode.frequency > 0)
+        {
+            searchQueue.push({ searchNode.frequency, entry.node, true });
+        }
+        if (searchNode.childCount > 0 && searchNode.firstChild < nodeCount)
+        {
+            searchQueue.push({ nodes[searchNode.firstChild].bestFrequency,
+                    searchNode.firstChild, false });
+        }
+        if (entry.node != node)
+        {
+            const Node& parent = nodes[searchNode.parent];
+            const NodeIndex sibling = entry.node + 1;
+            if (sibling < parent.firstChild + parent.childCount
+                    && sibling < nodeCount)
+            {
+                searchQueue.push({ nodes[sibling].bestFrequency, sibling,
+                        false });
+            }
+        }
+    }
+    return completionCount;
+}
+
+
+// Gets the lowercase value of a character that may appear in indexed words.
+juce::uint8 Text::WordTrie::getWordCharacter(const CharValue charValue)
+{
+    // Offset between uppercase and lowercase letters:
+    static const constexpr CharValue caseOffset = 'a' - 'A';
+    // First and last uppercase ISO 8859-1 letters:
+    static const constexpr CharValue extraUpperMin = 0xc0;
+    static const constexpr CharValue extraUpperMax = 0xde;
+    // Last lowercase ISO 8859-1 letter:
+    static const constexpr CharValue extraLowerMax = 0xff;
+    // ISO 8859-1 symbols within the range of letters:
+    static const constexpr CharValue multiplySign = 0xd7;
+    static const constexpr CharValue divideSign = 0xf7;
+
+    if (charValue == '\'' || (charValue >= 'a' && charValue <= 'z'))
+    {
+        return (juce::uint8) charValue;
+    }
+    if (charValue >= 'A' && charValue <= 'Z')
+    {
+        return (juce::uint8) (charValue + caseOffset);
+    }
+    if (charValue < extraUpperMin || charValue > extraLowerMax
+            || charValue == multiplySign || charValue == divideSign)
+    {
+        return 0;
+    }
+    if (charValue <= extraUpperMax)
+    {
+        return (juce::uint8) (charValue + caseOffset);
+    }
+    return (juce::uint8) charValue;
+}
@@ -0,0 +1,149 @@
+#pragma once
+/**
+ * @file  Text_WordTrie.h
+ *
+ * @brief  Finds the most frequent words that begin with an entered prefix,
+ *         using a compact trie index file.
+ */
+
+#include "Text_CharTypes.h"
+#include "JuceHeader.h"
+
+namespace Text { class WordTrie; }
+
+/**
+ * @brief  A read-only trie of words, ranked by frequency, that is memory
+ *         mapped directly from an index file.
+ *
+ *  Index files are built once from a plain text word list using buildIndex.
+ * Each line of the word list holds one word, optionally followed by its
+ * frequency. When frequencies are missing, words are ranked by their order in
+ * the list, so lists sorted from most to least common words can be used
+ * without changes. Words are stored in lowercase, and words containing
+ * characters other than letters and apostrophes are skipped.
+ *
+ *  The index file is a flat array of fixed-size nodes. Each node's children
+ * are stored next to each other, sorted by the highest word frequency found
+ * below each child. Loading the index only maps the file into memory, so it
+ * takes about the same time for any word list size, and unused parts of the
+ * index never need to be read from disk.
+ */
+class Text::WordTrie
+{
+public:
+    // Identifies a single trie node, matching a single word prefix:
+    typedef juce::uint32 NodeIndex;
+
+    // The node matching the empty prefix:
+    static const constexpr NodeIndex rootNode = 0;
+    // Returned in place of a node when no word uses a prefix:
+    static const constexpr NodeIndex noNode = 0xffffffff;
+
+    WordTrie() { }
+
+    virtual ~WordTrie() { }
+
+    /**
+     * @brief  Builds a trie index file from a word list.
+     *
+     * @param wordList   A text file with one word on each line. Each word may
+     *                   be followed by whitespace and its frequency.
+     *
+     * @param indexFile  The file where the trie index will be saved. Any
+     *                   existing file will be replaced.
+     *
+     * @return           Whether the index file was written.
+     */
+    static bool buildIndex(const juce::File& wordList,
+            const juce::File& indexFile);
+
+    /**
+     * @brief  Maps a trie index file into memory, replacing any index that
+     *         was already loaded.
+     *
+     * @param indexFile  A file created by buildIndex.
+     *
+     * @return           Whether the index was valid and loaded successfully.
+     */
+    bool loadIndex(const juce::File& indexFile);
+
+    /**
+     * @brief  Checks if a trie index is loaded.
+     *
+     * @return  Whether word prefixes can be searched.
+     */
+    bool isLoaded() const;
+
+    /**
+     * @brief  Gets the node that matches a prefix extended by one character.
+     *
+     * @param node      The node matching the original prefix.
+     *
+     * @param wordChar  The character to add to the prefix.
+     *
+     * @return          The node matching the extended prefix, or noNode if
+     *                  no words begin with that prefix.
+     */
+    NodeIndex getChild(const NodeIndex node, const CharValue wordChar) const;
+
+    /**
+     * @brief  Finds the most frequent words that begin with a node's prefix.
+     *
+     * @param node         The node matching the entered prefix.
+     *
+     * @param completions  An array where the remaining characters of each
+     *                     word after the prefix will be stored, from most to
+     *                     least frequent. The prefix itself is included with
+     *                     an empty completion if it is a complete word.
+     *
+     * @param maxCount     The maximum number of words to find.
+     *
+     * @return             The number of completions found.
+     */
+    int getCompletions(const NodeIndex node, CharString* completions,
+            const int maxCount) const;
+
+    /**
+     * @brief  Gets the lowercase value of a character that may appear in
+     *         indexed words.
+     *
+     * @param charValue  An ISO 8859 character code, or a replacement value
+     *                   defined in Text::Values.
+     *
+     * @return           The lowercase character, or zero if the character
+     *                   can't be part of a word.
+     */
+    static juce::uint8 getWordCharacter(const CharValue charValue);
+
+    /**
+     * @brief  A single trie node, as stored in the index file.
+     */
+    struct Node
+    {
+        // Index of the node's first child node:
+        juce::uint32 firstChild;
+        // Index of the node's parent, or noNode for the root node:
+        juce::uint32 parent;
+        // Frequency of the word ending at this node, or zero if no word ends
+        // here:
+        juce::uint32 frequency;
+        // The highest word frequency found in this node or its children:
+        juce::uint32 bestFrequency;
+        // The last character of the node's prefix:
+        juce::uint8 character;
+        // Number of child nodes:
+        juce::uint8 childCount;
+        // Unused, keeping nodes aligned:
+        juce::uint16 padding;
+    };
+
+private:
+    // Maps the index file into memory:
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    // All trie nodes, stored within the mapped file:
+    const Node* nodes = nullptr;
+    // Number of nodes in the trie:
+    juce::uint32 nodeCount = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WordTrie)
+};
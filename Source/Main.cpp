@@ -1,19 +1,49 @@
 #include "JuceHeader.h"
 #include "Application.h"
+#include "Daemon_Client.h"
+#include "Windows_XInterface.h"
+#include <X11/Xlib.h>
 
-// //The macro START_JUCE_APPLICATION(Application)
-// //expands to this code when building for Linux:
+// The macro START_JUCE_APPLICATION(Application) expands to nearly identical
+// code when building for Linux. The main function is defined here instead, so
+// that a resident instance can be shown before the JUCE library starts.
 
-// juce::JUCEApplicationBase* juce_CreateApplication();
-// juce::JUCEApplicationBase* juce_CreateApplication() {
-// return new Application();
-// }
+/**
+ * @brief  Creates the JUCE application object.
+ *
+ * @return  A new Application instance.
+ */
+static juce::JUCEApplicationBase* juce_CreateApplication()
+{
+    return new Application();
+}
 
 
-// extern "C" int main(int argc, char* argv[])
-// {
-// juce::JUCEApplicationBase::createInstance = &juce_CreateApplication;
-// return juce::JUCEApplicationBase::main( argc, (const char**) argv );
-// }
+/**
+ * @brief  Shows a resident KeyChord instance if one is running, or starts the
+ *         JUCE application otherwise.
+ *
+ * @param argc  The number of command line arguments.
+ *
+ * @param argv  The command line arguments.
+ *
+ * @return      The application's exit code.
+ */
+extern "C" int main(int argc, char* argv[])
+{
+    // Xlib thread support must be enabled before any display is opened:
+    XInitThreads();
 
-START_JUCE_APPLICATION(Application)
+    // Launches without options only need to show the resident instance, if
+    // one exists:
+    if (argc == 1 && Daemon::Client::isServerListening())
+    {
+        Windows::XInterface xInterface;
+        if (Daemon::Client::requestShow((int) xInterface.getActiveWindow()))
+        {
+            return 0;
+        }
+    }
+    juce::JUCEApplicationBase::createInstance = &juce_CreateApplication;
+    return juce::JUCEApplicationBase::main(argc, (const char**) argv);
+}
@@ -0,0 +1,125 @@
+#include "Daemon_Client.h"
+#include "Windows_XInterface.h"
+#include "JuceHeader.h"
+
+namespace Daemon { namespace Test { class StartupBenchmark; } }
+
+// Number of times the resident window is hidden and shown again:
+static const constexpr int showRepetitions = 10;
+// Milliseconds to wait between checks for the resident server:
+static const constexpr int checkFrequency = 5;
+// Milliseconds to wait for a cold launch before giving up:
+static const constexpr int launchTimeout = 30000;
+// Milliseconds to wait for the resident process to exit:
+static const constexpr int exitTimeout = 5000;
+
+/**
+ * @brief  Compares the time needed to launch KeyChord with the time needed to
+ *         show an already running resident instance.
+ *
+ *  The test launches a second copy of the KeyChord executable with the
+ * --resident option, measuring the time until its window is shown and it
+ * starts listening for requests. It then repeatedly hides and re-shows the
+ * resident window, before asking the resident instance to quit.
+ */
+class Daemon::Test::StartupBenchmark : public juce::UnitTest
+{
+public:
+    StartupBenchmark() :
+        juce::UnitTest("Resident Startup Benchmark", "Daemon") {}
+
+    void runTest() override
+    {
+        beginTest("Cold launch");
+        if (Client::isServerListening())
+        {
+            logMessage("A resident instance is already running, skipping.");
+            return;
+        }
+        const juce::String executable = juce::File::getSpecialLocation(
+                juce::File::currentExecutableFile).getFullPathName();
+        juce::ChildProcess residentProcess;
+        const juce::int64 launchTicks = juce::Time::getHighResolutionTicks();
+        const bool launched = residentProcess.start(
+                juce::StringArray({ executable, "--resident" }), 0);
+        expect(launched, "Failed to launch resident instance!");
+        if (! launched)
+        {
+            return;
+        }
+        const juce::uint32 endTime = juce::Time::getMillisecondCounter()
+                + launchTimeout;
+        bool listening = Client::isServerListening();
+        while (! listening && residentProcess.isRunning()
+                && juce::Time::getMillisecondCounter() < endTime)
+        {
+            juce::Thread::sleep(checkFrequency);
+            listening = Client::isServerListening();
+        }
+        const double coldMS = ticksToMS(juce::Time::getHighResolutionTicks()
+                - launchTicks);
+        expect(listening, "Resident instance never started listening!");
+        if (! listening)
+        {
+            residentProcess.kill();
+            return;
+        }
+        logMessage(juce::String("Cold launch: ") + juce::String(coldMS, 1)
+                + "ms");
+
+        beginTest("Warm re-show");
+        Windows::XInterface xInterface;
+        const int targetWindow = (int) xInterface.getMainAppWindow();
+        juce::int64 showTicks = 0;
+        int shownCount = 0;
+        for (int i = 0; i < showRepetitions; i++)
+        {
+            expect(Client::requestHide(), "Failed to hide resident window!");
+            const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+            if (Client::requestShow(targetWindow))
+            {
+                showTicks += juce::Time::getHighResolutionTicks() - startTicks;
+                shownCount++;
+            }
+        }
+        expectEquals(shownCount, showRepetitions,
+                "Failed to show resident window!");
+        if (shownCount > 0)
+        {
+            const double warmMS = ticksToMS(showTicks) / shownCount;
+            logMessage(juce::String("Warm re-show: ")
+                    + juce::String(warmMS, 1) + "ms");
+            expect(warmMS < coldMS, "Re-showing was slower than launching!");
+            if (warmMS > 0)
+            {
+                logMessage(juce::String("Resident speedup: ")
+                        + juce::String(coldMS / warmMS, 1) + "x");
+            }
+        }
+
+        beginTest("Resident shutdown");
+        expect(Client::requestQuit(), "Resident instance didn't accept quit!");
+        if (! residentProcess.waitForProcessToFinish(exitTimeout))
+        {
+            expect(false, "Resident instance didn't exit!");
+            residentProcess.kill();
+        }
+        expect(! Client::isServerListening(),
+                "Resident socket wasn't closed!");
+    }
+
+private:
+    /**
+     * @brief  Converts high resolution ticks to milliseconds.
+     *
+     * @param ticks  A high resolution tick count.
+     *
+     * @return       The equivalent number of milliseconds.
+     */
+    double ticksToMS(const juce::int64 ticks)
+    {
+        return 1000.0 * juce::Time::highResolutionTicksToSeconds(ticks);
+    }
+};
+
+static Daemon::Test::StartupBenchmark test;
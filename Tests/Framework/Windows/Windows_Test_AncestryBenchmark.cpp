@@ -0,0 +1,166 @@
+#include "Windows_XInterface.h"
+#include "JuceHeader.h"
+#include <X11/Xlib.h>
+
+namespace Windows { namespace Test { class AncestryBenchmark; } }
+
+// Number of synthetic top level windows:
+static const constexpr int topLevelCount = 20;
+// Number of children created under each top level window:
+static const constexpr int childCount = 10;
+// Number of children created under each second level window:
+static const constexpr int grandchildCount = 2;
+// Number of times each ancestry lookup is repeated:
+static const constexpr int lookupRepetitions = 10;
+
+/**
+ * @brief  Compares the parent-link ancestry lookup used by
+ *         Windows::XInterface::getWindowAncestry with a search of the entire
+ *         window tree, using a synthetic tree of several hundred windows.
+ *
+ *  The test windows are never mapped, so this may run on any X server,
+ * including Xvfb.
+ */
+class Windows::Test::AncestryBenchmark : public juce::UnitTest
+{
+public:
+    AncestryBenchmark() :
+        juce::UnitTest("XInterface Ancestry Benchmark", "Windows") {}
+
+    void runTest() override
+    {
+        beginTest("Creating synthetic window tree");
+        Display* display = XOpenDisplay(nullptr);
+        expect(display != nullptr, "Failed to open X display!");
+        if (display == nullptr)
+        {
+            return;
+        }
+        juce::Array<Window> topLevelWindows;
+        Window deepestWindow = 0;
+        for (int i = 0; i < topLevelCount; i++)
+        {
+            const Window topLevel = createWindow(display,
+                    XDefaultRootWindow(display));
+            topLevelWindows.add(topLevel);
+            for (int j = 0; j < childCount; j++)
+            {
+                const Window child = createWindow(display, topLevel);
+                for (int k = 0; k < grandchildCount; k++)
+                {
+                    deepestWindow = createWindow(display, child);
+                }
+            }
+        }
+        XSync(display, false);
+        const int windowCount = topLevelCount
+                * (1 + childCount * (1 + grandchildCount));
+        logMessage(juce::String("Created ") + juce::String(windowCount)
+                + " windows");
+
+        XInterface xInterface;
+        beginTest("Parent link ancestry lookup");
+        juce::Array<Window> parentAncestry;
+        const LookupResult parentResult = measureLookup(
+                [&xInterface, &parentAncestry, deepestWindow]()
+        {
+            parentAncestry = xInterface.getWindowAncestry(deepestWindow);
+        });
+        logResult("Parent links", parentResult);
+
+        beginTest("Full tree search ancestry lookup");
+        juce::Array<Window> searchAncestry;
+        const LookupResult searchResult = measureLookup(
+                [&xInterface, &searchAncestry, deepestWindow]()
+        {
+            searchAncestry = xInterface.searchWindowAncestry(deepestWindow);
+        });
+        logResult("Tree search", searchResult);
+
+        beginTest("Comparing results");
+        expect(parentAncestry == searchAncestry,
+                "Ancestry lookups returned different results!");
+        expectEquals(parentAncestry.size(), 4,
+                "Unexpected synthetic window depth!");
+        expect(parentResult.roundTrips < searchResult.roundTrips,
+                "Parent link lookup didn't reduce X server round trips!");
+        if (parentResult.milliseconds > 0)
+        {
+            logMessage(juce::String("Parent link speedup: ")
+                    + juce::String(searchResult.milliseconds
+                        / parentResult.milliseconds, 1) + "x");
+        }
+
+        for (const Window& topLevel : topLevelWindows)
+        {
+            XDestroyWindow(display, topLevel);
+        }
+        XCloseDisplay(display);
+    }
+
+private:
+    /**
+     * @brief  Average costs of a single ancestry lookup.
+     */
+    struct LookupResult
+    {
+        // Milliseconds taken per lookup:
+        double milliseconds = 0;
+        // X server round trips per lookup:
+        int roundTrips = 0;
+    };
+
+    /**
+     * @brief  Creates an unmapped window.
+     *
+     * @param display  The display connection used to create the window.
+     *
+     * @param parent   The new window's parent window.
+     *
+     * @return         The new window's ID.
+     */
+    Window createWindow(Display* display, const Window parent)
+    {
+        return XCreateSimpleWindow(display, parent, 0, 0, 10, 10, 0, 0, 0);
+    }
+
+    /**
+     * @brief  Repeatedly runs an ancestry lookup, measuring its average costs.
+     *
+     * @param lookup  The lookup action to measure.
+     *
+     * @return        The average time and round trips used per lookup.
+     */
+    LookupResult measureLookup(const std::function<void()> lookup)
+    {
+        const int startTrips = XInterface::getRoundTripCount();
+        const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < lookupRepetitions; i++)
+        {
+            lookup();
+        }
+        LookupResult result;
+        result.milliseconds = 1000.0 * juce::Time::highResolutionTicksToSeconds(
+                juce::Time::getHighResolutionTicks() - startTicks)
+                / lookupRepetitions;
+        result.roundTrips = (XInterface::getRoundTripCount() - startTrips)
+                / lookupRepetitions;
+        return result;
+    }
+
+    /**
+     * @brief  Prints the costs of an ancestry lookup method.
+     *
+     * @param methodName  The name of the lookup method.
+     *
+     * @param result      The method's measured costs.
+     */
+    void logResult(const juce::String methodName, const LookupResult& result)
+    {
+        logMessage(methodName + ": " + juce::String(result.milliseconds, 3)
+                + "ms, " + juce::String(result.roundTrips)
+                + " round trips per lookup");
+    }
+};
+
+static Windows::Test::AncestryBenchmark test;
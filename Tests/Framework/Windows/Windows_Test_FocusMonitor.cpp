@@ -0,0 +1,109 @@
+#include "Windows_FocusMonitor.h"
+#include "JuceHeader.h"
+#include <X11/Xlib.h>
+
+namespace Windows { namespace Test { class FocusMonitorTest; } }
+
+// Number of times focus moves between the test windows:
+static const constexpr int focusChanges = 20;
+// Milliseconds to wait for each focus event before failing:
+static const constexpr int eventTimeout = 1000;
+// Average focus confirmation time expected, in milliseconds:
+static const constexpr double maxAverageLatency = 10;
+
+/**
+ * @brief  Measures how quickly a Windows::FocusMonitor reports focus changes.
+ *
+ *  The test sets input focus directly with XSetInputFocus, so it doesn't need
+ * a window manager and may run under Xvfb.
+ */
+class Windows::Test::FocusMonitorTest : public juce::UnitTest
+{
+public:
+    FocusMonitorTest() : juce::UnitTest("FocusMonitor Testing", "Windows") {}
+
+    void runTest() override
+    {
+        beginTest("Opening test windows");
+        FocusMonitor focusMonitor;
+        expect(focusMonitor.isValid(), "Failed to open monitor connection!");
+        Display* display = XOpenDisplay(nullptr);
+        expect(display != nullptr, "Failed to open X display!");
+        if (display == nullptr || ! focusMonitor.isValid())
+        {
+            return;
+        }
+        const Window windows[] =
+        {
+            createMappedWindow(display),
+            createMappedWindow(display)
+        };
+        for (const Window& window : windows)
+        {
+            focusMonitor.watchWindow(window);
+        }
+        // Discard any events from creating the windows:
+        focusMonitor.waitForFocusEvent(0);
+
+        beginTest("Focus event latency");
+        double totalLatency = 0;
+        int receivedEvents = 0;
+        for (int i = 0; i < focusChanges; i++)
+        {
+            const juce::int64 startTicks
+                    = juce::Time::getHighResolutionTicks();
+            XSetInputFocus(display, windows[i % 2], RevertToParent,
+                    CurrentTime);
+            XFlush(display);
+            if (focusMonitor.waitForFocusEvent(eventTimeout))
+            {
+                receivedEvents++;
+                totalLatency += 1000.0
+                        * juce::Time::highResolutionTicksToSeconds(
+                            juce::Time::getHighResolutionTicks() - startTicks);
+            }
+        }
+        expectEquals(receivedEvents, focusChanges,
+                "Focus events were not received for every focus change!");
+        if (receivedEvents > 0)
+        {
+            const double averageLatency = totalLatency / receivedEvents;
+            logMessage(juce::String("Average focus event latency: ")
+                    + juce::String(averageLatency, 3) + "ms");
+            expect(averageLatency < maxAverageLatency,
+                    "Focus events took too long to arrive!");
+        }
+
+        XSetInputFocus(display, PointerRoot, RevertToParent, CurrentTime);
+        for (const Window& window : windows)
+        {
+            XDestroyWindow(display, window);
+        }
+        XCloseDisplay(display);
+    }
+
+private:
+    /**
+     * @brief  Creates a window and waits until it is mapped.
+     *
+     * @param display  The display connection used to create the window.
+     *
+     * @return         The new window's ID.
+     */
+    Window createMappedWindow(Display* display)
+    {
+        const Window window = XCreateSimpleWindow(display,
+                XDefaultRootWindow(display), 0, 0, 50, 50, 0, 0, 0);
+        XSelectInput(display, window, StructureNotifyMask);
+        XMapWindow(display, window);
+        XEvent event;
+        do
+        {
+            XWindowEvent(display, window, StructureNotifyMask, &event);
+        }
+        while (event.type != MapNotify);
+        return window;
+    }
+};
+
+static Windows::Test::FocusMonitorTest test;
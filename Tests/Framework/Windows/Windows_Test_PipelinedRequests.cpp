@@ -0,0 +1,174 @@
+#include "Windows_XInterface.h"
+#include "JuceHeader.h"
+#include <X11/Xlib.h>
+
+namespace Windows { namespace Test { class PipelinedRequests; } }
+
+// Number of times each request is repeated:
+static const constexpr int requestRepetitions = 20;
+
+/**
+ * @brief  Compares the pipelined XCB request path used by
+ *         Windows::XInterface::isActiveWindow and activateWindow with the
+ *         original Xlib request path.
+ *
+ *  The test checks the application's own window, along with mapped and
+ * unmapped windows it creates itself, so it may run on any X server, including
+ * Xvfb.
+ */
+class Windows::Test::PipelinedRequests : public juce::UnitTest
+{
+public:
+    PipelinedRequests() :
+        juce::UnitTest("XInterface Pipelined Request Benchmark", "Windows") {}
+
+    void runTest() override
+    {
+        Display* display = XOpenDisplay(nullptr);
+        expect(display != nullptr, "Failed to open X display!");
+        if (display == nullptr)
+        {
+            return;
+        }
+        const bool initialPipelining = XInterface::usingPipelinedRequests();
+        XInterface xInterface;
+        const Window unmappedWindow = createWindow(display);
+        const Window mappedWindow = createWindow(display);
+        XMapWindow(display, mappedWindow);
+        XSync(display, false);
+        const Window testWindows[] =
+        {
+            xInterface.getMainAppWindow(),
+            mappedWindow,
+            unmappedWindow
+        };
+
+        beginTest("Active window checks");
+        RequestResult xlibTotal, xcbTotal;
+        for (const Window& window : testWindows)
+        {
+            bool xlibActive = false;
+            bool xcbActive = false;
+            XInterface::setPipelinedRequests(false);
+            xlibTotal += measureRequest([&]()
+            {
+                xlibActive = xInterface.isActiveWindow(window);
+            });
+            XInterface::setPipelinedRequests(true);
+            xcbTotal += measureRequest([&]()
+            {
+                xcbActive = xInterface.isActiveWindow(window);
+            });
+            expect(xcbActive == xlibActive,
+                    "Request paths disagree about window activity!");
+        }
+        logResult("Xlib isActiveWindow", xlibTotal);
+        logResult("XCB isActiveWindow", xcbTotal);
+        expect(xcbTotal.roundTrips <= xlibTotal.roundTrips,
+                "Pipelining didn't reduce isActiveWindow round trips!");
+
+        beginTest("Window activation");
+        const Window appWindow = xInterface.getMainAppWindow();
+        XInterface::setPipelinedRequests(false);
+        const RequestResult xlibActivate = measureRequest([&]()
+        {
+            xInterface.activateWindow(appWindow);
+        });
+        const bool xlibActive = xInterface.isActiveWindow(appWindow);
+        XInterface::setPipelinedRequests(true);
+        const RequestResult xcbActivate = measureRequest([&]()
+        {
+            xInterface.activateWindow(appWindow);
+        });
+        expect(xInterface.isActiveWindow(appWindow) == xlibActive,
+                "Request paths activated the window differently!");
+        logResult("Xlib activateWindow", xlibActivate);
+        logResult("XCB activateWindow", xcbActivate);
+        expect(xcbActivate.roundTrips <= xlibActivate.roundTrips,
+                "Pipelining didn't reduce activateWindow round trips!");
+
+        XInterface::setPipelinedRequests(initialPipelining);
+        XDestroyWindow(display, mappedWindow);
+        XDestroyWindow(display, unmappedWindow);
+        XCloseDisplay(display);
+    }
+
+private:
+    /**
+     * @brief  Average costs of a single request.
+     */
+    struct RequestResult
+    {
+        // Milliseconds taken per request:
+        double milliseconds = 0;
+        // X server round trips per request:
+        int roundTrips = 0;
+
+        /**
+         * @brief  Adds another request's costs to this result.
+         *
+         * @param rhs  The costs to add.
+         *
+         * @return     This result.
+         */
+        RequestResult& operator+= (const RequestResult& rhs)
+        {
+            milliseconds += rhs.milliseconds;
+            roundTrips += rhs.roundTrips;
+            return *this;
+        }
+    };
+
+    /**
+     * @brief  Creates a top level window.
+     *
+     * @param display  The display connection used to create the window.
+     *
+     * @return         The new window's ID.
+     */
+    Window createWindow(Display* display)
+    {
+        return XCreateSimpleWindow(display, XDefaultRootWindow(display), 0, 0,
+                10, 10, 0, 0, 0);
+    }
+
+    /**
+     * @brief  Repeatedly runs a request, measuring its average costs.
+     *
+     * @param request  The request action to measure.
+     *
+     * @return         The average time and round trips used per request.
+     */
+    RequestResult measureRequest(const std::function<void()> request)
+    {
+        const int startTrips = XInterface::getRoundTripCount();
+        const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < requestRepetitions; i++)
+        {
+            request();
+        }
+        RequestResult result;
+        result.milliseconds = 1000.0 * juce::Time::highResolutionTicksToSeconds(
+                juce::Time::getHighResolutionTicks() - startTicks)
+                / requestRepetitions;
+        result.roundTrips = (XInterface::getRoundTripCount() - startTrips)
+                / requestRepetitions;
+        return result;
+    }
+
+    /**
+     * @brief  Prints the costs of a request path.
+     *
+     * @param pathName  The name of the request path.
+     *
+     * @param result    The path's measured costs.
+     */
+    void logResult(const juce::String pathName, const RequestResult& result)
+    {
+        logMessage(pathName + ": " + juce::String(result.milliseconds, 3)
+                + "ms, " + juce::String(result.roundTrips)
+                + " round trips per request");
+    }
+};
+
+static Windows::Test::PipelinedRequests test;
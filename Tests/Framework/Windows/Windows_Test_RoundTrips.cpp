@@ -0,0 +1,110 @@
+#include "Windows_XInterface.h"
+#include "JuceHeader.h"
+#include <cstdlib>
+
+namespace Windows { namespace Test { class RoundTrips; } }
+
+/**
+ * @brief  Logs the number of X server round trips needed by common
+ *         Windows::XInterface operations.
+ *
+ *  Opening a new XInterface display connection measures the setup cost that
+ * every XInterface object paid before connections were shared.
+ */
+class Windows::Test::RoundTrips : public juce::UnitTest
+{
+public:
+    RoundTrips() : juce::UnitTest("XInterface Round Trip Testing", "Windows")
+    {}
+
+    void runTest() override
+    {
+        const char* displayName = std::getenv("DISPLAY");
+        expect(displayName != nullptr, "No X display is set!");
+        if (displayName == nullptr)
+        {
+            return;
+        }
+
+        beginTest("Creating XInterface objects");
+        const int privateTrips = countRoundTrips([displayName]()
+        {
+            XInterface privateInterface(displayName);
+        });
+        const int sharedTrips = countRoundTrips([]()
+        {
+            XInterface sharedInterface;
+        });
+        logMessage(juce::String("New connection: ") + juce::String(privateTrips)
+                + " round trips, shared connection: "
+                + juce::String(sharedTrips) + " round trips");
+        expectEquals(sharedTrips, 0,
+                "Using the shared connection shouldn't contact the server!");
+
+        XInterface xInterface;
+        const Window appWindow = xInterface.getMainAppWindow();
+        const std::pair<juce::String, std::function<void()>> operations [] =
+        {
+            {
+                "getActiveWindow",
+                [&xInterface]() { xInterface.getActiveWindow(); }
+            },
+            {
+                "getWindowAncestry",
+                [&xInterface, appWindow]()
+                {
+                    xInterface.getWindowAncestry(appWindow);
+                }
+            },
+            {
+                "isActiveWindow",
+                [&xInterface, appWindow]()
+                {
+                    xInterface.isActiveWindow(appWindow);
+                }
+            },
+            {
+                "activateWindow",
+                [&xInterface, appWindow]()
+                {
+                    xInterface.activateWindow(appWindow);
+                }
+            }
+        };
+        for (const auto& operation : operations)
+        {
+            beginTest(operation.first + " round trips");
+            const int trips = countRoundTrips(operation.second);
+            logMessage(operation.first + ": " + juce::String(trips)
+                    + " round trips");
+        }
+
+        beginTest("Cached supported property checks");
+        // The first call may need to load the supported property list:
+        xInterface.getDesktopIndex();
+        const int desktopTrips = countRoundTrips([&xInterface]()
+        {
+            xInterface.getDesktopIndex();
+        });
+        expect(desktopTrips <= 1, juce::String("getDesktopIndex needed ")
+                + juce::String(desktopTrips) + " round trips, expected at "
+                + "most one property read.");
+    }
+
+private:
+    /**
+     * @brief  Counts the X server round trips made while running an action.
+     *
+     * @param action  An action that uses XInterface objects.
+     *
+     * @return        The number of round trips recorded during the action.
+     */
+    int countRoundTrips(const std::function<void()> action)
+    {
+        const int startCount = XInterface::getRoundTripCount();
+        action();
+        return XInterface::getRoundTripCount() - startCount;
+    }
+};
+
+static Windows::Test::RoundTrips test;
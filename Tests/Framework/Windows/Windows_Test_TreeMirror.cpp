@@ -0,0 +1,134 @@
+#include "Windows_TreeMirror.h"
+#include "Windows_XInterface.h"
+#include "JuceHeader.h"
+#include <X11/Xlib.h>
+
+namespace Windows { namespace Test { class TreeMirrorTest; } }
+
+// Milliseconds to wait for the mirror to receive window tree events:
+static const constexpr int eventTimeout = 2000;
+// Milliseconds to wait between mirror consistency checks:
+static const constexpr int checkInterval = 5;
+
+/**
+ * @brief  Checks that Windows::TreeMirror stays consistent with the X server
+ *         as windows are created, restacked, reparented, and destroyed.
+ *
+ *  None of the test windows are mapped, so this may run on any X server,
+ * including Xvfb.
+ */
+class Windows::Test::TreeMirrorTest : public juce::UnitTest
+{
+public:
+    TreeMirrorTest() : juce::UnitTest("TreeMirror Testing", "Windows") {}
+
+    void runTest() override
+    {
+        beginTest("Initial window tree");
+        TreeMirror treeMirror;
+        expect(treeMirror.isValid(), "Failed to open mirror connection!");
+        Display* display = XOpenDisplay(nullptr);
+        expect(display != nullptr, "Failed to open X display!");
+        if (display == nullptr || ! treeMirror.isValid())
+        {
+            return;
+        }
+        expect(treeMirror.matchesServerTree(),
+                "Initial mirrored tree doesn't match the server!");
+
+        beginTest("Creating windows");
+        const Window root = XDefaultRootWindow(display);
+        const Window parentA = createWindow(display, root);
+        const Window parentB = createWindow(display, root);
+        juce::Array<Window> children;
+        for (int i = 0; i < 5; i++)
+        {
+            children.add(createWindow(display, parentA));
+        }
+        expectConsistent(display, treeMirror);
+        Window mirroredParent = 0;
+        expect(treeMirror.getParent(children[0], mirroredParent)
+                && mirroredParent == parentA, "Child has the wrong parent!");
+
+        beginTest("Restacking windows");
+        XRaiseWindow(display, children[0]);
+        XLowerWindow(display, children[4]);
+        XWindowChanges changes;
+        changes.sibling = children[1];
+        changes.stack_mode = Above;
+        XConfigureWindow(display, children[3], CWSibling | CWStackMode,
+                &changes);
+        XCirculateSubwindowsUp(display, parentA);
+        expectConsistent(display, treeMirror);
+
+        beginTest("Reparenting windows");
+        XReparentWindow(display, children[2], parentB, 0, 0);
+        XReparentWindow(display, parentB, parentA, 0, 0);
+        expectConsistent(display, treeMirror);
+
+        beginTest("Destroying windows");
+        XDestroyWindow(display, children[1]);
+        XDestroyWindow(display, parentA);
+        expectConsistent(display, treeMirror);
+
+        beginTest("XInterface tree mirror queries");
+        XInterface::setTreeMirrorEnabled(true);
+        expect(XInterface::isTreeMirrorEnabled(),
+                "Failed to enable the XInterface tree mirror!");
+        const Window newParent = createWindow(display, root);
+        const Window newChild = createWindow(display, newParent);
+        XSync(display, false);
+        // Give the mirror's connection time to receive the new window events:
+        juce::Thread::sleep(checkInterval * 10);
+        XInterface xInterface;
+        const int startTrips = XInterface::getRoundTripCount();
+        const juce::Array<Window> ancestry
+                = xInterface.getWindowAncestry(newChild);
+        expectEquals(XInterface::getRoundTripCount() - startTrips, 0,
+                "Mirrored ancestry lookup contacted the X server!");
+        XInterface::setTreeMirrorEnabled(false);
+        expect(ancestry == xInterface.getWindowAncestry(newChild),
+                "Mirrored ancestry doesn't match the X server!");
+        XDestroyWindow(display, newParent);
+        XCloseDisplay(display);
+    }
+
+private:
+    /**
+     * @brief  Creates an unmapped window.
+     *
+     * @param display  The display connection used to create the window.
+     *
+     * @param parent   The new window's parent window.
+     *
+     * @return         The new window's ID.
+     */
+    Window createWindow(Display* display, const Window parent)
+    {
+        return XCreateSimpleWindow(display, parent, 0, 0, 10, 10, 0, 0, 0);
+    }
+
+    /**
+     * @brief  Waits for the mirror to receive all changes made through a
+     *         display connection, then checks that it matches the server.
+     *
+     * @param display     The connection used to change the window tree.
+     *
+     * @param treeMirror  The mirror to check.
+     */
+    void expectConsistent(Display* display, TreeMirror& treeMirror)
+    {
+        XSync(display, false);
+        const juce::uint32 endTime = juce::Time::getMillisecondCounter()
+                + eventTimeout;
+        bool consistent = treeMirror.matchesServerTree();
+        while (! consistent && juce::Time::getMillisecondCounter() < endTime)
+        {
+            juce::Thread::sleep(checkInterval);
+            consistent = treeMirror.matchesServerTree();
+        }
+        expect(consistent, "Mirrored tree doesn't match the server!");
+    }
+};
+
+static Windows::Test::TreeMirrorTest test;
@@ -0,0 +1,99 @@
+#include "Component_MainView.h"
+#include "Text_CharSet_ConfigFile.h"
+#include "Text_Painter.h"
+#include "JuceHeader.h"
+
+namespace Component { namespace Test { class RenderBenchmark; } }
+
+// Size of the rendered view, matching the ClockworkPi GameShell display:
+static const constexpr int viewWidth = 320;
+static const constexpr int viewHeight = 240;
+// Number of full repaints measured in each test:
+static const constexpr int frameCount = 200;
+// Buffered input text shown while rendering:
+static const char* inputText = "The quick brown fox jumps";
+// Chord held while rendering:
+static const constexpr Input::Chord::uint8 heldChord = 0b00101;
+
+/**
+ * @brief  Measures how many times per second the entire Component::MainView
+ *         can be painted, with and without Text::Painter's glyph cache.
+ *
+ *  Frames are painted into an image, so this test doesn't need a visible
+ * window:
+ *
+ *     ./build/Debug/KeyChord --test -categories Component
+ */
+class Component::Test::RenderBenchmark : public juce::UnitTest
+{
+public:
+    RenderBenchmark() : juce::UnitTest("Component::MainView Render Benchmark",
+            "Component") {}
+
+    void runTest() override
+    {
+        Text::CharSet::ConfigFile charsetConfig;
+        MainView mainView;
+        mainView.setBounds(0, 0, viewWidth, viewHeight);
+        Text::CharString input;
+        for (const char* inputChar = inputText; *inputChar != 0; inputChar++)
+        {
+            input.add((Text::CharValue) *inputChar);
+        }
+        mainView.updateChordState(&charsetConfig.getActiveSet(),
+                Input::Chord(heldChord), input, Text::CharString());
+        juce::Image frame(juce::Image::ARGB, viewWidth, viewHeight, true);
+
+        beginTest("Repaints rendering every character");
+        const double uncachedRate = measureFrameRate(mainView, frame, true);
+        logMessage(juce::String("Without glyph cache: ")
+                + juce::String(uncachedRate, 1) + " repaints/second");
+
+        beginTest("Repaints using cached characters");
+        const double cachedRate = measureFrameRate(mainView, frame, false);
+        logMessage(juce::String("With glyph cache: ")
+                + juce::String(cachedRate, 1) + " repaints/second");
+        if (uncachedRate > 0)
+        {
+            logMessage(juce::String("Glyph cache speedup: ")
+                    + juce::String(cachedRate / uncachedRate, 2) + "x");
+        }
+        expectGreaterThan(cachedRate, 0.0, "Failed to measure repaints!");
+        Text::Painter::clearGlyphCache();
+    }
+
+private:
+    /**
+     * @brief  Paints the entire view repeatedly, measuring the paint rate.
+     *
+     * @param mainView    The view to paint.
+     *
+     * @param frame       The image the view is painted into.
+     *
+     * @param clearCache  Whether the glyph cache should be cleared before
+     *                    each repaint, so every character is rendered again.
+     *
+     * @return            The number of repaints per second.
+     */
+    static double measureFrameRate(MainView& mainView, juce::Image& frame,
+            const bool clearCache)
+    {
+        // Fill the cache before timing cached repaints:
+        juce::Graphics g(frame);
+        mainView.paintEntireComponent(g, true);
+        const double startTime = juce::Time::getMillisecondCounterHiRes();
+        for (int i = 0; i < frameCount; i++)
+        {
+            if (clearCache)
+            {
+                Text::Painter::clearGlyphCache();
+            }
+            mainView.paintEntireComponent(g, true);
+        }
+        const double elapsedSeconds = (juce::Time::getMillisecondCounterHiRes()
+                - startTime) / 1000.0;
+        return (elapsedSeconds > 0) ? (frameCount / elapsedSeconds) : 0.0;
+    }
+};
+
+static Component::Test::RenderBenchmark test;
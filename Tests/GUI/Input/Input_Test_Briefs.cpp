@@ -0,0 +1,181 @@
+#include "Input_BriefReader.h"
+#include "Output_Buffer.h"
+#include "JuceHeader.h"
+
+namespace Input { namespace Test { class Briefs; } }
+
+// Brief dictionary used for all tests. Only four lines hold valid briefs:
+static const char* briefDictionary =
+        "# Test briefs:\n"
+        "1/24      the\n"
+        "1/24/3    there\n"
+        "5\tand\n"
+        "2/2       wrong\n"
+        "2/2       was\n"
+        "\n"
+        "16        invalid key\n"
+        "1//2      empty chord\n"
+        "12\n"
+        "1/1/1/1/1/1/1/1/1/1/1/1/1 too long\n";
+// Number of valid briefs in the test dictionary:
+static const constexpr int briefCount = 4;
+
+/**
+ * @brief  Checks that Input::BriefReader loads brief dictionaries, matches
+ *         briefs incrementally as chords are entered, and stops matching when
+ *         buffered words are edited.
+ */
+class Input::Test::Briefs : public juce::UnitTest
+{
+public:
+    Briefs() : juce::UnitTest("Chord Briefs", "Input") {}
+
+    void runTest() override
+    {
+        juce::TemporaryFile dictionaryFile(".txt");
+        expect(dictionaryFile.getFile().replaceWithText(briefDictionary),
+                "Failed to save test dictionary!");
+
+        beginTest("Loading brief dictionary");
+        BriefReader briefReader(dictionaryFile.getFile());
+        expect(briefReader.isEnabled(), "No briefs loaded!");
+        expectEquals(briefReader.getBriefCount(), briefCount,
+                "Wrong number of briefs loaded!");
+        Output::Buffer buffer;
+        buffer.addListener(&briefReader);
+
+        beginTest("Matching briefs incrementally");
+        typeChord(buffer, briefReader, 0b00001, 'x');
+        expectExpansion(briefReader, "");
+        typeChord(buffer, briefReader, 0b01010, 'y');
+        expectExpansion(briefReader, "the");
+        expectEquals(briefReader.getWordLength(), 2);
+        typeChord(buffer, briefReader, 0b00100, 'z');
+        expectExpansion(briefReader, "there");
+        typeChord(buffer, briefReader, 0b00100, 'z');
+        expectExpansion(briefReader, "");
+
+        beginTest("Expanding briefs at word separators");
+        typeChord(buffer, briefReader, 0b10000, ' ');
+        typeChord(buffer, briefReader, 0b10000, 'q');
+        expectExpansion(briefReader, "and");
+        typeChord(buffer, briefReader, 0b10000, ' ');
+        typeChord(buffer, briefReader, 0b00010, 'w');
+        typeChord(buffer, briefReader, 0b00010, 'w');
+        typeChord(buffer, briefReader, 0b00001, '.');
+        expectBuffer(buffer, "xyzz and was.");
+
+        beginTest("Editing words cancels briefs");
+        buffer.clear();
+        typeChord(buffer, briefReader, 0b00001, 'x');
+        typeChord(buffer, briefReader, 0b01010, 'y');
+        buffer.deleteLastChar();
+        typeChord(buffer, briefReader, 0b01010, 'y');
+        expectExpansion(briefReader, "");
+        typeChord(buffer, briefReader, 0b10000, ' ');
+        expectBuffer(buffer, "xy ");
+        typeChord(buffer, briefReader, 0b00001, 'x');
+        buffer.appendCharacter('y');
+        expectExpansion(briefReader, "");
+        buffer.clear();
+        typeChord(buffer, briefReader, 0b10000, 'q');
+        expectExpansion(briefReader, "and");
+
+        beginTest("Reading existing text");
+        briefReader.readText(toCharString("some text"));
+        typeChord(buffer, briefReader, 0b10000, 'q');
+        expectExpansion(briefReader, "");
+        briefReader.readText(toCharString("some text "));
+        typeChord(buffer, briefReader, 0b10000, 'q');
+        expectExpansion(briefReader, "and");
+        buffer.removeListener(&briefReader);
+    }
+
+private:
+    /**
+     * @brief  Converts a test string to character values.
+     *
+     * @param text  A string of ISO 8859-1 characters.
+     *
+     * @return      The string's character values.
+     */
+    static Text::CharString toCharString(const juce::String& text)
+    {
+        Text::CharString charString;
+        for (int i = 0; i < text.length(); i++)
+        {
+            charString.add((Text::CharValue) text[i]);
+        }
+        return charString;
+    }
+
+    /**
+     * @brief  Adds a character typed with a chord to the buffer, expanding
+     *         the last word first if it matches a brief and the character is
+     *         a word separator, in the same way as Input::Controller.
+     *
+     * @param buffer       The output buffer.
+     *
+     * @param briefReader  A BriefReader listening to the buffer.
+     *
+     * @param chord        The chord's bitmap value.
+     *
+     * @param typedChar    The character the chord types.
+     */
+    static void typeChord(Output::Buffer& buffer, BriefReader& briefReader,
+            const Chord::uint8 chord, const Text::CharValue typedChar)
+    {
+        const Text::CharString* expansion = briefReader.getExpansion();
+        if (! BriefReader::isWordCharacter(typedChar) && expansion != nullptr)
+        {
+            const Text::CharString briefText = *expansion;
+            for (int i = briefReader.getWordLength(); i > 0; i--)
+            {
+                buffer.deleteLastChar();
+            }
+            for (const Text::CharValue& briefChar : briefText)
+            {
+                buffer.appendCharacter(briefChar);
+            }
+        }
+        briefReader.chordEntered(Chord(chord));
+        buffer.appendCharacter(typedChar);
+    }
+
+    /**
+     * @brief  Checks the current word's brief expansion.
+     *
+     * @param briefReader  The BriefReader to check.
+     *
+     * @param expected     The expected expansion, or the empty string if the
+     *                     current word shouldn't match a brief.
+     */
+    void expectExpansion(const BriefReader& briefReader,
+            const juce::String& expected)
+    {
+        const Text::CharString* expansion = briefReader.getExpansion();
+        if (expected.isEmpty())
+        {
+            expect(expansion == nullptr, "Unexpected brief match!");
+            return;
+        }
+        expect(expansion != nullptr && *expansion == toCharString(expected),
+                juce::String("Expected brief ") + expected);
+    }
+
+    /**
+     * @brief  Checks the buffered text.
+     *
+     * @param buffer    The output buffer to check.
+     *
+     * @param expected  The expected buffer contents.
+     */
+    void expectBuffer(const Output::Buffer& buffer,
+            const juce::String& expected)
+    {
+        expect(buffer.getBufferedText() == toCharString(expected),
+                juce::String("Expected buffer text \"") + expected + "\"");
+    }
+};
+
+static Input::Test::Briefs test;
@@ -0,0 +1,146 @@
+#include "Input_ChordState.h"
+#include "Input_ReleaseTiming.h"
+#include "JuceHeader.h"
+
+namespace Input { namespace Test { class ChordRollover; } }
+
+// Release delay used by all test timelines:
+static const constexpr int releaseDelay = 200;
+
+/**
+ * @brief  Checks how Input::ChordState enters chords with and without
+ *         rollover mode, using scripted key timelines.
+ */
+class Input::Test::ChordRollover : public juce::UnitTest
+{
+public:
+    ChordRollover() : juce::UnitTest("Chord Rollover", "Input") {}
+
+    void runTest() override
+    {
+        // Chord values used in timelines:
+        const Chord first(0b00011);
+        const Chord second(0b01100);
+        const Chord third(0b10000);
+
+        beginTest("Overlapping chords without rollover");
+        const juce::Array<KeyEvent> overlapping =
+        {
+            { true,  0, 0   }, { true,  1, 10  },
+            { false, 0, 80  },
+            { true,  2, 100 }, { true,  3, 110 },
+            { false, 1, 120 }, { false, 2, 180 }, { false, 3, 190 }
+        };
+        expectChords(overlapping, false, { Chord(0b01110) });
+
+        beginTest("Overlapping chords with rollover");
+        expectChords(overlapping, true, { first, second });
+
+        beginTest("Rolling over through several chords");
+        const juce::Array<KeyEvent> rolling =
+        {
+            { true,  0, 0   }, { true,  1, 10  },
+            { false, 0, 80  },
+            { true,  2, 100 }, { true,  3, 105 },
+            { false, 1, 110 }, { false, 2, 170 },
+            { true,  4, 180 },
+            { false, 3, 190 }, { false, 4, 250 }
+        };
+        expectChords(rolling, true, { first, second, third });
+
+        beginTest("Keys aren't added after rollover starts");
+        const juce::Array<KeyEvent> pressedFirst =
+        {
+            { true,  0, 0   }, { true,  1, 10  },
+            { true,  2, 20  },
+            { false, 0, 80  }, { false, 1, 90  }, { false, 2, 100 }
+        };
+        expectChords(pressedFirst, true, { Chord(0b00111) });
+
+        beginTest("Pressing a released key again doesn't roll over");
+        const juce::Array<KeyEvent> repressed =
+        {
+            { true,  0, 0   }, { true,  1, 10  },
+            { false, 0, 80  },
+            { true,  0, 120 },
+            { false, 0, 180 }, { false, 1, 190 }
+        };
+        expectChords(repressed, true, { first });
+
+        beginTest("Pausing still changes the selection before rollover");
+        const juce::Array<KeyEvent> paused =
+        {
+            { true,  0, 0   }, { true,  1, 10  }, { true,  2, 20  },
+            { false, 0, 80  },
+            { false, 1, 80 + releaseDelay },
+            { true,  3, 100 + releaseDelay },
+            { false, 2, 110 + releaseDelay }, { false, 3, 150 + releaseDelay }
+        };
+        expectChords(paused, true, { Chord(0b00110), Chord(0b01000) });
+
+        beginTest("Pausing before rollover selects the held keys");
+        const juce::Array<KeyEvent> pausedPress =
+        {
+            { true,  0, 0   }, { true,  1, 10  }, { true,  2, 20  },
+            { false, 0, 80  },
+            { true,  3, 100 + releaseDelay },
+            { false, 1, 110 + releaseDelay }, { false, 2, 120 + releaseDelay },
+            { false, 3, 150 + releaseDelay }
+        };
+        expectChords(pausedPress, true, { Chord(0b00110), Chord(0b01000) });
+    }
+
+private:
+    /**
+     * @brief  A single scripted chord key event.
+     */
+    struct KeyEvent
+    {
+        // True for key presses, false for key releases:
+        bool isPressed;
+        // The pressed or released chord key index:
+        int keyIndex;
+        // The event time, in milliseconds:
+        juce::uint32 time;
+    };
+
+    /**
+     * @brief  Runs a key timeline through a new ChordState, and checks that
+     *         it enters the expected chords in order.
+     *
+     * @param timeline      The key events to run, in order.
+     *
+     * @param rolloverMode  Whether the ChordState uses rollover mode.
+     *
+     * @param expected      The chords the timeline should enter.
+     */
+    void expectChords(const juce::Array<KeyEvent>& timeline,
+            const bool rolloverMode, const juce::Array<Chord>& expected)
+    {
+        Input::ReleaseTiming releaseTiming(releaseDelay, false);
+        ChordState chordState(releaseTiming, rolloverMode);
+        juce::Array<Chord> entered;
+        for (const KeyEvent& event : timeline)
+        {
+            const Chord enteredChord = event.isPressed
+                    ? chordState.keyPressed(event.keyIndex, event.time)
+                    : chordState.keyReleased(event.keyIndex, event.time);
+            if (enteredChord.isValid())
+            {
+                entered.add(enteredChord);
+            }
+        }
+        expectEquals(entered.size(), expected.size(),
+                "Wrong number of chords entered!");
+        for (int i = 0; i < entered.size() && i < expected.size(); i++)
+        {
+            expect(entered[i] == expected[i], juce::String("Expected ")
+                    + expected[i].toString() + ", found "
+                    + entered[i].toString());
+        }
+        expectEquals((int) chordState.getHeldKeys(), 0,
+                "Keys still held after the timeline ended!");
+    }
+};
+
+static Input::Test::ChordRollover test;
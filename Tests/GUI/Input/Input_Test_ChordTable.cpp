@@ -0,0 +1,92 @@
+#include "Input_Key_ChordTable.h"
+#include "Input_Key_ConfigFile.h"
+#include "Input_Key_JSONKeys.h"
+#include "JuceHeader.h"
+
+namespace Input { namespace Test { class ChordTable; } }
+
+/**
+ * @brief  Checks that Input::Key::ChordTable finds the same chord key indices
+ *         as comparing key presses against every chord key binding.
+ */
+class Input::Test::ChordTable : public juce::UnitTest
+{
+public:
+    ChordTable() : juce::UnitTest("Chord Key Table", "Input") {}
+
+    void runTest() override
+    {
+        namespace JSONKeys = Key::JSONKeys;
+        Key::ConfigFile keyConfig;
+        Key::ChordTable chordTable;
+
+        // Test every chord key with and without extra modifiers, in both
+        // cases, along with some keys that shouldn't be chord keys:
+        juce::Array<juce::KeyPress> testKeys;
+        for (const juce::Identifier* chordKey : JSONKeys::chordKeys)
+        {
+            const juce::KeyPress boundKey = keyConfig.getBoundKey(*chordKey);
+            const int keyCode = boundKey.getKeyCode();
+            testKeys.add(boundKey);
+            testKeys.add(juce::KeyPress(keyCode,
+                    juce::ModifierKeys::ctrlModifier, 0));
+            if (keyCode >= 0 && keyCode <= 255)
+            {
+                testKeys.add(juce::KeyPress((int) juce::CharacterFunctions
+                        ::toLowerCase((juce::juce_wchar) keyCode)));
+            }
+        }
+        testKeys.add(juce::KeyPress(juce::KeyPress::F9Key));
+        testKeys.add(juce::KeyPress(juce::KeyPress::numberPad7));
+        testKeys.add(juce::KeyPress(juce::KeyPress::escapeKey));
+
+        beginTest("Chord table matches binding search");
+        for (const juce::KeyPress& key : testKeys)
+        {
+            expectEquals(chordTable.getKeyIndex(key),
+                    searchBindings(keyConfig, key),
+                    juce::String("Wrong chord index for key ")
+                    + key.getTextDescription());
+        }
+
+        beginTest("Chord key codes map back to their indices");
+        for (int i = 0; i < JSONKeys::chordKeys.size(); i++)
+        {
+            const int keyCode = chordTable.getKeyCode(i);
+            expect(keyCode != 0, juce::String("Chord key ") + juce::String(i)
+                    + " has no key code!");
+            expectEquals(chordTable.getKeyIndex(keyCode), i);
+        }
+        expectEquals(chordTable.getKeyCode(-1), 0);
+        expectEquals(chordTable.getKeyCode(Key::ChordTable::maxChordKeys), 0);
+    }
+
+private:
+    /**
+     * @brief  Finds the chord key bound to a key press by checking every chord
+     *         key binding, the way Input::ChordReader did before it used a
+     *         chord table.
+     *
+     * @param keyConfig  The key binding configuration file.
+     *
+     * @param key        A key press event.
+     *
+     * @return           The matching chord key index, or -1 if no chord key
+     *                   matches.
+     */
+    int searchBindings(const Key::ConfigFile& keyConfig,
+            const juce::KeyPress& key)
+    {
+        const auto& chordKeys = Key::JSONKeys::chordKeys;
+        for (int i = 0; i < chordKeys.size(); i++)
+        {
+            if (keyConfig.getBoundKey(*chordKeys[i]) == key)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+};
+
+static Input::Test::ChordTable test;
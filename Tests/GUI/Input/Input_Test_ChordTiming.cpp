@@ -0,0 +1,131 @@
+#include "Input_ReleaseTiming.h"
+#include "Input_SessionReplay.h"
+#include "JuceHeader.h"
+
+namespace Input { namespace Test { class ChordTiming; } }
+
+// Release delay used before adaptive timing has enough data:
+static const constexpr int initialDelay = 300;
+// Milliseconds between releases when quickly entering a chord:
+static const constexpr int fastReleaseGap = 40;
+// Milliseconds a fast typist pauses to change the selected chord:
+static const constexpr int selectionPause = 150;
+// Number of quickly entered chords in the test session:
+static const constexpr int fastChordCount = 20;
+// Number of chords entered after changing the selection in the test session:
+static const constexpr int pausedChordCount = 5;
+
+/**
+ * @brief  Checks that Input::ReleaseTiming adapts to recorded release gaps,
+ *         and that Input::SessionReplay scores timing models correctly.
+ */
+class Input::Test::ChordTiming : public juce::UnitTest
+{
+public:
+    ChordTiming() : juce::UnitTest("Chord Release Timing", "Input") {}
+
+    void runTest() override
+    {
+        beginTest("Fixed timing ignores release gaps");
+        ReleaseTiming fixedTiming(initialDelay, false);
+        for (int i = 0; i < 100; i++)
+        {
+            fixedTiming.addReleaseGap(fastReleaseGap);
+        }
+        expectEquals(fixedTiming.getReleaseDelay(), initialDelay);
+
+        beginTest("Adaptive timing follows release gaps");
+        ReleaseTiming adaptiveTiming(initialDelay, true);
+        for (int i = 0; i < 8; i++)
+        {
+            adaptiveTiming.addReleaseGap(60);
+        }
+        expectEquals(adaptiveTiming.getReleaseDelay(), initialDelay,
+                "Release delay changed before enough gaps were recorded!");
+        for (int i = 0; i < 100; i++)
+        {
+            adaptiveTiming.addReleaseGap(60);
+        }
+        expectEquals(adaptiveTiming.getReleaseDelay(), 120);
+        for (int i = 0; i < 100; i++)
+        {
+            adaptiveTiming.addReleaseGap(1);
+        }
+        expectEquals(adaptiveTiming.getReleaseDelay(),
+                ReleaseTiming::minReleaseDelay);
+        for (int i = 0; i < 100; i++)
+        {
+            adaptiveTiming.addReleaseGap(1000);
+        }
+        expectEquals(adaptiveTiming.getReleaseDelay(),
+                ReleaseTiming::maxReleaseDelay);
+
+        beginTest("Replaying a fast typing session");
+        juce::TemporaryFile sessionFile;
+        expect(sessionFile.getFile().replaceWithText(createSession()),
+                "Failed to save test session!");
+        ReleaseTiming replayFixed(initialDelay, false);
+        const SessionReplay::Score fixedScore = SessionReplay::replay(
+                sessionFile.getFile(), replayFixed, false);
+        ReleaseTiming replayAdaptive(initialDelay, true);
+        const SessionReplay::Score adaptiveScore = SessionReplay::replay(
+                sessionFile.getFile(), replayAdaptive, false);
+        logMessage(juce::String("Fixed delay: ")
+                + juce::String(fixedScore.getAccuracy() * 100, 1) + "%, "
+                + juce::String(fixedScore.chordsPerMinute, 1)
+                + " chords/minute");
+        logMessage(juce::String("Adaptive delay: ")
+                + juce::String(adaptiveScore.getAccuracy() * 100, 1) + "%, "
+                + juce::String(adaptiveScore.chordsPerMinute, 1)
+                + " chords/minute");
+        expectEquals(fixedScore.chordCount, fastChordCount + pausedChordCount);
+        expectEquals(fixedScore.correctCount, fastChordCount);
+        expectEquals(adaptiveScore.correctCount,
+                fastChordCount + pausedChordCount);
+        expect(adaptiveScore.chordsPerMinute > fixedScore.chordsPerMinute,
+                "Adaptive timing should have higher throughput!");
+    }
+
+private:
+    /**
+     * @brief  Creates a session where a fast typist enters several two-key
+     *         chords, then changes the selection of several three-key chords
+     *         by pausing briefly between releases.
+     *
+     * @return  The session file text.
+     */
+    juce::String createSession()
+    {
+        juce::String session;
+        juce::uint32 time = 1000;
+        const auto addEvent = [&session, &time]
+                (const char* type, const int keyIndex, const int offset)
+        {
+            session += juce::String(type) + " " + juce::String(keyIndex) + " "
+                    + juce::String((juce::int64) (time + offset)) + "\n";
+        };
+        for (int i = 0; i < fastChordCount; i++)
+        {
+            addEvent("p", 0, 0);
+            addEvent("p", 1, 10);
+            addEvent("r", 0, 100);
+            addEvent("r", 1, 100 + fastReleaseGap);
+            session += "c 3\n";
+            time += 500;
+        }
+        for (int i = 0; i < pausedChordCount; i++)
+        {
+            addEvent("p", 0, 0);
+            addEvent("p", 1, 10);
+            addEvent("p", 2, 20);
+            addEvent("r", 0, 100);
+            addEvent("r", 1, 100 + selectionPause);
+            addEvent("r", 2, 110 + selectionPause);
+            session += "c 6\n";
+            time += 500;
+        }
+        return session;
+    }
+};
+
+static Input::Test::ChordTiming test;
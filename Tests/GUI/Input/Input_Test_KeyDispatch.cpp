@@ -0,0 +1,139 @@
+#include "Input_Key_DispatchTable.h"
+#include "Input_Key_ConfigFile.h"
+#include "JuceHeader.h"
+
+namespace Input { namespace Test { class KeyDispatch; } }
+
+// Number of times every test key press is looked up:
+static const constexpr int lookupRepetitions = 2000;
+
+/**
+ * @brief  Checks that Input::Key::DispatchTable finds the same actions as
+ *         searching every key binding, and compares how many key presses per
+ *         second each method can handle.
+ */
+class Input::Test::KeyDispatch : public juce::UnitTest
+{
+public:
+    KeyDispatch() : juce::UnitTest("Key Dispatch Benchmark", "Input") {}
+
+    void runTest() override
+    {
+        typedef Key::DispatchTable::Action Action;
+        Key::ConfigFile keyConfig;
+        Key::DispatchTable dispatchTable;
+
+        // Test every bound key, with and without extra modifiers, along with
+        // some keys that shouldn't be bound to anything:
+        juce::Array<juce::KeyPress> testKeys;
+        for (int i = 0; i < (int) Action::actionCount; i++)
+        {
+            const juce::KeyPress boundKey = keyConfig.getBoundKey(
+                    Key::DispatchTable::getBindingID((Action) i));
+            testKeys.add(boundKey);
+            testKeys.add(juce::KeyPress(boundKey.getKeyCode(),
+                    juce::ModifierKeys::ctrlModifier, 0));
+        }
+        testKeys.add(juce::KeyPress(juce::KeyPress::F9Key));
+        testKeys.add(juce::KeyPress(juce::KeyPress::numberPad7));
+        testKeys.add(juce::KeyPress('Q', juce::ModifierKeys::altModifier
+                    | juce::ModifierKeys::commandModifier, 0));
+
+        beginTest("Dispatch table matches binding search");
+        for (const juce::KeyPress& key : testKeys)
+        {
+            expectEquals((int) dispatchTable.getActionFlags(key),
+                    (int) searchBindings(keyConfig, key),
+                    juce::String("Wrong actions for key ")
+                    + key.getTextDescription());
+        }
+
+        beginTest("Binding search speed");
+        juce::uint32 searchFlags = 0;
+        const double searchRate = measureKeyRate(testKeys,
+                [this, &keyConfig, &searchFlags](const juce::KeyPress& key)
+        {
+            searchFlags ^= searchBindings(keyConfig, key);
+        });
+        logMessage(juce::String("Binding search: ")
+                + juce::String(searchRate, 0) + " lookups/second");
+
+        beginTest("Dispatch table speed");
+        juce::uint32 tableFlags = 0;
+        const double tableRate = measureKeyRate(testKeys,
+                [&dispatchTable, &tableFlags](const juce::KeyPress& key)
+        {
+            tableFlags ^= dispatchTable.getActionFlags(key);
+        });
+        logMessage(juce::String("Dispatch table: ")
+                + juce::String(tableRate, 0) + " lookups/second");
+        expectEquals((int) tableFlags, (int) searchFlags,
+                "Lookup methods found different actions!");
+        if (searchRate > 0)
+        {
+            logMessage(juce::String("Dispatch table speedup: ")
+                    + juce::String(tableRate / searchRate, 1) + "x");
+        }
+    }
+
+private:
+    /**
+     * @brief  Finds the actions bound to a key press by checking every key
+     *         binding, the way Input::Controller did before it used a
+     *         dispatch table.
+     *
+     * @param keyConfig  The key binding configuration file.
+     *
+     * @param key        A key press event.
+     *
+     * @return           Flags for all actions bound to the key press, as
+     *                   returned by Input::Key::DispatchTable::getActionFlags.
+     */
+    juce::uint32 searchBindings(const Key::ConfigFile& keyConfig,
+            const juce::KeyPress& key)
+    {
+        typedef Key::DispatchTable::Action Action;
+        juce::uint32 actionFlags = 0;
+        const juce::KeyPress unmoddedKey(key.getKeyCode());
+        for (int i = 0; i < (int) Action::actionCount; i++)
+        {
+            const juce::KeyPress boundKey = keyConfig.getBoundKey(
+                    Key::DispatchTable::getBindingID((Action) i));
+            if (boundKey.isValid()
+                    && (boundKey == key || boundKey == unmoddedKey))
+            {
+                actionFlags |= (1u << i);
+            }
+        }
+        return actionFlags;
+    }
+
+    /**
+     * @brief  Repeatedly looks up actions for a set of key presses, measuring
+     *         how many lookups finish per second. This only times the
+     *         lookups, not full key handling by the Input::Controller.
+     *
+     * @param testKeys  The key presses to look up.
+     *
+     * @param lookup    The lookup method to measure.
+     *
+     * @return          The number of key press lookups per second.
+     */
+    double measureKeyRate(const juce::Array<juce::KeyPress>& testKeys,
+            const std::function<void(const juce::KeyPress&)> lookup)
+    {
+        const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < lookupRepetitions; i++)
+        {
+            for (const juce::KeyPress& key : testKeys)
+            {
+                lookup(key);
+            }
+        }
+        const double seconds = juce::Time::highResolutionTicksToSeconds(
+                juce::Time::getHighResolutionTicks() - startTicks);
+        return (testKeys.size() * lookupRepetitions) / seconds;
+    }
+};
+
+static Input::Test::KeyDispatch test;
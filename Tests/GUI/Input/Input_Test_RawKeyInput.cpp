@@ -0,0 +1,163 @@
+#include "Input_ChordReader.h"
+#include "Input_RawKeySource.h"
+#include "Input_Key_ChordTable.h"
+#include "Testing_DelayUtils.h"
+#include "JuceHeader.h"
+#include <X11/extensions/XTest.h>
+
+namespace Input { namespace Test { class RawKeyInput; } }
+
+// Milliseconds to wait between checks for raw key events:
+static const constexpr int checkFrequency = 5;
+// Milliseconds to wait for raw key events before giving up:
+static const constexpr int timeoutPeriod = 2000;
+
+/**
+ * @brief  Checks that Input::RawKeySource reads key events created with XTest,
+ *         and that Input::ChordReader selects chords using raw event
+ *         timestamps.
+ *
+ *  This test creates its own key events, so it may run on any X server that
+ * supports XInput2 and XTest, including Xvfb:
+ *
+ *     xvfb-run ./build/Debug/KeyChord --test -categories Input
+ */
+class Input::Test::RawKeyInput : public juce::UnitTest
+{
+public:
+    RawKeyInput() : juce::UnitTest("Raw Key Input", "Input") {}
+
+    void runTest() override
+    {
+        Key::ChordTable chordTable;
+        const int firstKey = chordTable.getKeyCode(0);
+        const int secondKey = chordTable.getKeyCode(1);
+        const int thirdKey = chordTable.getKeyCode(2);
+        juce::Component keyComponent;
+        ChordReader chordReader(&keyComponent);
+        EnteredChords enteredChords;
+        chordReader.addListener(&enteredChords);
+
+        beginTest("Quick releases enter the full chord");
+        chordReader.rawKeyEvent(firstKey, true, 1000);
+        chordReader.rawKeyEvent(secondKey, true, 1010);
+        chordReader.rawKeyEvent(thirdKey, true, 1020);
+        chordReader.rawKeyEvent(firstKey, false, 1200);
+        chordReader.rawKeyEvent(secondKey, false, 1250);
+        chordReader.rawKeyEvent(thirdKey, false, 1300);
+        expectEquals(enteredChords.chords.size(), 1);
+        expect(enteredChords.chords.getLast() == Chord(0b111),
+                "Wrong chord entered after quick releases!");
+
+        beginTest("Slow releases change the selected chord");
+        chordReader.rawKeyEvent(firstKey, true, 2000);
+        chordReader.rawKeyEvent(secondKey, true, 2010);
+        chordReader.rawKeyEvent(thirdKey, true, 2020);
+        chordReader.rawKeyEvent(firstKey, false, 2200);
+        chordReader.rawKeyEvent(secondKey, false, 2900);
+        chordReader.rawKeyEvent(thirdKey, false, 2950);
+        expectEquals(enteredChords.chords.size(), 2);
+        expect(enteredChords.chords.getLast() == Chord(0b110),
+                "Wrong chord entered after a slow release!");
+
+        beginTest("Non-chord keys are ignored");
+        chordReader.rawKeyEvent(juce::KeyPress::F9Key, true, 3000);
+        chordReader.rawKeyEvent(juce::KeyPress::F9Key, false, 3010);
+        chordReader.rawKeyEvent(firstKey, false, 3020);
+        expectEquals(enteredChords.chords.size(), 2);
+        expect(! chordReader.getSelectedChord().isValid(),
+                "Unexpected chord selected!");
+
+        beginTest("Reading XTest key events");
+        RawEvents rawEvents;
+        RawKeySource rawKeySource([&rawEvents](const int keyCode,
+                const bool isPressed, const juce::uint32 serverTime)
+        {
+            const juce::ScopedLock eventLock(rawEvents.lock);
+            rawEvents.events.add(RawEvent { keyCode, isPressed, serverTime });
+        });
+        if (! rawKeySource.isReading())
+        {
+            logMessage("XInput2 is not available, skipping.");
+            return;
+        }
+        Display* display = XOpenDisplay(nullptr);
+        expect(display != nullptr, "Failed to open X display!");
+        if (display == nullptr)
+        {
+            return;
+        }
+        // Chord keys are bound to characters, which share their KeySym
+        // values:
+        const KeyCode xKeycode = XKeysymToKeycode(display, (KeySym)
+                juce::CharacterFunctions::toLowerCase(
+                    (juce::juce_wchar) firstKey));
+        expect(xKeycode != 0, "Chord key isn't on the keyboard!");
+        XTestFakeKeyEvent(display, xKeycode, True, CurrentTime);
+        XTestFakeKeyEvent(display, xKeycode, False, CurrentTime);
+        XSync(display, False);
+        XCloseDisplay(display);
+        Testing::DelayUtils::idleUntil([&rawEvents]()
+        {
+            const juce::ScopedLock eventLock(rawEvents.lock);
+            return rawEvents.events.size() >= 2;
+        }, checkFrequency, timeoutPeriod);
+
+        const juce::ScopedLock eventLock(rawEvents.lock);
+        expectEquals(rawEvents.events.size(), 2);
+        if (rawEvents.events.size() == 2)
+        {
+            const RawEvent& press = rawEvents.events.getReference(0);
+            const RawEvent& release = rawEvents.events.getReference(1);
+            expect(press.isPressed && ! release.isPressed,
+                    "Events arrived in the wrong order!");
+            expectEquals(chordTable.getKeyIndex(press.keyCode), 0);
+            expectEquals(chordTable.getKeyIndex(release.keyCode), 0);
+            expect(release.serverTime >= press.serverTime,
+                    "Release timestamp is earlier than press timestamp!");
+        }
+    }
+
+private:
+    /**
+     * @brief  Records all chords entered by a ChordReader.
+     */
+    class EnteredChords : public ChordReader::Listener
+    {
+    public:
+        juce::Array<Chord> chords;
+
+    private:
+        void selectedChordChanged(const Chord selectedChord) override { }
+
+        void chordEntered(const Chord selected) override
+        {
+            chords.add(selected);
+        }
+
+        void keyPressed(const juce::KeyPress key) override { }
+
+        void keyReleased() override { }
+    };
+
+    /**
+     * @brief  A single event read by the RawKeySource.
+     */
+    struct RawEvent
+    {
+        int keyCode;
+        bool isPressed;
+        juce::uint32 serverTime;
+    };
+
+    /**
+     * @brief  Stores events read on the RawKeySource thread.
+     */
+    struct RawEvents
+    {
+        juce::CriticalSection lock;
+        juce::Array<RawEvent> events;
+    };
+};
+
+static Input::Test::RawKeyInput test;
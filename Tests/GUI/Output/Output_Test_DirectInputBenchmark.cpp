@@ -0,0 +1,197 @@
+#include "Output_DirectInput.h"
+#include "Output_XTest.h"
+#include "Windows_XInterface.h"
+#include "Windows_FocusControl.h"
+#include "Testing_DelayUtils.h"
+#include "JuceHeader.h"
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+
+namespace Output { namespace Test { class DirectInputBenchmark; } }
+
+// Text sent to the receiving window by each output path:
+static const juce::String benchmarkText("direct input latency");
+// Milliseconds to wait between checks for received key events:
+static const constexpr int checkFrequency = 1;
+// Milliseconds to wait for key events to arrive before giving up:
+static const constexpr int timeoutPeriod = 5000;
+
+/**
+ * @brief  A bare X11 window that counts the key press events it receives.
+ */
+class KeyReceiver
+{
+public:
+    /**
+     * @brief  Creates and maps the window on a new display connection.
+     */
+    KeyReceiver() : display(XOpenDisplay(nullptr))
+    {
+        if (display == nullptr)
+        {
+            return;
+        }
+        window = XCreateSimpleWindow(display, XDefaultRootWindow(display),
+                0, 0, 100, 100, 0, 0, 0);
+        XClassHint classHint;
+        classHint.res_name = const_cast<char*>("keyReceiver");
+        classHint.res_class = const_cast<char*>("KeyReceiver");
+        XSetClassHint(display, window, &classHint);
+        XSelectInput(display, window, KeyPressMask | KeyReleaseMask);
+        XMapWindow(display, window);
+        XSync(display, False);
+    }
+
+    /**
+     * @brief  Destroys the window and closes its display connection.
+     */
+    ~KeyReceiver()
+    {
+        if (display != nullptr)
+        {
+            XDestroyWindow(display, window);
+            XCloseDisplay(display);
+        }
+    }
+
+    /**
+     * @brief  Reads all pending events, counting key press events.
+     *
+     * @return  The total number of key press events received so far.
+     */
+    int countKeyPresses()
+    {
+        while (XPending(display) > 0)
+        {
+            XEvent event;
+            XNextEvent(display, &event);
+            if (event.type == KeyPress)
+            {
+                keyPresses++;
+            }
+        }
+        return keyPresses;
+    }
+
+    // The receiver's display connection:
+    Display* display;
+    // The receiver's window ID:
+    Window window = 0;
+
+private:
+    // Number of key press events received:
+    int keyPresses = 0;
+};
+
+/**
+ * @brief  Compares the time needed to deliver a key to a window using the
+ *         focus-free Output::DirectInput path against the time needed to
+ *         focus the window, type the key with XTest, and restore focus.
+ *
+ *  The direct input path works under Xvfb without a window manager. The focus
+ * path depends on the _NET_ACTIVE_WINDOW protocol, so it is skipped if the
+ * receiving window can't be focused.
+ */
+class Output::Test::DirectInputBenchmark : public juce::UnitTest
+{
+public:
+    DirectInputBenchmark() :
+        juce::UnitTest("Output::DirectInput Benchmark", "Output") {}
+
+    void runTest() override
+    {
+        KeyReceiver receiver;
+        expect(receiver.display != nullptr, "Failed to open X display!");
+        if (receiver.display == nullptr)
+        {
+            return;
+        }
+
+        beginTest("Direct input latency");
+        const int targetWindow = (int) receiver.window;
+        const double directLatency = measureLatency(receiver, [targetWindow]
+                (const Text::CharValue keyValue)
+        {
+            return DirectInput::sendKey(keyValue, 0, targetWindow);
+        });
+        logMessage(juce::String("Direct input: ")
+                + juce::String(directLatency, 3) + " ms/key");
+
+        beginTest("Focus change latency");
+        if (! XTest::isAvailable())
+        {
+            logMessage("XTest extension is not available, skipping.");
+            return;
+        }
+        Windows::XInterface xInterface;
+        const int appWindow = xInterface.getActiveWindow();
+        bool canFocus = true;
+        Windows::FocusControl focusControl;
+        focusControl.focusWindow(targetWindow, [&canFocus]()
+        {
+            canFocus = false;
+        });
+        if (! canFocus)
+        {
+            logMessage("Window focus can't be changed, skipping.");
+            return;
+        }
+        const double focusLatency = measureLatency(receiver,
+                [targetWindow, appWindow](const Text::CharValue keyValue)
+        {
+            Windows::FocusControl keyFocusControl;
+            keyFocusControl.focusWindow(targetWindow);
+            const bool sent = XTest::sendKey(keyValue, 0);
+            keyFocusControl.focusWindow(appWindow);
+            return sent;
+        });
+        logMessage(juce::String("Focus change: ")
+                + juce::String(focusLatency, 3) + " ms/key");
+        if (directLatency > 0)
+        {
+            logMessage(juce::String("Direct input speedup: ")
+                    + juce::String(focusLatency / directLatency, 1) + "x");
+        }
+    }
+
+private:
+    /**
+     * @brief  Sends each benchmark text character to the receiver window,
+     *         measuring the average time before each key press arrives.
+     *
+     * @param receiver  The window receiving key events.
+     *
+     * @param sendKey   Sends a single key value to the receiver window.
+     *
+     * @return          The average delivery time per key, in milliseconds.
+     */
+    double measureLatency(KeyReceiver& receiver,
+            const std::function<bool(const Text::CharValue)> sendKey)
+    {
+        const int startCount = receiver.countKeyPresses();
+        const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+        int sentCount = 0;
+        for (int i = 0; i < benchmarkText.length(); i++)
+        {
+            if (! sendKey((Text::CharValue) benchmarkText[i]))
+            {
+                continue;
+            }
+            sentCount++;
+            const bool received = Testing::DelayUtils::idleUntil(
+                    [&receiver, startCount, sentCount]()
+            {
+                return receiver.countKeyPresses() >= startCount + sentCount;
+            }, checkFrequency, timeoutPeriod);
+            expect(received, "Key event never arrived!");
+        }
+        expectEquals(sentCount, benchmarkText.length(),
+                "Failed to send all keys!");
+        const double milliseconds = 1000.0
+                * juce::Time::highResolutionTicksToSeconds(
+                    juce::Time::getHighResolutionTicks() - startTicks);
+        return sentCount > 0 ? (milliseconds / sentCount) : 0;
+    }
+};
+
+static Output::Test::DirectInputBenchmark test;
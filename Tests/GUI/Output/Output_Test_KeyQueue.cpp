@@ -0,0 +1,100 @@
+#include "Output_KeyQueue.h"
+#include "JuceHeader.h"
+
+namespace Output { namespace Test { class KeyQueueTest; } }
+
+// Number of events passed between threads in the concurrent test:
+static const constexpr int concurrentEventCount = 200000;
+
+/**
+ * @brief  Checks that the Output::KeyQueue keeps events in order, respects its
+ *         capacity, and safely passes events between two threads.
+ */
+class Output::Test::KeyQueueTest : public juce::UnitTest
+{
+public:
+    KeyQueueTest() : juce::UnitTest("Output::KeyQueue Testing", "Output") {}
+
+    void runTest() override
+    {
+        KeyQueue keyQueue;
+        KeyQueue::Event event;
+
+        beginTest("Empty queue");
+        expectEquals(keyQueue.size(), 0);
+        expectEquals(keyQueue.freeSpace(), (int) KeyQueue::capacity);
+        expect(! keyQueue.pop(event), "Popped an event from an empty queue!");
+
+        beginTest("Filling queue");
+        for (int i = 0; i < KeyQueue::capacity; i++)
+        {
+            event.keyValue = (Text::CharValue) (i % 256);
+            event.modifierFlags = i;
+            expect(keyQueue.push(event), "Failed to push to a non-full queue!");
+        }
+        expectEquals(keyQueue.size(), (int) KeyQueue::capacity);
+        expectEquals(keyQueue.freeSpace(), 0);
+        expect(! keyQueue.push(event), "Pushed an event to a full queue!");
+
+        beginTest("Emptying queue in order");
+        for (int i = 0; i < KeyQueue::capacity; i++)
+        {
+            expect(keyQueue.pop(event),
+                    "Failed to pop from a non-empty queue!");
+            expectEquals(event.modifierFlags, i, "Events popped out of order!");
+        }
+        expectEquals(keyQueue.size(), 0);
+
+        beginTest("Concurrent producer and consumer");
+        ProducerThread producer(keyQueue);
+        producer.startThread();
+        int expectedValue = 0;
+        bool inOrder = true;
+        const juce::uint32 timeout = juce::Time::getMillisecondCounter()
+                + 10000;
+        while (expectedValue < concurrentEventCount
+                && juce::Time::getMillisecondCounter() < timeout)
+        {
+            if (keyQueue.pop(event))
+            {
+                inOrder = inOrder && (event.modifierFlags == expectedValue);
+                expectedValue++;
+            }
+        }
+        producer.stopThread(1000);
+        expect(inOrder, "Events passed between threads arrived out of order!");
+        expectEquals(expectedValue, concurrentEventCount,
+                "Not all events passed between threads arrived!");
+    }
+
+private:
+    /**
+     * @brief  Pushes a numbered sequence of events onto a queue.
+     */
+    class ProducerThread : public juce::Thread
+    {
+    public:
+        ProducerThread(KeyQueue& keyQueue) :
+            juce::Thread("KeyQueue Producer"), keyQueue(keyQueue) { }
+
+        virtual ~ProducerThread() { }
+
+    private:
+        void run() override
+        {
+            KeyQueue::Event event;
+            for (int i = 0; i < concurrentEventCount && ! threadShouldExit();)
+            {
+                event.modifierFlags = i;
+                if (keyQueue.push(event))
+                {
+                    i++;
+                }
+            }
+        }
+
+        KeyQueue& keyQueue;
+    };
+};
+
+static Output::Test::KeyQueueTest test;
@@ -0,0 +1,118 @@
+#include "Output_Sending.h"
+#include "Output_XTest.h"
+#include "Testing_Window.h"
+#include "Testing_DelayUtils.h"
+#include "JuceHeader.h"
+#include <cstdlib>
+
+namespace Output { namespace Test { class SendBenchmark; } }
+
+// Text typed into the test window by each output method:
+static const juce::String benchmarkText
+        = "The quick brown fox jumps over 13 lazy dogs.";
+// Number of times each method types the benchmark text:
+static const constexpr int benchmarkRepetitions = 3;
+// Milliseconds to wait between checks for typed text or window focus:
+static const constexpr int checkFrequency = 5;
+// Milliseconds to wait for typed text or window focus before giving up:
+static const constexpr int timeoutPeriod = 30000;
+
+/**
+ * @brief  Compares the number of characters per second each
+ *         Output::Sending::Method can type into a focused window.
+ *
+ *  This test types into a window it creates itself, so it may run on any X
+ * server, including Xvfb:
+ *
+ *     xvfb-run ./build/Debug/KeyChord --test -categories Output
+ */
+class Output::Test::SendBenchmark : public juce::UnitTest
+{
+public:
+    SendBenchmark() : juce::UnitTest("Output::Sending Benchmark", "Output") {}
+
+    void runTest() override
+    {
+        // The test window takes ownership of the text editor:
+        juce::TextEditor* textEditor = new juce::TextEditor;
+        Testing::Window testWindow("SendBenchmark", textEditor, 0, 0, 320,
+                240);
+
+        beginTest("Focusing benchmark window");
+        testWindow.toFront(true);
+        textEditor->grabKeyboardFocus();
+        const bool focused = Testing::DelayUtils::idleUntil([textEditor]()
+        {
+            return textEditor->hasKeyboardFocus(true);
+        }, checkFrequency, timeoutPeriod);
+        expect(focused, "Failed to focus the benchmark window!");
+        if (! focused)
+        {
+            return;
+        }
+
+        double xdotoolRate = 0;
+        beginTest("xdotool output speed");
+        if (std::system("command -v xdotool > /dev/null 2>&1") == 0)
+        {
+            xdotoolRate = measureCharRate(*textEditor,
+                    Sending::Method::xdotool);
+            logMessage(juce::String("xdotool: ") + juce::String(xdotoolRate, 1)
+                    + " characters/second");
+        }
+        else
+        {
+            logMessage("xdotool is not installed, skipping.");
+        }
+
+        beginTest("XTest output speed");
+        expect(XTest::isAvailable(), "XTest extension is not available!");
+        if (XTest::isAvailable())
+        {
+            const double xTestRate = measureCharRate(*textEditor,
+                    Sending::Method::xTest);
+            logMessage(juce::String("XTest: ") + juce::String(xTestRate, 1)
+                    + " characters/second");
+            if (xdotoolRate > 0)
+            {
+                logMessage(juce::String("XTest speedup: ")
+                        + juce::String(xTestRate / xdotoolRate, 1) + "x");
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief  Types the benchmark text into the focused text editor, measuring
+     *         how quickly it arrives.
+     *
+     * @param textEditor  The focused editor that will receive the text.
+     *
+     * @param method      The method used to create key events.
+     *
+     * @return            The number of characters typed per second.
+     */
+    double measureCharRate(juce::TextEditor& textEditor,
+            const Sending::Method method)
+    {
+        const juce::String expectedText
+                = benchmarkText.repeatedString(benchmarkRepetitions);
+        textEditor.clear();
+        const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < expectedText.length(); i++)
+        {
+            Sending::typeKey((Text::CharValue) expectedText[i], 0, method);
+        }
+        Testing::DelayUtils::idleUntil([&textEditor, &expectedText]()
+        {
+            return textEditor.getText().length() >= expectedText.length();
+        }, checkFrequency, timeoutPeriod);
+        const double seconds = juce::Time::highResolutionTicksToSeconds(
+                juce::Time::getHighResolutionTicks() - startTicks);
+        expectEquals(textEditor.getText(), expectedText,
+                "Typed text did not arrive intact!");
+        return expectedText.length() / seconds;
+    }
+};
+
+static Output::Test::SendBenchmark test;
@@ -0,0 +1,259 @@
+#include "Output_WordPredictor.h"
+#include "Output_Buffer.h"
+#include "Text_WordTrie.h"
+#include "JuceHeader.h"
+
+namespace Output { namespace Test { class WordPredictorTest; } }
+
+// Ranked word list used for most tests:
+static const char* rankedWords =
+        "the 500\n"
+        "then 120\n"
+        "there 300\n"
+        "they 250\n"
+        "their 200\n"
+        "these 90\n"
+        "them 150\n"
+        "don't 80\n"
+        "x-ray 70\n";
+// Word list without frequencies, sorted from most to least frequent:
+static const char* unrankedWords =
+        "alpha\n"
+        "alps\n"
+        "alpine\n";
+// Number of generated words used to measure index loading:
+static const constexpr int generatedWordCount = 50000;
+
+/**
+ * @brief  Checks that Text::WordTrie ranks completions by frequency, and that
+ *         Output::WordPredictor updates suggestions as Output::Buffer text
+ *         changes.
+ */
+class Output::Test::WordPredictorTest : public juce::UnitTest
+{
+public:
+    WordPredictorTest() : juce::UnitTest("Output::WordPredictor Testing",
+            "Output") {}
+
+    void runTest() override
+    {
+        juce::TemporaryFile wordList(".txt");
+        juce::TemporaryFile indexFile(".trie");
+        expect(wordList.getFile().replaceWithText(rankedWords),
+                "Failed to save test word list!");
+
+        beginTest("Building and loading word index");
+        expect(Text::WordTrie::buildIndex(wordList.getFile(),
+                    indexFile.getFile()), "Failed to build word index!");
+        Text::WordTrie wordTrie;
+        expect(wordTrie.loadIndex(indexFile.getFile()),
+                "Failed to load word index!");
+
+        beginTest("Completions are ranked by frequency");
+        expectCompletions(wordTrie, "th",
+                { "e", "ere", "ey", "eir", "em", "en", "ese" });
+        expectCompletions(wordTrie, "the",
+                { "", "re", "y", "ir", "m", "n", "se" });
+        expectCompletions(wordTrie, "THE",
+                { "", "re", "y", "ir", "m", "n", "se" });
+        expectCompletions(wordTrie, "don'", { "t" });
+
+        beginTest("Unknown prefixes and words");
+        expect(getNode(wordTrie, "thx") == Text::WordTrie::noNode,
+                "Found a prefix that isn't in the word list!");
+        expect(getNode(wordTrie, "x") == Text::WordTrie::noNode,
+                "Found a word with invalid characters!");
+
+        beginTest("Unranked words use list order");
+        expect(wordList.getFile().replaceWithText(unrankedWords),
+                "Failed to save test word list!");
+        expect(Text::WordTrie::buildIndex(wordList.getFile(),
+                    indexFile.getFile()), "Failed to build word index!");
+        expect(wordTrie.loadIndex(indexFile.getFile()),
+                "Failed to load word index!");
+        expectCompletions(wordTrie, "alp", { "ha", "s", "ine" });
+
+        beginTest("Suggestions follow buffer changes");
+        expect(wordList.getFile().replaceWithText(rankedWords),
+                "Failed to save test word list!");
+        const juce::File predictorIndex = wordList.getFile().getSiblingFile(
+                wordList.getFile().getFileName() + ".trie");
+        {
+            Buffer buffer;
+            WordPredictor predictor(wordList.getFile());
+            expect(predictor.isEnabled(), "Failed to load word list!");
+            buffer.addListener(&predictor);
+            appendText(buffer, "th");
+            expectSuggestions(predictor, { "e", "ere", "ey" });
+            appendText(buffer, "e");
+            expectSuggestions(predictor, { "re", "y", "ir" });
+            appendText(buffer, " ");
+            expectSuggestions(predictor, { });
+            buffer.deleteLastChar();
+            expectSuggestions(predictor, { "re", "y", "ir" });
+            buffer.deleteLastChar();
+            expectSuggestions(predictor, { "e", "ere", "ey" });
+            appendText(buffer, "q");
+            expectSuggestions(predictor, { });
+            buffer.deleteLastChar();
+            expectSuggestions(predictor, { "e", "ere", "ey" });
+            appendText(buffer, ", TH");
+            expectSuggestions(predictor, { "e", "ere", "ey" });
+            buffer.clear();
+            expectSuggestions(predictor, { });
+
+            beginTest("Suggestions for existing buffer text");
+            appendText(buffer, "they and the");
+            WordPredictor newPredictor(wordList.getFile());
+            newPredictor.readText(buffer.getBufferedText());
+            expectSuggestions(newPredictor, { "re", "y", "ir" });
+            buffer.removeListener(&predictor);
+        }
+        expect(predictorIndex.existsAsFile(), "Word index wasn't saved!");
+        predictorIndex.deleteFile();
+
+        beginTest("Index loading speed");
+        juce::String generatedList;
+        juce::Random random = getRandom();
+        for (int i = 0; i < generatedWordCount; i++)
+        {
+            const int length = 2 + random.nextInt(10);
+            for (int c = 0; c < length; c++)
+            {
+                generatedList += (juce::juce_wchar) ('a' + random.nextInt(26));
+            }
+            generatedList += "\n";
+        }
+        expect(wordList.getFile().replaceWithText(generatedList),
+                "Failed to save test word list!");
+        expect(Text::WordTrie::buildIndex(wordList.getFile(),
+                    indexFile.getFile()), "Failed to build word index!");
+        const double loadStart = juce::Time::getMillisecondCounterHiRes();
+        Text::WordTrie generatedTrie;
+        expect(generatedTrie.loadIndex(indexFile.getFile()),
+                "Failed to load word index!");
+        juce::Array<Text::CharString> completions;
+        completions.resize(WordPredictor::maxSuggestions);
+        const int completionCount = generatedTrie.getCompletions(
+                getNode(generatedTrie, "a"), completions.getRawDataPointer(),
+                completions.size());
+        const double loadTime = juce::Time::getMillisecondCounterHiRes()
+                - loadStart;
+        logMessage(juce::String("Loaded ") + juce::String(generatedWordCount)
+                + " word index (" + juce::String(
+                    indexFile.getFile().getSize() / 1024) + " KB) in "
+                + juce::String(loadTime, 3) + " ms");
+        expectEquals(completionCount, completions.size(),
+                "Generated word index is missing completions!");
+    }
+
+private:
+    /**
+     * @brief  Converts a test string to character values.
+     *
+     * @param text  A string of ISO 8859-1 characters.
+     *
+     * @return      The string's character values.
+     */
+    static Text::CharString toCharString(const juce::String& text)
+    {
+        Text::CharString charString;
+        for (int i = 0; i < text.length(); i++)
+        {
+            charString.add((Text::CharValue) text[i]);
+        }
+        return charString;
+    }
+
+    /**
+     * @brief  Adds each character in a test string to an output buffer.
+     *
+     * @param buffer  The buffer to update.
+     *
+     * @param text    The text to add.
+     */
+    static void appendText(Buffer& buffer, const juce::String& text)
+    {
+        for (const Text::CharValue& textChar : toCharString(text))
+        {
+            buffer.appendCharacter(textChar);
+        }
+    }
+
+    /**
+     * @brief  Finds the trie node matching a prefix.
+     *
+     * @param wordTrie  A loaded word trie.
+     *
+     * @param prefix    The prefix to find.
+     *
+     * @return          The prefix node, or Text::WordTrie::noNode if no words
+     *                  begin with the prefix.
+     */
+    static Text::WordTrie::NodeIndex getNode(const Text::WordTrie& wordTrie,
+            const juce::String& prefix)
+    {
+        Text::WordTrie::NodeIndex node = Text::WordTrie::rootNode;
+        for (const Text::CharValue& prefixChar : toCharString(prefix))
+        {
+            if (node == Text::WordTrie::noNode)
+            {
+                break;
+            }
+            node = wordTrie.getChild(node, prefixChar);
+        }
+        return node;
+    }
+
+    /**
+     * @brief  Checks that a word trie finds the expected completions for a
+     *         prefix, in order.
+     *
+     * @param wordTrie  A loaded word trie.
+     *
+     * @param prefix    The prefix to complete.
+     *
+     * @param expected  Every completion the prefix should have.
+     */
+    void expectCompletions(const Text::WordTrie& wordTrie,
+            const juce::String& prefix, const juce::StringArray& expected)
+    {
+        const Text::WordTrie::NodeIndex node = getNode(wordTrie, prefix);
+        expect(node != Text::WordTrie::noNode,
+                juce::String("Missing prefix ") + prefix);
+        juce::Array<Text::CharString> completions;
+        completions.resize(expected.size() + 1);
+        const int count = wordTrie.getCompletions(node,
+                completions.getRawDataPointer(), completions.size());
+        expectEquals(count, expected.size(),
+                juce::String("Wrong completion count for ") + prefix);
+        for (int i = 0; i < count && i < expected.size(); i++)
+        {
+            expect(completions[i] == toCharString(expected[i]),
+                    juce::String("Wrong completion ") + juce::String(i)
+                    + " for " + prefix);
+        }
+    }
+
+    /**
+     * @brief  Checks that a word predictor has the expected suggestions, in
+     *         order.
+     *
+     * @param predictor  The predictor to check.
+     *
+     * @param expected   Every suggestion the predictor should have.
+     */
+    void expectSuggestions(const WordPredictor& predictor,
+            const juce::StringArray& expected)
+    {
+        expectEquals(predictor.getSuggestionCount(), expected.size(),
+                "Wrong suggestion count!");
+        for (int i = 0; i < expected.size(); i++)
+        {
+            expect(predictor.getSuggestion(i) == toCharString(expected[i]),
+                    juce::String("Expected suggestion ") + expected[i]);
+        }
+    }
+};
+
+static Output::Test::WordPredictorTest test;
@@ -0,0 +1,149 @@
+#include "Text_BinaryFont.h"
+#include "JuceHeader.h"
+
+namespace Text { namespace Test { class BinaryFontTest; } }
+
+// Number of characters in each row of the font image:
+static const constexpr int charRowWidth = 16;
+// Number of character values stored in the font:
+static const constexpr int charCount = 256;
+
+/**
+ * @brief  Checks that the character rows and bounds unpacked by
+ *         Text::BinaryFont match the pixels in the packed font image.
+ */
+class Text::Test::BinaryFontTest : public juce::UnitTest
+{
+public:
+    BinaryFontTest() : juce::UnitTest("Text::BinaryFont Testing", "Text") {}
+
+    void runTest() override
+    {
+        using namespace Text::BinaryFont;
+
+        beginTest("Character rows");
+        for (int character = 0; character < charCount; character++)
+        {
+            for (int row = 0; row < charSize; row++)
+            {
+                const juce::uint32 rowPixels
+                        = getCharacterRow((CharValue) character, row);
+                expectEquals((int) (rowPixels >> charSize), 0,
+                        juce::String("Pixels set past the edge of character ")
+                        + juce::String(character) + "!");
+                expectEquals((int) rowPixels,
+                        (int) readImageRow(character, row, charSize),
+                        juce::String("Wrong pixels in row ") + juce::String(row)
+                        + " of character " + juce::String(character) + "!");
+            }
+        }
+
+        beginTest("Double-wide character rows");
+        for (int character = 0; character < charCount; character++)
+        {
+            for (int row = 0; row < charSize; row++)
+            {
+                const juce::uint32 rowPixels
+                        = getDoubleCharRow((CharValue) character, row);
+                expectEquals((int) (rowPixels >> (charSize * 2)), 0,
+                        juce::String("Pixels set past the edge of double-wide ")
+                        + "character " + juce::String(character) + "!");
+                expectEquals((int) rowPixels,
+                        (int) readImageRow(character, row, charSize * 2),
+                        juce::String("Wrong pixels in row ") + juce::String(row)
+                        + " of double-wide character " + juce::String(character)
+                        + "!");
+            }
+        }
+
+        beginTest("Character bounds");
+        for (int character = 0; character < charCount; character++)
+        {
+            checkBounds(getCharacterBounds((CharValue) character),
+                    character, charSize);
+            checkBounds(getDoubleCharBounds((CharValue) character),
+                    character, charSize * 2);
+        }
+        const GlyphBounds spaceBounds = getCharacterBounds(' ');
+        expectEquals(spaceBounds.left, -1, "Space shouldn't have pixels!");
+        expectEquals(spaceBounds.right, -1, "Space shouldn't have pixels!");
+
+        beginTest("Invalid character values");
+        expectEquals((int) getCharacterRow(charCount, 0), 0,
+                "Invalid character returned pixels!");
+        expectEquals((int) getCharacterRow('A', charSize), 0,
+                "Invalid row returned pixels!");
+        expectEquals(getCharacterBounds(charCount).left, -1,
+                "Invalid character returned bounds!");
+    }
+
+private:
+    /**
+     * @brief  Reads a row of character pixels one at a time from the packed
+     *         font image.
+     *
+     * @param character  The index of a character in the font image.
+     *
+     * @param row        The index of a row of pixels in the character.
+     *
+     * @param rowSize    The number of pixels to read.
+     *
+     * @return           The row's pixels, with the leftmost pixel stored in
+     *                   the most significant of the row's rowSize bits.
+     */
+    static juce::uint32 readImageRow(const int character, const int row,
+            const int rowSize)
+    {
+        using Text::BinaryFont::charSize;
+        const int imageX = (character % charRowWidth) * charSize;
+        const int imageY = (character / charRowWidth) * charSize + row;
+        juce::uint32 rowPixels = 0;
+        for (int x = 0; x < rowSize; x++)
+        {
+            if (Text::BinaryFont::getImagePixel(imageX + x, imageY))
+            {
+                rowPixels |= (1u << (rowSize - x - 1));
+            }
+        }
+        return rowPixels;
+    }
+
+    /**
+     * @brief  Checks that character bounds match the character's pixels in
+     *         the packed font image.
+     *
+     * @param bounds     The bounds to check.
+     *
+     * @param character  The index of a character in the font image.
+     *
+     * @param rowSize    The width of the character, in pixels.
+     */
+    void checkBounds(const Text::BinaryFont::GlyphBounds bounds,
+            const int character, const int rowSize)
+    {
+        int left = -1;
+        int right = -1;
+        for (int row = 0; row < Text::BinaryFont::charSize; row++)
+        {
+            const juce::uint32 rowPixels
+                    = readImageRow(character, row, rowSize);
+            for (int x = 0; x < rowSize; x++)
+            {
+                if ((rowPixels & (1u << (rowSize - x - 1))) != 0)
+                {
+                    left = (left < 0) ? x : std::min(left, x);
+                    right = std::max(right, x + 1);
+                }
+            }
+        }
+        const juce::String charName = juce::String(character)
+                + ((rowSize > Text::BinaryFont::charSize)
+                    ? " (double-wide)" : "");
+        expectEquals(bounds.left, left,
+                juce::String("Wrong left bound for character ") + charName);
+        expectEquals(bounds.right, right,
+                juce::String("Wrong right bound for character ") + charName);
+    }
+};
+
+static Text::Test::BinaryFontTest test;
@@ -0,0 +1,147 @@
+#include "Text_CharSet_ChordOptimizer.h"
+#include "Text_CharSet_Cache.h"
+#include "Text_CharSet_JSONKeys.h"
+#include "JuceHeader.h"
+
+namespace Text { namespace Test { class ChordOptimizerTest; } }
+
+// Character set used for all tests. The rarest characters have the highest
+// priority, so the configured chords are as inefficient as possible:
+static const char* testCharSet =
+        "["
+        "  { \"character\": \" \" },"
+        "  { \"character\": \"e\", \"shifted\": \"E\" },"
+        "  { \"character\": \"t\", \"shifted\": \"T\" },"
+        "  { \"character\": \"a\", \"shifted\": \"A\" },"
+        "  { \"character\": \"n\", \"shifted\": \"N\" },"
+        "  { \"character\": \"q\", \"chord priority\": 3 },"
+        "  { \"character\": \"x\", \"chord priority\": 3 },"
+        "  { \"character\": \"z\", \"chord priority\": 3 },"
+        "  { \"character\": \"j\", \"chord priority\": 3 },"
+        "  { \"character\": \"k\", \"chord priority\": 3 },"
+        "  { \"missing\": \"character\" }"
+        "]";
+// Sample text used to count characters:
+static const char* testCorpus = "eat a tea, at ten";
+// Number of sample characters within the test character set:
+static const constexpr int corpusSetChars = 16;
+// Number of chord changes tried during optimization:
+static const constexpr int testIterations = 20000;
+
+/**
+ * @brief  Checks that Text::CharSet::ChordOptimizer counts sample characters,
+ *         lowers the expected typing cost of a character set, and saves
+ *         character set data that loads the optimized chords.
+ */
+class Text::Test::ChordOptimizerTest : public juce::UnitTest
+{
+public:
+    ChordOptimizerTest() : juce::UnitTest(
+            "Text::CharSet::ChordOptimizer Testing", "Text") {}
+
+    void runTest() override
+    {
+        using Text::CharSet::ChordOptimizer;
+        const juce::var setData = juce::JSON::parse(testCharSet);
+        const CharSet::Cache defaultSet(setData);
+
+        beginTest("Chord cost measurements");
+        expectEquals(ChordOptimizer::getChordCost(Input::Chord(0b00001)),
+                1.0, "Wrong single key chord cost!");
+        expectGreaterThan(
+                ChordOptimizer::getChordCost(Input::Chord(0b00101)),
+                ChordOptimizer::getChordCost(Input::Chord(0b00011)),
+                "Gapped chords should cost more than adjacent chords!");
+        expectGreaterThan(
+                ChordOptimizer::getTransitionCost(Input::Chord(0b00001),
+                    Input::Chord(0b11000)),
+                ChordOptimizer::getTransitionCost(Input::Chord(0b00001),
+                    Input::Chord(0b00011)),
+                "Changing more keys should cost more!");
+        expectEquals(ChordOptimizer::getTransitionCost(Input::Chord(0b00110),
+                    Input::Chord(0b00110)), 0.0,
+                "Repeated chords shouldn't have a transition cost!");
+
+        beginTest("Counting sample characters");
+        ChordOptimizer optimizer(setData);
+        optimizer.addText(testCorpus);
+        expectEquals((int) optimizer.getCharacterCount(), corpusSetChars,
+                "Wrong number of sample characters counted!");
+        optimizer.addText("TEA");
+        expectEquals((int) optimizer.getCharacterCount(), corpusSetChars + 3,
+                "Shifted characters weren't counted!");
+        expectEquals(optimizer.getOptimizedCost(),
+                optimizer.getDefaultCost(),
+                "Costs shouldn't change before optimizing!");
+
+        beginTest("Optimizing chord assignments");
+        optimizer.optimize(testIterations, 1);
+        expectLessThan(optimizer.getOptimizedCost(),
+                optimizer.getDefaultCost(),
+                "Optimization didn't lower the expected cost!");
+        juce::Array<juce::uint8> usedChords;
+        for (int i = 0; i < defaultSet.getSize(); i++)
+        {
+            const Input::Chord chord = optimizer.getChord(i);
+            expect(chord.isValid(), "Character assigned an invalid chord!");
+            expect(! usedChords.contains(chord.getByteValue()),
+                    "Chord assigned to multiple characters!");
+            usedChords.add(chord.getByteValue());
+        }
+        // The most frequent characters should need only one key:
+        for (const juce::juce_wchar frequentChar : { 'e', 't', 'a', ' ' })
+        {
+            const int index = getIndex(defaultSet, frequentChar);
+            expectEquals(ChordOptimizer::getChordCost(
+                        optimizer.getChord(index)), 1.0,
+                    juce::String("Frequent character \"")
+                    + juce::String::charToString(frequentChar)
+                    + "\" wasn't assigned a single key chord!");
+        }
+
+        beginTest("Saving optimized character sets");
+        const juce::var optimizedData = optimizer.getSetData();
+        expectEquals(optimizedData.size(), setData.size(),
+                "Saved set data has the wrong number of objects!");
+        for (const juce::var& charVar : *optimizedData.getArray())
+        {
+            expect(! charVar.hasProperty(CharSet::JSONKeys::chordPriority),
+                    "Saved characters shouldn't use chord priority!");
+        }
+        const CharSet::Cache optimizedSet(optimizedData);
+        expectEquals(optimizedSet.getSize(), defaultSet.getSize(),
+                "Saved set has the wrong number of characters!");
+        for (int i = 0; i < optimizedSet.getSize(); i++)
+        {
+            const CharValue charValue = optimizedSet.getCharAtIndex(i, false);
+            expect(optimizedSet.getCharacterChord(charValue)
+                    == optimizer.getChord(i),
+                    "Saved set didn't load the optimized chord!");
+        }
+    }
+
+private:
+    /**
+     * @brief  Finds the index of a character in a character set.
+     *
+     * @param charSet    The character set to search.
+     *
+     * @param character  An ASCII character in the set.
+     *
+     * @return           The character's index, or -1 if it isn't in the set.
+     */
+    static int getIndex(const CharSet::Cache& charSet,
+            const juce::juce_wchar character)
+    {
+        for (int i = 0; i < charSet.getSize(); i++)
+        {
+            if (charSet.getCharAtIndex(i, false) == (CharValue) character)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+};
+
+static Text::Test::ChordOptimizerTest test;
@@ -0,0 +1,193 @@
+#include "Text_GlyphCache.h"
+#include "Text_Painter.h"
+#include "Text_BinaryFont.h"
+#include "Text_Values.h"
+#include "JuceHeader.h"
+
+namespace Text { namespace Test { class GlyphCacheTest; } }
+
+// Number of character values checked:
+static const constexpr int charCount = 256;
+// Character draw sizes checked, as { width, height } pairs:
+static const constexpr int drawSizes [][2] =
+{
+    { 10, 10 },
+    { 30, 30 },
+    { 40, 20 },
+    { 25, 37 }
+};
+// Number of draw sizes checked:
+static const constexpr int drawSizeCount
+        = sizeof(drawSizes) / sizeof(drawSizes[0]);
+
+/**
+ * @brief  Checks that characters drawn by Text::Painter using cached glyph
+ *         images exactly match characters drawn one pixel run at a time by
+ *         the original Text::Painter::paintChar implementation.
+ */
+class Text::Test::GlyphCacheTest : public juce::UnitTest
+{
+public:
+    GlyphCacheTest() : juce::UnitTest("Text::GlyphCache Testing", "Text") {}
+
+    void runTest() override
+    {
+        beginTest("Cached glyphs match directly drawn characters");
+        for (int sizeIndex = 0; sizeIndex < drawSizeCount; sizeIndex++)
+        {
+            const int width = drawSizes[sizeIndex][0];
+            const int height = drawSizes[sizeIndex][1];
+            for (int character = 0; character < charCount; character++)
+            {
+                checkCharacter((CharValue) character, width, height);
+            }
+        }
+
+        beginTest("Limiting cached scales");
+        GlyphCache cache;
+        for (int scale = 1; scale <= GlyphCache::maxScales + 2; scale++)
+        {
+            cache.getGlyph('A', scale, scale);
+        }
+        expectEquals(cache.getScaleCount(), (int) GlyphCache::maxScales,
+                "Cache kept too many scales!");
+        cache.clear();
+        expectEquals(cache.getScaleCount(), 0, "Cache wasn't cleared!");
+        Text::Painter::clearGlyphCache();
+    }
+
+private:
+    /**
+     * @brief  Draws a character using both the cached and the original
+     *         drawing methods, checking that both draw the same pixels and
+     *         return the same right edge.
+     *
+     * @param character  The character value to draw.
+     *
+     * @param width      The width of the area where the character is drawn.
+     *
+     * @param height     The height of the area where the character is drawn.
+     */
+    void checkCharacter(const CharValue character, const int width,
+            const int height)
+    {
+        // Leave room on the left for pixels drawn before the character's
+        // position:
+        const int x = width;
+        const int y = 0;
+        juce::Image cachedImage(juce::Image::ARGB, width * 3, height, true);
+        juce::Image directImage(juce::Image::ARGB, width * 3, height, true);
+        int cachedEdge;
+        int directEdge;
+        {
+            juce::Graphics g(cachedImage);
+            g.setColour(juce::Colours::white);
+            cachedEdge = Text::Painter::paintChar(g, character, x, y, width,
+                    height);
+        }
+        {
+            juce::Graphics g(directImage);
+            g.setColour(juce::Colours::white);
+            directEdge = paintCharDirectly(g, character, x, y, width, height);
+        }
+        const juce::String charName = juce::String((int) character) + " at "
+                + juce::String(width) + "x" + juce::String(height);
+        expectEquals(cachedEdge, directEdge,
+                juce::String("Wrong right edge for character ") + charName);
+        expect(imagesMatch(cachedImage, directImage),
+                juce::String("Cached pixels don't match character ")
+                + charName);
+    }
+
+    /**
+     * @brief  Draws a character by filling each horizontal run of pixels,
+     *         the way Text::Painter::paintChar drew characters before glyphs
+     *         were cached.
+     *
+     * @param g          The graphics context used for drawing.
+     *
+     * @param character  The character value to draw.
+     *
+     * @param x          X coordinate where the character will be drawn.
+     *
+     * @param y          Y coordinate where the character will be drawn.
+     *
+     * @param width      Width of the area where the character is drawn.
+     *
+     * @param height     Height of the area where the character is drawn.
+     *
+     * @return           The x-coordinate of the end of the character.
+     */
+    static int paintCharDirectly(juce::Graphics& g, const CharValue character,
+            const int x, const int y, const int width, const int height)
+    {
+        using Text::BinaryFont::charSize;
+        const bool doubleWidth = Text::Values::isWideValue(character);
+        const int charWidth = doubleWidth ? charSize * 2 : charSize;
+        const int pixelWidth = std::max(1, width / charWidth);
+        const int pixelHeight = std::max(1, height / charSize);
+
+        int rightmost = x;
+        for (int row = 0; row < charSize; row++)
+        {
+            juce::uint32 rowPixels;
+            if (doubleWidth)
+            {
+                rowPixels = Text::BinaryFont::getDoubleCharRow(character, row);
+            }
+            else
+            {
+                rowPixels = Text::BinaryFont::getCharacterRow(character, row);
+            }
+            int pixelsToDraw = 0;
+            for (int xPixel = 0; xPixel < charWidth; xPixel++)
+            {
+                const bool pixelFound = ((1 << (charWidth - xPixel - 1))
+                        & rowPixels);
+                if (pixelFound)
+                {
+                    pixelsToDraw++;
+                }
+                if ((pixelsToDraw > 0) && (xPixel == (charWidth - 1)
+                            || !pixelFound))
+                {
+                    const int xPos = (xPixel - (pixelFound ? pixelsToDraw
+                            : pixelsToDraw + 1)) * pixelWidth + x;
+                    const int yPos = row * pixelHeight + y;
+                    const int runWidth = pixelsToDraw * pixelWidth;
+                    g.fillRect(xPos, yPos, runWidth, pixelHeight);
+                    rightmost = std::max(rightmost, xPos + runWidth + 1);
+                    pixelsToDraw = 0;
+                }
+            }
+        }
+        return rightmost;
+    }
+
+    /**
+     * @brief  Checks if two images of the same size contain the same pixels.
+     *
+     * @param first   The first image to compare.
+     *
+     * @param second  The second image to compare.
+     *
+     * @return        Whether every pixel in both images is identical.
+     */
+    static bool imagesMatch(const juce::Image& first,
+            const juce::Image& second)
+    {
+        for (int y = 0; y < first.getHeight(); y++)
+        {
+            for (int x = 0; x < first.getWidth(); x++)
+            {
+                if (first.getPixelAt(x, y) != second.getPixelAt(x, y))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+static Text::Test::GlyphCacheTest test;
@@ -0,0 +1,231 @@
+#include "Text_Painter.h"
+#include "Text_BinaryFont.h"
+#include "JuceHeader.h"
+
+namespace Text { namespace Test { class PainterTest; } }
+
+// Size of the image where test strings are drawn:
+static const constexpr int imageWidth = 320;
+static const constexpr int imageHeight = 40;
+// Maximum character size used when drawing test strings:
+static const constexpr int maxCharSize = 30;
+// Strings measured and drawn by each test:
+static const char* testStrings [] =
+{
+    "",
+    " ",
+    "KeyChord",
+    "The quick brown fox jumps over the lazy dog.",
+    "a  b\t!"
+};
+// Font pixel size used when checking individual characters:
+static const constexpr int testPixelSize = 3;
+
+/**
+ * @brief  Checks that Text::Painter string layouts match the strings drawn
+ *         by Text::Painter::paintString, that layouts reuse their storage, and
+ *         that updated layouts match layouts created from scratch.
+ */
+class Text::Test::PainterTest : public juce::UnitTest
+{
+public:
+    PainterTest() : juce::UnitTest("Text::Painter Testing", "Text") {}
+
+    void runTest() override
+    {
+        using namespace Text::Painter;
+
+        beginTest("Measuring string layouts");
+        StringLayout layout;
+        for (const char* testString : testStrings)
+        {
+            const CharString charString = toCharString(testString);
+            juce::Image paintedImage(juce::Image::ARGB, imageWidth,
+                    imageHeight, true);
+            int paintedEdge;
+            {
+                juce::Graphics g(paintedImage);
+                g.setColour(juce::Colours::white);
+                paintedEdge = paintString(g, charString, 0, 0, imageWidth,
+                        imageHeight, maxCharSize);
+            }
+            const int layoutEdge = layoutString(layout, charString, 0, 0,
+                    imageWidth, imageHeight, maxCharSize);
+            expectEquals(layoutEdge, paintedEdge, juce::String("Layout of \"")
+                    + testString + "\" has the wrong right edge!");
+            expectEquals(layout.rightEdge, layoutEdge,
+                    "Layout didn't save its right edge!");
+            expectEquals(layout.glyphs.size(), charString.size(),
+                    "Layout has the wrong number of characters!");
+
+            juce::Image layoutImage(juce::Image::ARGB, imageWidth,
+                    imageHeight, true);
+            {
+                juce::Graphics g(layoutImage);
+                g.setColour(juce::Colours::white);
+                paintLayout(g, layout);
+            }
+            expect(imagesMatch(layoutImage, paintedImage),
+                    juce::String("Drawn layout of \"") + testString
+                    + "\" doesn't match the painted string!");
+        }
+
+        beginTest("Reusing layout storage");
+        const CharString longString = toCharString(testStrings[3]);
+        layoutString(layout, longString, 0, 0, imageWidth, imageHeight,
+                maxCharSize);
+        const GlyphPosition* storage = layout.glyphs.getRawDataPointer();
+        for (const char* testString : testStrings)
+        {
+            layoutString(layout, toCharString(testString), 0, 0, imageWidth,
+                    imageHeight, maxCharSize);
+            expect(layout.glyphs.getRawDataPointer() == storage,
+                    "Layout reallocated storage for a shorter string!");
+        }
+
+        beginTest("Updating layouts");
+        const CharString shortString = toCharString(testStrings[2]);
+        layoutString(layout, shortString, 0, 0, imageWidth, imageHeight,
+                maxCharSize);
+        CharString edited = shortString;
+        edited.add((CharValue) 's');
+        expectEquals(updateLayout(layout, edited, 0, 0, imageWidth,
+                    imageHeight, maxCharSize), shortString.size(),
+                "Appending a character repositioned earlier characters!");
+        checkUpdatedLayout(layout, edited);
+        expectEquals(updateLayout(layout, edited, 0, 0, imageWidth,
+                    imageHeight, maxCharSize), edited.size(),
+                "Unchanged string was repositioned!");
+        edited.removeLast(2);
+        expectEquals(updateLayout(layout, edited, 0, 0, imageWidth,
+                    imageHeight, maxCharSize), edited.size(),
+                "Deleting characters repositioned earlier characters!");
+        checkUpdatedLayout(layout, edited);
+        edited.set(2, (CharValue) 'Y');
+        expectEquals(updateLayout(layout, edited, 0, 0, imageWidth,
+                    imageHeight, maxCharSize), 2,
+                "Replacing a character didn't reposition later characters!");
+        checkUpdatedLayout(layout, edited);
+        expectEquals(updateLayout(layout, longString, 0, 0, imageWidth,
+                    imageHeight, maxCharSize), 0,
+                "Rescaled string wasn't entirely repositioned!");
+        checkUpdatedLayout(layout, longString);
+        expectEquals(updateLayout(layout, longString, 0, 0, imageWidth / 2,
+                    imageHeight, maxCharSize), 0,
+                "Resized layout wasn't entirely repositioned!");
+
+        beginTest("Drawing leftmost character pixels");
+        for (int character = 0; character < 256; character++)
+        {
+            checkLeftColumn((CharValue) character);
+        }
+    }
+
+private:
+    /**
+     * @brief  Converts an ASCII string to a character value string.
+     *
+     * @param text  A string containing only ASCII characters.
+     *
+     * @return      The equivalent character value string.
+     */
+    static CharString toCharString(const char* text)
+    {
+        CharString charString;
+        for (const char* textChar = text; *textChar != 0; textChar++)
+        {
+            charString.add((CharValue) *textChar);
+        }
+        return charString;
+    }
+
+    /**
+     * @brief  Checks if two images of the same size contain the same pixels.
+     *
+     * @param first   The first image to compare.
+     *
+     * @param second  The second image to compare.
+     *
+     * @return        Whether every pixel in both images is identical.
+     */
+    static bool imagesMatch(const juce::Image& first,
+            const juce::Image& second)
+    {
+        for (int y = 0; y < first.getHeight(); y++)
+        {
+            for (int x = 0; x < first.getWidth(); x++)
+            {
+                if (first.getPixelAt(x, y) != second.getPixelAt(x, y))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief  Checks that an updated layout matches a layout created from
+     *         scratch.
+     *
+     * @param updated  A layout that was updated to hold a new string.
+     *
+     * @param toPrint  The string held by the updated layout.
+     */
+    void checkUpdatedLayout(const Text::Painter::StringLayout& updated,
+            const CharString& toPrint)
+    {
+        Text::Painter::StringLayout expected;
+        Text::Painter::layoutString(expected, toPrint, updated.x, updated.y,
+                updated.width, updated.height, updated.maxCharSize);
+        expectEquals(updated.glyphs.size(), expected.glyphs.size(),
+                "Updated layout has the wrong number of characters!");
+        for (int i = 0; i < expected.glyphs.size(); i++)
+        {
+            expect(updated.glyphs[i].character == expected.glyphs[i].character,
+                    "Updated layout has the wrong characters!");
+            expectEquals(updated.glyphs[i].x, expected.glyphs[i].x,
+                    "Updated layout has characters in the wrong position!");
+        }
+        expectEquals(updated.charSize, expected.charSize,
+                "Updated layout has the wrong character size!");
+        expectEquals(updated.rightEdge, expected.rightEdge,
+                "Updated layout has the wrong right edge!");
+    }
+
+    /**
+     * @brief  Checks that pixels in a character's leftmost column are drawn
+     *         one scaled pixel to the left of the character's position.
+     *
+     * @param character  The character value to check.
+     */
+    void checkLeftColumn(const CharValue character)
+    {
+        using Text::BinaryFont::charSize;
+        if (Text::BinaryFont::getCharacterBounds(character).left != 0
+                || Text::Values::isWideValue(character))
+        {
+            return;
+        }
+        int row = 0;
+        while ((Text::BinaryFont::getCharacterRow(character, row)
+                    & (1 << (charSize - 1))) == 0)
+        {
+            row++;
+        }
+        const int drawSize = charSize * testPixelSize;
+        juce::Image image(juce::Image::ARGB, drawSize * 2, drawSize, true);
+        {
+            juce::Graphics g(image);
+            g.setColour(juce::Colours::white);
+            Text::Painter::paintChar(g, character, drawSize, 0, drawSize,
+                    drawSize);
+        }
+        expect(image.getPixelAt(drawSize - testPixelSize,
+                    row * testPixelSize).getAlpha() > 0,
+                juce::String("Leftmost pixels of character ")
+                + juce::String(character) + " weren't drawn!");
+    }
+};
+
+static Text::Test::PainterTest test;
@@ -16,7 +16,8 @@ OBJECTS_COMPONENT := \
 
 COMPONENT_TEST_PREFIX := $(COMPONENT_PREFIX)Test_
 COMPONENT_TEST_OBJ := $(COMPONENT_OBJ)Test_
-OBJECTS_COMPONENT_TEST :=
+OBJECTS_COMPONENT_TEST := \
+  $(COMPONENT_TEST_OBJ)RenderBenchmark.o
 
 ifeq ($(BUILD_TESTS), 1)
     OBJECTS_COMPONENT := $(OBJECTS_COMPONENT) $(OBJECTS_COMPONENT_TEST)
@@ -43,3 +44,6 @@ $(COMPONENT_OBJ)InputView.o: \
 	$(COMPONENT_DIR)/$(COMPONENT_PREFIX)InputView.cpp
 $(COMPONENT_OBJ)HelpScreen.o: \
 	$(COMPONENT_DIR)/$(COMPONENT_PREFIX)HelpScreen.cpp
+
+$(COMPONENT_TEST_OBJ)RenderBenchmark.o: \
+	$(COMPONENT_TEST_DIR)/$(COMPONENT_TEST_PREFIX)RenderBenchmark.cpp
@@ -0,0 +1,36 @@
+############################  Daemon Module  ###################################
+DAEMON_DIR = Source/Framework/Daemon
+DAEMON_TEST_DIR = Tests/Framework/Daemon
+
+DAEMON_PREFIX = Daemon_
+DAEMON_OBJ := $(JUCE_OBJDIR)/$(DAEMON_PREFIX)
+OBJECTS_DAEMON := \
+  $(DAEMON_OBJ)Socket.o \
+  $(DAEMON_OBJ)Server.o \
+  $(DAEMON_OBJ)Client.o
+
+DAEMON_TEST_PREFIX := $(DAEMON_PREFIX)Test_
+DAEMON_TEST_OBJ := $(DAEMON_OBJ)Test_
+OBJECTS_DAEMON_TEST := \
+  $(DAEMON_TEST_OBJ)StartupBenchmark.o
+
+ifeq ($(BUILD_TESTS), 1)
+    OBJECTS_DAEMON := $(OBJECTS_DAEMON) $(OBJECTS_DAEMON_TEST)
+endif
+
+FRAMEWORK_MODULES := $(FRAMEWORK_MODULES) daemon
+
+OBJECTS_APP := $(OBJECTS_APP) $(OBJECTS_DAEMON)
+
+daemon : $(OBJECTS_DAEMON)
+	@echo "    Built Daemon module"
+
+$(DAEMON_OBJ)Socket.o : \
+    $(DAEMON_DIR)/$(DAEMON_PREFIX)Socket.cpp
+$(DAEMON_OBJ)Server.o : \
+    $(DAEMON_DIR)/$(DAEMON_PREFIX)Server.cpp
+$(DAEMON_OBJ)Client.o : \
+    $(DAEMON_DIR)/$(DAEMON_PREFIX)Client.cpp
+
+$(DAEMON_TEST_OBJ)StartupBenchmark.o : \
+    $(DAEMON_TEST_DIR)/$(DAEMON_TEST_PREFIX)StartupBenchmark.cpp
@@ -12,17 +12,31 @@ INPUT_KEY_OBJ := $(INPUT_OBJ)Key_
 OBJECTS_INPUT_KEY := \
   $(INPUT_KEY_OBJ)Binding.o \
   $(INPUT_KEY_OBJ)JSONResource.o \
-  $(INPUT_KEY_OBJ)ConfigFile.o
+  $(INPUT_KEY_OBJ)ConfigFile.o \
+  $(INPUT_KEY_OBJ)DispatchTable.o \
+  $(INPUT_KEY_OBJ)ChordTable.o
 
 OBJECTS_INPUT := \
   $(INPUT_OBJ)Chord.o \
   $(INPUT_OBJ)ChordReader.o \
   $(INPUT_OBJ)Controller.o \
+  $(INPUT_OBJ)RawKeySource.o \
+  $(INPUT_OBJ)ReleaseTiming.o \
+  $(INPUT_OBJ)ChordState.o \
+  $(INPUT_OBJ)SessionRecorder.o \
+  $(INPUT_OBJ)SessionReplay.o \
+  $(INPUT_OBJ)BriefReader.o \
   $(OBJECTS_INPUT_KEY)
 
 INPUT_TEST_PREFIX := $(INPUT_PREFIX)Test_
 INPUT_TEST_OBJ := $(INPUT_OBJ)Test_
-OBJECTS_INPUT_TEST :=
+OBJECTS_INPUT_TEST := \
+  $(INPUT_TEST_OBJ)KeyDispatch.o \
+  $(INPUT_TEST_OBJ)ChordTable.o \
+  $(INPUT_TEST_OBJ)RawKeyInput.o \
+  $(INPUT_TEST_OBJ)ChordTiming.o \
+  $(INPUT_TEST_OBJ)ChordRollover.o \
+  $(INPUT_TEST_OBJ)Briefs.o
 
 ifeq ($(BUILD_TESTS), 1)
     OBJECTS_INPUT := $(OBJECTS_INPUT) $(OBJECTS_INPUT_TEST)
@@ -41,6 +55,10 @@ $(INPUT_KEY_OBJ)JSONResource.o: \
 	$(INPUT_KEY_DIR)/$(INPUT_KEY_PREFIX)JSONResource.cpp
 $(INPUT_KEY_OBJ)ConfigFile.o: \
 	$(INPUT_KEY_DIR)/$(INPUT_KEY_PREFIX)ConfigFile.cpp
+$(INPUT_KEY_OBJ)DispatchTable.o: \
+	$(INPUT_KEY_DIR)/$(INPUT_KEY_PREFIX)DispatchTable.cpp
+$(INPUT_KEY_OBJ)ChordTable.o: \
+	$(INPUT_KEY_DIR)/$(INPUT_KEY_PREFIX)ChordTable.cpp
 
 $(INPUT_OBJ)Chord.o: \
 	$(INPUT_DIR)/$(INPUT_PREFIX)Chord.cpp
@@ -48,3 +66,28 @@ $(INPUT_OBJ)ChordReader.o: \
 	$(INPUT_DIR)/$(INPUT_PREFIX)ChordReader.cpp
 $(INPUT_OBJ)Controller.o: \
 	$(INPUT_DIR)/$(INPUT_PREFIX)Controller.cpp
+$(INPUT_OBJ)RawKeySource.o: \
+	$(INPUT_DIR)/$(INPUT_PREFIX)RawKeySource.cpp
+$(INPUT_OBJ)ReleaseTiming.o: \
+	$(INPUT_DIR)/$(INPUT_PREFIX)ReleaseTiming.cpp
+$(INPUT_OBJ)ChordState.o: \
+	$(INPUT_DIR)/$(INPUT_PREFIX)ChordState.cpp
+$(INPUT_OBJ)SessionRecorder.o: \
+	$(INPUT_DIR)/$(INPUT_PREFIX)SessionRecorder.cpp
+$(INPUT_OBJ)SessionReplay.o: \
+	$(INPUT_DIR)/$(INPUT_PREFIX)SessionReplay.cpp
+$(INPUT_OBJ)BriefReader.o: \
+	$(INPUT_DIR)/$(INPUT_PREFIX)BriefReader.cpp
+
+$(INPUT_TEST_OBJ)KeyDispatch.o: \
+	$(INPUT_TEST_DIR)/$(INPUT_TEST_PREFIX)KeyDispatch.cpp
+$(INPUT_TEST_OBJ)ChordTable.o: \
+	$(INPUT_TEST_DIR)/$(INPUT_TEST_PREFIX)ChordTable.cpp
+$(INPUT_TEST_OBJ)RawKeyInput.o: \
+	$(INPUT_TEST_DIR)/$(INPUT_TEST_PREFIX)RawKeyInput.cpp
+$(INPUT_TEST_OBJ)ChordTiming.o: \
+	$(INPUT_TEST_DIR)/$(INPUT_TEST_PREFIX)ChordTiming.cpp
+$(INPUT_TEST_OBJ)ChordRollover.o: \
+	$(INPUT_TEST_DIR)/$(INPUT_TEST_PREFIX)ChordRollover.cpp
+$(INPUT_TEST_OBJ)Briefs.o: \
+	$(INPUT_TEST_DIR)/$(INPUT_TEST_PREFIX)Briefs.cpp
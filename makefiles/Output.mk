@@ -7,12 +7,21 @@ OUTPUT_OBJ := $(JUCE_OBJDIR)/$(OUTPUT_PREFIX)
 
 OBJECTS_OUTPUT := \
   $(OUTPUT_OBJ)Buffer.o \
+  $(OUTPUT_OBJ)WordPredictor.o \
   $(OUTPUT_OBJ)Modifiers.o \
-  $(OUTPUT_OBJ)Sending.o
+  $(OUTPUT_OBJ)XTest.o \
+  $(OUTPUT_OBJ)DirectInput.o \
+  $(OUTPUT_OBJ)Sending.o \
+  $(OUTPUT_OBJ)KeyQueue.o \
+  $(OUTPUT_OBJ)Sender.o
 
 OUTPUT_TEST_PREFIX := $(OUTPUT_PREFIX)Test_
 OUTPUT_TEST_OBJ := $(OUTPUT_OBJ)Test_
-OBJECTS_OUTPUT_TEST :=
+OBJECTS_OUTPUT_TEST := \
+  $(OUTPUT_TEST_OBJ)SendBenchmark.o \
+  $(OUTPUT_TEST_OBJ)DirectInputBenchmark.o \
+  $(OUTPUT_TEST_OBJ)KeyQueue.o \
+  $(OUTPUT_TEST_OBJ)WordPredictor.o
 
 ifeq ($(BUILD_TESTS), 1)
     OBJECTS_OUTPUT := $(OBJECTS_OUTPUT) $(OBJECTS_OUTPUT_TEST)
@@ -27,7 +36,26 @@ OBJECTS_APP := $(OBJECTS_APP) $(OBJECTS_OUTPUT)
 
 $(OUTPUT_OBJ)Buffer.o: \
 	$(OUTPUT_DIR)/$(OUTPUT_PREFIX)Buffer.cpp
+$(OUTPUT_OBJ)WordPredictor.o: \
+	$(OUTPUT_DIR)/$(OUTPUT_PREFIX)WordPredictor.cpp
 $(OUTPUT_OBJ)Modifiers.o: \
 	$(OUTPUT_DIR)/$(OUTPUT_PREFIX)Modifiers.cpp
+$(OUTPUT_OBJ)XTest.o: \
+	$(OUTPUT_DIR)/$(OUTPUT_PREFIX)XTest.cpp
+$(OUTPUT_OBJ)DirectInput.o: \
+	$(OUTPUT_DIR)/$(OUTPUT_PREFIX)DirectInput.cpp
 $(OUTPUT_OBJ)Sending.o: \
 	$(OUTPUT_DIR)/$(OUTPUT_PREFIX)Sending.cpp
+$(OUTPUT_OBJ)KeyQueue.o: \
+	$(OUTPUT_DIR)/$(OUTPUT_PREFIX)KeyQueue.cpp
+$(OUTPUT_OBJ)Sender.o: \
+	$(OUTPUT_DIR)/$(OUTPUT_PREFIX)Sender.cpp
+
+$(OUTPUT_TEST_OBJ)SendBenchmark.o: \
+	$(OUTPUT_TEST_DIR)/$(OUTPUT_TEST_PREFIX)SendBenchmark.cpp
+$(OUTPUT_TEST_OBJ)DirectInputBenchmark.o: \
+	$(OUTPUT_TEST_DIR)/$(OUTPUT_TEST_PREFIX)DirectInputBenchmark.cpp
+$(OUTPUT_TEST_OBJ)KeyQueue.o: \
+	$(OUTPUT_TEST_DIR)/$(OUTPUT_TEST_PREFIX)KeyQueue.cpp
+$(OUTPUT_TEST_OBJ)WordPredictor.o: \
+	$(OUTPUT_TEST_DIR)/$(OUTPUT_TEST_PREFIX)WordPredictor.cpp
@@ -12,18 +12,25 @@ TEXT_CHARSET_OBJ = $(TEXT_OBJ)CharSet_
 OBJECTS_TEXT_CHARSET := \
   $(TEXT_CHARSET_OBJ)Cache.o \
   $(TEXT_CHARSET_OBJ)JSONResource.o \
-  $(TEXT_CHARSET_OBJ)ConfigFile.o
+  $(TEXT_CHARSET_OBJ)ConfigFile.o \
+  $(TEXT_CHARSET_OBJ)ChordOptimizer.o
 
 
 OBJECTS_TEXT := \
   $(TEXT_OBJ)BinaryFont.o \
+  $(TEXT_OBJ)GlyphCache.o \
   $(TEXT_OBJ)Painter.o \
   $(TEXT_OBJ)Values.o \
+  $(TEXT_OBJ)WordTrie.o \
   $(OBJECTS_TEXT_CHARSET)
 
 TEXT_TEST_PREFIX := $(TEXT_PREFIX)Test_
 TEXT_TEST_OBJ := $(TEXT_OBJ)Test_
-OBJECTS_TEXT_TEST :=
+OBJECTS_TEXT_TEST := \
+  $(TEXT_TEST_OBJ)BinaryFont.o \
+  $(TEXT_TEST_OBJ)ChordOptimizer.o \
+  $(TEXT_TEST_OBJ)GlyphCache.o \
+  $(TEXT_TEST_OBJ)Painter.o
 
 ifeq ($(BUILD_TESTS), 1)
     OBJECTS_TEXT := $(OBJECTS_TEXT) $(OBJECTS_TEXT_TEST)
@@ -42,10 +49,25 @@ $(TEXT_CHARSET_OBJ)JSONResource.o: \
 	$(TEXT_CHARSET_DIR)/$(TEXT_CHARSET_PREFIX)JSONResource.cpp
 $(TEXT_CHARSET_OBJ)ConfigFile.o: \
 	$(TEXT_CHARSET_DIR)/$(TEXT_CHARSET_PREFIX)ConfigFile.cpp
+$(TEXT_CHARSET_OBJ)ChordOptimizer.o: \
+	$(TEXT_CHARSET_DIR)/$(TEXT_CHARSET_PREFIX)ChordOptimizer.cpp
 
 $(TEXT_OBJ)BinaryFont.o: \
 	$(TEXT_DIR)/$(TEXT_PREFIX)BinaryFont.cpp
+$(TEXT_OBJ)GlyphCache.o: \
+	$(TEXT_DIR)/$(TEXT_PREFIX)GlyphCache.cpp
 $(TEXT_OBJ)Painter.o: \
 	$(TEXT_DIR)/$(TEXT_PREFIX)Painter.cpp
 $(TEXT_OBJ)Values.o: \
 	$(TEXT_DIR)/$(TEXT_PREFIX)Values.cpp
+$(TEXT_OBJ)WordTrie.o: \
+	$(TEXT_DIR)/$(TEXT_PREFIX)WordTrie.cpp
+
+$(TEXT_TEST_OBJ)BinaryFont.o: \
+	$(TEXT_TEST_DIR)/$(TEXT_TEST_PREFIX)BinaryFont.cpp
+$(TEXT_TEST_OBJ)ChordOptimizer.o: \
+	$(TEXT_TEST_DIR)/$(TEXT_TEST_PREFIX)ChordOptimizer.cpp
+$(TEXT_TEST_OBJ)GlyphCache.o: \
+	$(TEXT_TEST_DIR)/$(TEXT_TEST_PREFIX)GlyphCache.cpp
+$(TEXT_TEST_OBJ)Painter.o: \
+	$(TEXT_TEST_DIR)/$(TEXT_TEST_PREFIX)Painter.cpp
@@ -6,11 +6,18 @@ WINDOW_PREFIX = Windows_
 WINDOW_OBJ := $(JUCE_OBJDIR)/$(WINDOW_PREFIX)
 OBJECTS_WINDOW := \
   $(WINDOW_OBJ)XInterface.o \
+  $(WINDOW_OBJ)FocusMonitor.o \
+  $(WINDOW_OBJ)TreeMirror.o \
   $(WINDOW_OBJ)FocusControl.o
 
 WINDOW_TEST_PREFIX := $(WINDOW_PREFIX)Test_
 WINDOW_TEST_OBJ := $(WINDOW_OBJ)Test_
-OBJECTS_WINDOW_TEST :=
+OBJECTS_WINDOW_TEST := \
+  $(WINDOW_TEST_OBJ)RoundTrips.o \
+  $(WINDOW_TEST_OBJ)FocusMonitor.o \
+  $(WINDOW_TEST_OBJ)AncestryBenchmark.o \
+  $(WINDOW_TEST_OBJ)TreeMirror.o \
+  $(WINDOW_TEST_OBJ)PipelinedRequests.o
 
 ifeq ($(BUILD_TESTS), 1)
     OBJECTS_WINDOW := $(OBJECTS_WINDOW) $(OBJECTS_WINDOW_TEST)
@@ -25,5 +32,20 @@ window : $(OBJECTS_WINDOW)
 
 $(WINDOW_OBJ)XInterface.o : \
     $(WINDOW_DIR)/$(WINDOW_PREFIX)XInterface.cpp
+$(WINDOW_OBJ)FocusMonitor.o : \
+    $(WINDOW_DIR)/$(WINDOW_PREFIX)FocusMonitor.cpp
+$(WINDOW_OBJ)TreeMirror.o : \
+    $(WINDOW_DIR)/$(WINDOW_PREFIX)TreeMirror.cpp
 $(WINDOW_OBJ)FocusControl.o : \
     $(WINDOW_DIR)/$(WINDOW_PREFIX)FocusControl.cpp
+
+$(WINDOW_TEST_OBJ)RoundTrips.o : \
+    $(WINDOW_TEST_DIR)/$(WINDOW_TEST_PREFIX)RoundTrips.cpp
+$(WINDOW_TEST_OBJ)FocusMonitor.o : \
+    $(WINDOW_TEST_DIR)/$(WINDOW_TEST_PREFIX)FocusMonitor.cpp
+$(WINDOW_TEST_OBJ)AncestryBenchmark.o : \
+    $(WINDOW_TEST_DIR)/$(WINDOW_TEST_PREFIX)AncestryBenchmark.cpp
+$(WINDOW_TEST_OBJ)TreeMirror.o : \
+    $(WINDOW_TEST_DIR)/$(WINDOW_TEST_PREFIX)TreeMirror.cpp
+$(WINDOW_TEST_OBJ)PipelinedRequests.o : \
+    $(WINDOW_TEST_DIR)/$(WINDOW_TEST_PREFIX)PipelinedRequests.cpp
@@ -12,7 +12,7 @@ use constant IMG_WIDTH => 160;
 use constant IMG_HEIGHT => 160;
 use constant RELATIVE_OUTPATH => '../Source/GUI/Text/Text_BinaryFont.cpp';
 
-my $mapVarName = 'const juce::uint32 fontMap';
+my $mapVarName = 'static const constexpr juce::uint32 fontMap';
 
 my $path = $ARGV[0];
 